@@ -32,6 +32,7 @@ LIBCOMPUTER_SOURCES = \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioCalculator.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/IdleScheduler.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
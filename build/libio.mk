@@ -12,10 +12,12 @@ IO_SOURCES = \
 	$(IO_SRC_DIR)/FileReader.cxx \
 	$(IO_SRC_DIR)/BufferedOutputStream.cxx \
 	$(IO_SRC_DIR)/FileOutputStream.cxx \
+	$(IO_SRC_DIR)/ThreadedOutputStream.cpp \
 	$(IO_SRC_DIR)/GunzipReader.cxx \
 	$(IO_SRC_DIR)/ZlibError.cxx \
 	$(IO_SRC_DIR)/FileTransaction.cpp \
 	$(IO_SRC_DIR)/FileCache.cpp \
+	$(SRC)/system/FileMapping.cpp \
 	$(IO_SRC_DIR)/ZipArchive.cpp \
 	$(IO_SRC_DIR)/ZipReader.cpp \
 	$(IO_SRC_DIR)/StringConverter.cpp \
@@ -23,6 +23,7 @@ TASK_SOURCES = \
 	$(TASK_SRC_DIR)/Ordered/Points/AATPoint.cpp \
 	$(TASK_SRC_DIR)/Ordered/AATIsoline.cpp \
 	$(TASK_SRC_DIR)/Ordered/AATIsolineSegment.cpp \
+	$(TASK_SRC_DIR)/Ordered/AATIsolineCache.cpp \
 	$(TASK_SRC_DIR)/Unordered/UnorderedTask.cpp \
 	$(TASK_SRC_DIR)/Unordered/UnorderedTaskPoint.cpp \
 	$(TASK_SRC_DIR)/Unordered/GotoTask.cpp \
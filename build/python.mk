@@ -23,10 +23,12 @@ PYTHON_SOURCES = \
 	$(PYTHON_SRC)/Flight/FlightTimes.cpp \
 	$(PYTHON_SRC)/Flight/DouglasPeuckerMod.cpp \
 	$(PYTHON_SRC)/Flight/AnalyseFlight.cpp \
+	$(PYTHON_SRC)/Flight/FixTable.cpp \
         $(PYTHON_SRC)/Tools/GoogleEncode.cpp \
 	$(PYTHON_SRC)/PythonConverters.cpp \
 	$(PYTHON_SRC)/PythonGlue.cpp \
 	$(PYTHON_SRC)/Flight.cpp \
+	$(PYTHON_SRC)/FixArray.cpp \
 	$(PYTHON_SRC)/Airspaces.cpp \
 	$(PYTHON_SRC)/Util.cpp \
 	$(ENGINE_SRC_DIR)/Task/TaskBehaviour.cpp \
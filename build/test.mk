@@ -93,6 +93,7 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestThreadedOutputStream \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestMath \
 	TestMathTables \
@@ -101,10 +102,10 @@ TEST_NAMES = \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRadixTree TestGeoBounds TestGeoClip TestSimplifyPolygon \
 	TestLogger TestGRecord TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
-	TestFlarmNet \
+	TestFlarmNet TestTrafficList \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
@@ -115,10 +116,16 @@ TEST_NAMES = \
 	TestTeamCode \
 	TestZeroFinder \
 	TestAirspaceParser \
+	TestAirspaceTerrain \
+	TestCrossSectionProfile \
 	TestMETARParser \
 	TestIGCParser \
 	TestStrings TestUTF8 \
 	TestCRC \
+	TestSkyLinesBatch \
+	TestEventSlack \
+	TestJobGraph \
+	TestVarioSynthesiser \
 	TestUnitsFormatter \
 	TestGeoPointFormatter \
 	TestHexColorFormatter \
@@ -128,13 +135,22 @@ TEST_NAMES = \
 	TestLXNToIGC \
 	TestLeastSquares \
 	TestHexString \
-	TestThermalBand
+	TestThermalBand \
+	TestMOFile \
+	TestZipArchive \
+	TestIdleScheduler
 
 ifeq ($(TARGET_IS_ANDROID),n)
 # These programs are broken on Android because they require Java code
 TEST_NAMES += \
 	TestProfile \
-	TestDriver
+	TestDriver \
+	TestFlarmDownload
+endif
+
+ifeq ($(TARGET_IS_LINUX),y)
+# the cloud server is built only on Linux (see cloud.mk)
+TEST_NAMES += TestCloudJournal
 endif
 
 TESTS = $(call name-to-bin,$(TEST_NAMES))
@@ -150,6 +166,38 @@ TEST_CRC_SOURCES = \
 	$(TEST_SRC_DIR)/TestCRC.cpp
 $(eval $(call link-program,TestCRC,TEST_CRC))
 
+TEST_JOB_GRAPH_SOURCES = \
+	$(SRC)/Job/Graph.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestJobGraph.cpp
+TEST_JOB_GRAPH_DEPENDS = THREAD UTIL
+$(eval $(call link-program,TestJobGraph,TEST_JOB_GRAPH))
+
+TEST_VARIO_SYNTHESISER_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestVarioSynthesiser.cpp
+TEST_VARIO_SYNTHESISER_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestVarioSynthesiser,TEST_VARIO_SYNTHESISER))
+
+TEST_EVENT_SLACK_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestEventSlack.cpp
+TEST_EVENT_SLACK_DEPENDS = ASYNC OS IO THREAD TIME UTIL
+$(eval $(call link-program,TestEventSlack,TEST_EVENT_SLACK))
+
+TEST_SKYLINES_BATCH_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Client.cpp \
+	$(SRC)/Tracking/SkyLines/Server.cpp \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSkyLinesBatch.cpp
+TEST_SKYLINES_BATCH_DEPENDS = ASYNC LIBNET OS IO THREAD TIME GEO MATH UTIL
+$(eval $(call link-program,TestSkyLinesBatch,TEST_SKYLINES_BATCH))
+
 TEST_LEASTSQUARES_SOURCES = \
 	$(SRC)/Math/LeastSquares.cpp \
 	$(SRC)/Math/XYDataStore.cpp \
@@ -172,6 +220,12 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_THREADED_OUTPUT_STREAM_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThreadedOutputStream.cpp
+TEST_THREADED_OUTPUT_STREAM_DEPENDS = IO THREAD
+$(eval $(call link-program,TestThreadedOutputStream,TEST_THREADED_OUTPUT_STREAM))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -203,6 +257,21 @@ TEST_AIRSPACE_PARSER_LDADD = $(FAKE_LIBS)
 TEST_AIRSPACE_PARSER_DEPENDS = OPERATION IO OS AIRSPACE ZZIP GEO MATH UTIL
 $(eval $(call link-program,TestAirspaceParser,TEST_AIRSPACE_PARSER))
 
+TEST_AIRSPACE_TERRAIN_SOURCES = \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAirspaceTerrain.cpp
+TEST_AIRSPACE_TERRAIN_DEPENDS = AIRSPACE GEO MATH UTIL
+$(eval $(call link-program,TestAirspaceTerrain,TEST_AIRSPACE_TERRAIN))
+
+TEST_CROSS_SECTION_PROFILE_SOURCES = \
+	$(SRC)/CrossSection/CrossSectionProfile.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCrossSectionProfile.cpp
+TEST_CROSS_SECTION_PROFILE_DEPENDS = AIRSPACE GEO MATH UTIL
+$(eval $(call link-program,TestCrossSectionProfile,TEST_CROSS_SECTION_PROFILE))
+
 TEST_DATE_TIME_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestDateTime.cpp
@@ -409,12 +478,28 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_SIMPLIFY_POLYGON_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSimplifyPolygon.cpp
+TEST_SIMPLIFY_POLYGON_DEPENDS = GEO MATH
+$(eval $(call link-program,TestSimplifyPolygon,TEST_SIMPLIFY_POLYGON))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -630,7 +715,7 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
 TEST_GRECORD_SOURCES = \
@@ -651,6 +736,7 @@ TEST_DRIVER_SOURCES = \
 	$(SRC)/Device/Declaration.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
 	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/FLARM/List.cpp \
@@ -670,6 +756,36 @@ TEST_DRIVER_SOURCES = \
 TEST_DRIVER_DEPENDS = DRIVER OPERATION LIBNMEA GEO MATH IO OS THREAD UTIL TIME
 $(eval $(call link-program,TestDriver,TEST_DRIVER))
 
+# shared by TestFlarmDownload and BenchmarkFlarmDownload
+FLARM_DOWNLOAD_SOURCES = \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Util/NMEAReader.cpp \
+	$(SRC)/Device/Declaration.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(ENGINE_SRC_DIR)/Waypoint/Waypoint.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp
+
+TEST_FLARM_DOWNLOAD_SOURCES = \
+	$(FLARM_DOWNLOAD_SOURCES) \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmDownload.cpp
+TEST_FLARM_DOWNLOAD_DEPENDS = DRIVER OPERATION LIBNMEA GEO MATH IO OS THREAD UTIL TIME
+$(eval $(call link-program,TestFlarmDownload,TEST_FLARM_DOWNLOAD))
+
 TEST_WAY_POINT_FILE_SOURCES = \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -709,6 +825,89 @@ $(eval $(call link-program,FlightTable,FLIGHT_TABLE))
 
 build-check: $(TESTS)
 
+# Parser benchmarks: the fuzzer entry points (see fuzzer/src) driven
+# by BenchmarkParser.cpp over the fuzzer corpus and real-world files.
+# "make benchmark-parsers" fails if throughput or allocations regress
+# against the baseline stored in $(TARGET_OUTPUT_DIR)/benchmark; delete it to take
+# a new one.
+
+BENCHMARK_FUZZER_SRC_DIR = $(topdir)/fuzzer/src
+BENCHMARK_CORPUS_DIR = $(topdir)/fuzzer/corpus
+BENCHMARK_THRESHOLD = 20
+
+BENCHMARK_AIRSPACE_PARSER_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(BENCHMARK_FUZZER_SRC_DIR)/FuzzAirspaceParser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkParser.cpp
+BENCHMARK_AIRSPACE_PARSER_DEPENDS = IO OS AIRSPACE ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspaceParser,BENCHMARK_AIRSPACE_PARSER))
+
+BENCHMARK_IGC_PARSER_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(BENCHMARK_FUZZER_SRC_DIR)/FuzzIGCParser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkParser.cpp
+BENCHMARK_IGC_PARSER_DEPENDS = IO OS UTIL
+$(eval $(call link-program,BenchmarkIGCParser,BENCHMARK_IGC_PARSER))
+
+BENCHMARK_WAYPOINT_READER_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(BENCHMARK_FUZZER_SRC_DIR)/FuzzWaypointReader.cpp \
+	$(TEST_SRC_DIR)/BenchmarkParser.cpp
+BENCHMARK_WAYPOINT_READER_DEPENDS = WAYPOINT GEO MATH IO UTIL ZZIP OS THREAD
+$(eval $(call link-program,BenchmarkWaypointReader,BENCHMARK_WAYPOINT_READER))
+
+BENCHMARK_TOPOGRAPHY_INDEX_SOURCES = \
+	$(SRC)/Topography/Index.cpp \
+	$(BENCHMARK_FUZZER_SRC_DIR)/FuzzTopographyIndex.cpp \
+	$(TEST_SRC_DIR)/BenchmarkParser.cpp
+BENCHMARK_TOPOGRAPHY_INDEX_DEPENDS = RESOURCE IO OS UTIL
+$(eval $(call link-program,BenchmarkTopographyIndex,BENCHMARK_TOPOGRAPHY_INDEX))
+
+BENCHMARK_TOPOGRAPHY_FILE_SOURCES = \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(BENCHMARK_FUZZER_SRC_DIR)/FuzzTopographyFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkParser.cpp
+BENCHMARK_TOPOGRAPHY_FILE_DEPENDS = SCREEN SHAPELIB ZZIP GEO MATH IO OS UTIL
+$(eval $(call link-program,BenchmarkTopographyFile,BENCHMARK_TOPOGRAPHY_FILE))
+
+# $(1) = program name, $(2) = input files
+define run-parser-benchmark
+	$(Q)$(BENCHMARK_$(1)_BIN) --baseline=$(TARGET_OUTPUT_DIR)/benchmark/$(1).txt \
+		--threshold=$(BENCHMARK_THRESHOLD) $(2)
+
+endef
+
+benchmark-parsers: $(BENCHMARK_AIRSPACE_PARSER_BIN) $(BENCHMARK_IGC_PARSER_BIN) \
+	$(BENCHMARK_WAYPOINT_READER_BIN) $(BENCHMARK_TOPOGRAPHY_INDEX_BIN) \
+	| $(TARGET_OUTPUT_DIR)/benchmark/dirstamp
+	$(call run-parser-benchmark,AIRSPACE_PARSER,$(wildcard $(BENCHMARK_CORPUS_DIR)/airspace/*) $(topdir)/test/data/AirspaceAus-DAA.txt)
+	$(call run-parser-benchmark,IGC_PARSER,$(wildcard $(BENCHMARK_CORPUS_DIR)/igc/*) $(topdir)/test/data/01lz1hq1.igc)
+	$(call run-parser-benchmark,WAYPOINT_READER,$(wildcard $(BENCHMARK_CORPUS_DIR)/cup/*) $(topdir)/test/data/waypoints2.cup)
+	$(call run-parser-benchmark,TOPOGRAPHY_INDEX,$(wildcard $(BENCHMARK_CORPUS_DIR)/tpl/*))
+
 check: $(TESTS) | $(OUT)/test/dirstamp
 	@$(NQ)echo "  TEST    $(notdir $(patsubst %$(TARGET_EXEEXT),%,$^))"
 	$(Q)$(PERL) $(TEST_SRC_DIR)/testall.pl $(TESTS)
@@ -723,6 +922,7 @@ DEBUG_PROGRAM_NAMES = \
 	TestTrace \
 	FlightTable \
 	BenchmarkProjection \
+	BenchmarkProjectionBulk \
 	BenchmarkFAITriangleSector \
 	DumpTextFile DumpTextZip DumpTextInflate \
 	DumpHexColor \
@@ -743,6 +943,9 @@ DEBUG_PROGRAM_NAMES = \
 	DumpFlarmNet \
 	RunRepositoryParser \
 	NearestWaypoints \
+	BenchmarkWaypoints \
+	BenchmarkAirspaceParser BenchmarkIGCParser BenchmarkWaypointReader \
+	BenchmarkTopographyIndex BenchmarkTopographyFile \
 	RunKalmanFilter1d \
 	ArcApprox
 
@@ -752,6 +955,8 @@ DEBUG_PROGRAM_NAMES += \
 	RunTrace \
 	RunContestAnalysis \
 	RunWaveComputer \
+	BenchmarkReplay \
+	BenchmarkFlarmDownload \
 	FlightPath \
 	ReadProfileString ReadProfileInt \
 	KeyCodeDumper \
@@ -854,6 +1059,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
 	$(SRC)/FLARM/List.cpp \
 	$(SRC)/Computer/BasicComputer.cpp \
 	$(SRC)/Computer/GroundSpeedComputer.cpp \
@@ -892,6 +1098,13 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+BENCHMARK_PROJECTION_BULK_SOURCES = \
+	$(SRC)/Projection/Projection.cpp \
+	$(TEST_SRC_DIR)/BenchmarkProjectionBulk.cpp
+BENCHMARK_PROJECTION_BULK_DEPENDS = MATH
+BENCHMARK_PROJECTION_BULK_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkProjectionBulk,BENCHMARK_PROJECTION_BULK))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleSettings.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
@@ -1009,6 +1222,7 @@ RUN_SL_TRACKING_SOURCES = \
 	$(SRC)/net/SocketError.cxx \
 	$(SRC)/Tracking/SkyLines/Client.cpp \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Tracking/SkyLines/Batch.cpp \
 	$(TEST_SRC_DIR)/RunSkyLinesTracking.cpp
 RUN_SL_TRACKING_LDADD = $(DEBUG_REPLAY_LDADD)
 RUN_SL_TRACKING_DEPENDS = ASYNC GEO MATH UTIL
@@ -1044,6 +1258,40 @@ RUN_XML_PARSER_SOURCES = \
 RUN_XML_PARSER_DEPENDS = IO OS UTIL
 $(eval $(call link-program,RunXMLParser,RUN_XML_PARSER))
 
+TEST_MO_FILE_SOURCES = \
+	$(SRC)/Language/MOFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestMOFile.cpp
+TEST_MO_FILE_DEPENDS = UTIL
+$(eval $(call link-program,TestMOFile,TEST_MO_FILE))
+
+TEST_ZIP_ARCHIVE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestZipArchive.cpp
+TEST_ZIP_ARCHIVE_DEPENDS = IO OS ZZIP UTIL
+$(eval $(call link-program,TestZipArchive,TEST_ZIP_ARCHIVE))
+
+TEST_IDLE_SCHEDULER_SOURCES = \
+	$(SRC)/Computer/IdleScheduler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIdleScheduler.cpp
+$(eval $(call link-program,TestIdleScheduler,TEST_IDLE_SCHEDULER))
+
+ifeq ($(TARGET_IS_LINUX),y)
+TEST_CLOUD_JOURNAL_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Cloud/Serialiser.cpp \
+	$(SRC)/Cloud/Client.cpp \
+	$(SRC)/Cloud/Thermal.cpp \
+	$(SRC)/Cloud/Data.cpp \
+	$(SRC)/Cloud/Journal.cpp \
+	$(SRC)/Cloud/Compactor.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCloudJournal.cpp
+TEST_CLOUD_JOURNAL_DEPENDS = LIBNET IO THREAD OS GEO MATH UTIL
+$(eval $(call link-program,TestCloudJournal,TEST_CLOUD_JOURNAL))
+endif
+
 READ_MO_SOURCES = \
 	$(SRC)/Language/MOFile.cpp \
 	$(SRC)/system/FileMapping.cpp \
@@ -1212,6 +1460,28 @@ NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
 NEAREST_WAYPOINTS_DEPENDS = WAYPOINT OPERATION IO OS THREAD ZZIP GEO MATH UTIL
 $(eval $(call link-program,NearestWaypoints,NEAREST_WAYPOINTS))
 
+BENCHMARK_WAYPOINTS_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Compatibility/fmode.c \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkWaypoints.cpp
+BENCHMARK_WAYPOINTS_LDADD = $(FAKE_LIBS)
+BENCHMARK_WAYPOINTS_DEPENDS = WAYPOINT OPERATION IO OS THREAD ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkWaypoints,BENCHMARK_WAYPOINTS))
+
 RUN_FLIGHT_PARSER_SOURCES = \
 	$(SRC)/Logger/FlightParser.cpp \
 	$(TEST_SRC_DIR)/RunFlightParser.cpp
@@ -1282,6 +1552,7 @@ RUN_DEVICE_DRIVER_SOURCES = \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
 	$(SRC)/FLARM/List.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/IGC/Generator.cpp \
@@ -1476,7 +1747,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/util/MD5.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL
+RUN_IGC_WRITER_DEPENDS = IO THREAD GEO MATH UTIL
 $(eval $(call link-program,RunIGCWriter,RUN_IGC_WRITER))
 
 RUN_FLIGHT_LOGGER_SOURCES = \
@@ -1606,6 +1877,62 @@ RUN_WAVE_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
 RUN_WAVE_COMPUTER_DEPENDS = UTIL GEO MATH TIME
 $(eval $(call link-program,RunWaveComputer,RUN_WAVE_COMPUTER))
 
+BENCHMARK_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/CupWriter.cpp \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Cloud/weglide/WeGlideSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/util/MD5.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReplay.cpp
+BENCHMARK_REPLAY_DEPENDS = \
+	LIBCOMPUTER CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE \
+	DRIVER OPERATION LIBNMEA ASYNC LIBNET IO OS THREAD ZZIP \
+	UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkReplay,BENCHMARK_REPLAY))
+
+BENCHMARK_FLARM_DOWNLOAD_SOURCES = \
+	$(FLARM_DOWNLOAD_SOURCES) \
+	$(TEST_SRC_DIR)/BenchmarkFlarmDownload.cpp
+BENCHMARK_FLARM_DOWNLOAD_DEPENDS = $(TEST_FLARM_DOWNLOAD_DEPENDS)
+$(eval $(call link-program,BenchmarkFlarmDownload,BENCHMARK_FLARM_DOWNLOAD))
+
 ANALYSE_FLIGHT_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/NMEA/Aircraft.cpp \
@@ -1702,6 +2029,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
+	$(SRC)/Weather/Rasp/RaspLoader.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
@@ -1711,6 +2039,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/TaskPointRenderer.cpp \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
+	$(SRC)/Renderer/AirspaceShapeCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
@@ -2176,6 +2505,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Dialogs/WidgetDialog.cpp \
 	$(SRC)/Dialogs/dlgAnalysis.cpp \
 	$(SRC)/Dialogs/DialogSettings.cpp \
+	$(SRC)/CrossSection/CrossSectionProfile.cpp \
 	$(SRC)/CrossSection/AirspaceXSRenderer.cpp \
 	$(SRC)/CrossSection/TerrainXSRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
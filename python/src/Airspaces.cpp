@@ -147,7 +147,8 @@ PyObject* xcsoar_Airspaces_addPolygon(Pyxcsoar_Airspaces *self, PyObject *args)
 
   /* Parse airspace base and top */
   tstring base_ref, top_ref;
-  AirspaceAltitude base, top;
+  AirspaceAltitude base = AirspaceAltitude::Invalid();
+  AirspaceAltitude top = AirspaceAltitude::Invalid();
 
   if (!Python::PyStringToString(py_base_ref, base_ref)) {
     PyErr_SetString(PyExc_ValueError, "Can't parse airspace base reference.");
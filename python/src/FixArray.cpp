@@ -0,0 +1,245 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FixArray.hpp"
+
+#include "DebugReplay.hpp"
+
+#include <utility>
+
+static void xcsoar_FixArray_dealloc(Pyxcsoar_FixArray *self) {
+  delete self->table;
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static Py_ssize_t xcsoar_FixArray_length(Pyxcsoar_FixArray *self) {
+  return self->shape[0];
+}
+
+static int xcsoar_FixArray_getbuffer(Pyxcsoar_FixArray *self, Py_buffer *view,
+                                     int flags) {
+  if (flags & PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "xcsoar.FixArray is read-only.");
+    view->obj = nullptr;
+    return -1;
+  }
+
+  /* an empty vector may not have a buffer, but consumers expect a
+     valid pointer */
+  static double empty;
+
+  view->buf = self->table->IsEmpty()
+    ? &empty
+    : const_cast<double *>(self->table->GetData());
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->len = self->shape[0] * self->shape[1] * sizeof(double);
+  view->readonly = 1;
+  view->itemsize = sizeof(double);
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char *>("d") : nullptr;
+  view->ndim = 2;
+  view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES
+    ? self->strides
+    : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static PyObject* xcsoar_FixArray_get_columns(Pyxcsoar_FixArray *self, void *) {
+  PyObject *py_columns = PyTuple_New(FixTable::N_COLUMNS);
+  if (py_columns == nullptr)
+    return nullptr;
+
+  for (unsigned i = 0; i < FixTable::N_COLUMNS; ++i) {
+    PyObject *py_name = PyUnicode_FromString(FixTable::column_names[i]);
+    if (py_name == nullptr) {
+      Py_DECREF(py_columns);
+      return nullptr;
+    }
+
+    PyTuple_SET_ITEM(py_columns, i, py_name);
+  }
+
+  return py_columns;
+}
+
+PySequenceMethods xcsoar_FixArray_sequence = {
+  (lenfunc)xcsoar_FixArray_length, /* sq_length */
+};
+
+PyBufferProcs xcsoar_FixArray_buffer = {
+  (getbufferproc)xcsoar_FixArray_getbuffer, /* bf_getbuffer */
+  nullptr,               /* bf_releasebuffer */
+};
+
+PyGetSetDef xcsoar_FixArray_getset[] = {
+  {"columns", (getter)xcsoar_FixArray_get_columns, nullptr,
+   "Names of the columns.", nullptr},
+  {nullptr}  /* Sentinel */
+};
+
+PyTypeObject xcsoar_FixArray_Type = {
+  PyVarObject_HEAD_INIT(&PyType_Type, 0 /* obj_size */)
+  "xcsoar.FixArray",     /* char *tp_name; */
+  sizeof(Pyxcsoar_FixArray), /* int tp_basicsize; */
+  0,                     /* int tp_itemsize; not used much */
+  (destructor)xcsoar_FixArray_dealloc, /* destructor tp_dealloc; */
+  0,                     /* printfunc  tp_print; */
+  0,                     /* getattrfunc  tp_getattr; __getattr__ */
+  0,                     /* setattrfunc  tp_setattr; __setattr__ */
+  0,                     /* cmpfunc  tp_compare; __cmp__ */
+  0,                     /* reprfunc  tp_repr; __repr__ */
+  0,                     /* PyNumberMethods *tp_as_number; */
+  &xcsoar_FixArray_sequence, /* PySequenceMethods *tp_as_sequence; */
+  0,                     /* PyMappingMethods *tp_as_mapping; */
+  0,                     /* hashfunc tp_hash; __hash__ */
+  0,                     /* ternaryfunc tp_call; __call__ */
+  0,                     /* reprfunc tp_str; __str__ */
+  0,                     /* tp_getattro */
+  0,                     /* tp_setattro */
+  &xcsoar_FixArray_buffer, /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,    /* tp_flags */
+  "Read-only table of fixes (one row per fix) supporting the buffer protocol", /* tp_doc */
+  0,                     /* tp_traverse */
+  0,                     /* tp_clear */
+  0,                     /* tp_richcompare */
+  0,                     /* tp_weaklistoffset */
+  0,                     /* tp_iter */
+  0,                     /* tp_iternext */
+  0,                     /* tp_methods */
+  0,                     /* tp_members */
+  xcsoar_FixArray_getset, /* tp_getset */
+};
+
+PyObject* FixArray_New(FixTable &&table) {
+  Pyxcsoar_FixArray *self =
+    PyObject_New(Pyxcsoar_FixArray, &xcsoar_FixArray_Type);
+  if (self == nullptr)
+    return nullptr;
+
+  self->table = new FixTable(std::move(table));
+  self->shape[0] = self->table->GetRowCount();
+  self->shape[1] = FixTable::N_COLUMNS;
+  self->strides[0] = FixTable::N_COLUMNS * sizeof(double);
+  self->strides[1] = sizeof(double);
+
+  return (PyObject *)self;
+}
+
+static void xcsoar_FixChunks_dealloc(Pyxcsoar_FixChunks *self) {
+  delete self->replay;
+  Py_XDECREF(self->flight);
+  PyObject_Del(self);
+}
+
+static PyObject* xcsoar_FixChunks_next(Pyxcsoar_FixChunks *self) {
+  /* the replay is detached while it is read without the GIL, so a
+     concurrent next() from another thread can't use it */
+  DebugReplay *replay = self->replay;
+  if (replay == nullptr)
+    return nullptr;
+
+  self->replay = nullptr;
+
+  FixTable table;
+  bool more;
+
+  Py_BEGIN_ALLOW_THREADS
+  table.Reserve(self->size);
+  more = table.Fill(*replay, self->begin, self->end, self->size);
+  Py_END_ALLOW_THREADS
+
+  if (more)
+    self->replay = replay;
+  else
+    /* release the file as early as possible */
+    delete replay;
+
+  if (table.IsEmpty())
+    return nullptr;
+
+  return FixArray_New(std::move(table));
+}
+
+PyTypeObject xcsoar_FixChunks_Type = {
+  PyVarObject_HEAD_INIT(&PyType_Type, 0 /* obj_size */)
+  "xcsoar.FixChunks",    /* char *tp_name; */
+  sizeof(Pyxcsoar_FixChunks), /* int tp_basicsize; */
+  0,                     /* int tp_itemsize; not used much */
+  (destructor)xcsoar_FixChunks_dealloc, /* destructor tp_dealloc; */
+  0,                     /* printfunc  tp_print; */
+  0,                     /* getattrfunc  tp_getattr; __getattr__ */
+  0,                     /* setattrfunc  tp_setattr; __setattr__ */
+  0,                     /* cmpfunc  tp_compare; __cmp__ */
+  0,                     /* reprfunc  tp_repr; __repr__ */
+  0,                     /* PyNumberMethods *tp_as_number; */
+  0,                     /* PySequenceMethods *tp_as_sequence; */
+  0,                     /* PyMappingMethods *tp_as_mapping; */
+  0,                     /* hashfunc tp_hash; __hash__ */
+  0,                     /* ternaryfunc tp_call; __call__ */
+  0,                     /* reprfunc tp_str; __str__ */
+  0,                     /* tp_getattro */
+  0,                     /* tp_setattro */
+  0,                     /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,    /* tp_flags */
+  "Iterator over xcsoar.FixArray chunks of a flight", /* tp_doc */
+  0,                     /* tp_traverse */
+  0,                     /* tp_clear */
+  0,                     /* tp_richcompare */
+  0,                     /* tp_weaklistoffset */
+  PyObject_SelfIter,     /* tp_iter */
+  (iternextfunc)xcsoar_FixChunks_next, /* tp_iternext */
+};
+
+PyObject* FixChunks_New(PyObject *flight, DebugReplay *replay,
+                        std::chrono::system_clock::time_point begin,
+                        std::chrono::system_clock::time_point end,
+                        Py_ssize_t size) {
+  Pyxcsoar_FixChunks *self =
+    PyObject_New(Pyxcsoar_FixChunks, &xcsoar_FixChunks_Type);
+  if (self == nullptr) {
+    delete replay;
+    return nullptr;
+  }
+
+  Py_INCREF(flight);
+  self->flight = flight;
+  self->replay = replay;
+  self->begin = begin;
+  self->end = end;
+  self->size = size;
+
+  return (PyObject *)self;
+}
+
+bool FixArray_init(PyObject* m) {
+  if (PyType_Ready(&xcsoar_FixArray_Type) < 0 ||
+      PyType_Ready(&xcsoar_FixChunks_Type) < 0)
+      return false;
+
+  Py_INCREF(&xcsoar_FixArray_Type);
+  PyModule_AddObject(m, "FixArray", (PyObject *)&xcsoar_FixArray_Type);
+
+  return true;
+}
@@ -0,0 +1,66 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef PYTHON_FIX_ARRAY_HPP
+#define PYTHON_FIX_ARRAY_HPP
+
+#include <Python.h>
+
+#include "Flight/FixTable.hpp"
+
+#include <chrono>
+
+class DebugReplay;
+
+/* xcsoar.FixArray: a read-only two-dimensional float64 buffer */
+struct Pyxcsoar_FixArray {
+  PyObject_HEAD FixTable *table;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+/* iterator over consecutive xcsoar.FixArray chunks of a replay */
+struct Pyxcsoar_FixChunks {
+  PyObject_HEAD PyObject *flight;
+  DebugReplay *replay;
+  std::chrono::system_clock::time_point begin, end;
+  Py_ssize_t size;
+};
+
+/**
+ * Wrap the table in a new xcsoar.FixArray object.
+ */
+PyObject* FixArray_New(FixTable &&table);
+
+/**
+ * Create an iterator which returns the fixes of the replay in
+ * xcsoar.FixArray chunks of #size rows.  It takes ownership of the
+ * replay and keeps a reference to the flight object.
+ */
+PyObject* FixChunks_New(PyObject *flight, DebugReplay *replay,
+                        std::chrono::system_clock::time_point begin,
+                        std::chrono::system_clock::time_point end,
+                        Py_ssize_t size);
+
+bool FixArray_init(PyObject* m);
+
+#endif /* PYTHON_FIX_ARRAY_HPP */
@@ -24,15 +24,21 @@
 #include <datetime.h>
 
 #include "Flight.hpp"
+#include "FixArray.hpp"
 
 #include "PythonGlue.hpp"
 #include "PythonConverters.hpp"
 #include "Flight/Flight.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "Flight/IGCFixEnhanced.hpp"
+#include "Flight/FixTable.hpp"
 #include "Tools/GoogleEncode.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <string>
+#include <thread>
 #include <vector>
 #include <cinttypes>
 #include <limits>
@@ -186,40 +192,117 @@ PyObject* xcsoar_Flight_path(Pyxcsoar_Flight *self, PyObject *args) {
   return py_fixes;
 }
 
-PyObject* xcsoar_Flight_times(Pyxcsoar_Flight *self) {
-  std::vector<FlightTimeResult> results;
+PyObject* xcsoar_Flight_fixes(Pyxcsoar_Flight *self, PyObject *args) {
+  PyObject *py_begin = nullptr,
+           *py_end = nullptr;
+
+  if (!PyArg_ParseTuple(args, "|OO", &py_begin, &py_end)) {
+    return nullptr;
+  }
+
+  auto begin = std::chrono::system_clock::time_point::min();
+  auto end = std::chrono::system_clock::time_point::max();
+
+  if (py_begin != nullptr && PyDateTime_Check(py_begin))
+    begin = Python::PyToBrokenDateTime(py_begin).ToTimePoint();
+
+  if (py_end != nullptr && PyDateTime_Check(py_end))
+    end = Python::PyToBrokenDateTime(py_end).ToTimePoint();
+
+  DebugReplay *replay = self->flight->Replay();
+
+  if (replay == nullptr) {
+    PyErr_SetString(PyExc_IOError, "Can't start replay - file not found.");
+    return nullptr;
+  }
+
+  FixTable table;
 
   Py_BEGIN_ALLOW_THREADS
-  self->flight->Times(results);
+  table.Fill(*replay, begin, end, std::numeric_limits<std::size_t>::max());
+  delete replay;
   Py_END_ALLOW_THREADS
 
-  PyObject *py_times = PyList_New(0);
+  return FixArray_New(std::move(table));
+}
 
-  for (auto times : results) {
-    PyObject *py_power_states = PyList_New(0);
+PyObject* xcsoar_Flight_chunks(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"size", "begin", "end", nullptr};
+  PyObject *py_begin = nullptr,
+           *py_end = nullptr;
+  Py_ssize_t size = 65536;
 
-    for (auto power_state : times.power_states) {
-      PyObject *py_power_state = Py_BuildValue("{s:N,s:N,s:O}",
-        "time", Python::BrokenDateTimeToPy(power_state.time),
-        "location", Python::WriteLonLat(power_state.location),
-        "powered", power_state.state == PowerState::ON ? Py_True : Py_False);
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nOO", kwlist,
+                                   &size, &py_begin, &py_end)) {
+    return nullptr;
+  }
 
-      if (PyList_Append(py_power_states, py_power_state) != 0)
-        return nullptr;
+  if (size <= 0) {
+    PyErr_SetString(PyExc_ValueError, "Chunk size must be positive.");
+    return nullptr;
+  }
 
-      Py_DECREF(py_power_state);
-    }
+  auto begin = std::chrono::system_clock::time_point::min();
+  auto end = std::chrono::system_clock::time_point::max();
+
+  if (py_begin != nullptr && PyDateTime_Check(py_begin))
+    begin = Python::PyToBrokenDateTime(py_begin).ToTimePoint();
 
-    PyObject *py_single_flight = Py_BuildValue("{s:N,s:N,s:N}",
-      "takeoff", Python::WriteEvent(times.takeoff_time, times.takeoff_location),
-      "landing", Python::WriteEvent(times.landing_time, times.landing_location),
-      "power_states", py_power_states);
+  if (py_end != nullptr && PyDateTime_Check(py_end))
+    end = Python::PyToBrokenDateTime(py_end).ToTimePoint();
 
-    if (times.release_time.IsPlausible()) {
-      PyObject *py_release = Python::WriteEvent(times.release_time, times.release_location);
-      PyDict_SetItemString(py_single_flight, "release", py_release);
-      Py_DECREF(py_release);
-    }
+  DebugReplay *replay = self->flight->Replay();
+
+  if (replay == nullptr) {
+    PyErr_SetString(PyExc_IOError, "Can't start replay - file not found.");
+    return nullptr;
+  }
+
+  return FixChunks_New((PyObject *)self, replay, begin, end, size);
+}
+
+static PyObject* WriteFlightTimes(const FlightTimeResult &times) {
+  PyObject *py_power_states = PyList_New(0);
+
+  for (auto power_state : times.power_states) {
+    PyObject *py_power_state = Py_BuildValue("{s:N,s:N,s:O}",
+      "time", Python::BrokenDateTimeToPy(power_state.time),
+      "location", Python::WriteLonLat(power_state.location),
+      "powered", power_state.state == PowerState::ON ? Py_True : Py_False);
+
+    if (PyList_Append(py_power_states, py_power_state) != 0)
+      return nullptr;
+
+    Py_DECREF(py_power_state);
+  }
+
+  PyObject *py_single_flight = Py_BuildValue("{s:N,s:N,s:N}",
+    "takeoff", Python::WriteEvent(times.takeoff_time, times.takeoff_location),
+    "landing", Python::WriteEvent(times.landing_time, times.landing_location),
+    "power_states", py_power_states);
+
+  if (times.release_time.IsPlausible()) {
+    PyObject *py_release = Python::WriteEvent(times.release_time, times.release_location);
+    PyDict_SetItemString(py_single_flight, "release", py_release);
+    Py_DECREF(py_release);
+  }
+
+  return py_single_flight;
+}
+
+PyObject* xcsoar_Flight_times(Pyxcsoar_Flight *self) {
+  std::vector<FlightTimeResult> results;
+
+  Py_BEGIN_ALLOW_THREADS
+  self->flight->Times(results);
+  Py_END_ALLOW_THREADS
+
+  PyObject *py_times = PyList_New(0);
+
+  for (const auto &times : results) {
+    PyObject *py_single_flight = WriteFlightTimes(times);
+    if (py_single_flight == nullptr)
+      return nullptr;
 
     if (PyList_Append(py_times, py_single_flight) != 0)
       return nullptr;
@@ -284,6 +367,72 @@ PyObject* xcsoar_Flight_reduce(Pyxcsoar_Flight *self, PyObject *args, PyObject *
   Py_RETURN_NONE;
 }
 
+/**
+ * Convert the result of Flight::Analyse() to a Python dictionary.
+ */
+static PyObject* WriteAnalysis(const ContestStatistics &olc_plus,
+                               const ContestStatistics &dmst,
+                               const PhaseList &phase_list,
+                               const PhaseTotals &phase_totals,
+                               const WindList &wind_list,
+                               bool qnh_available, AtmosphericPressure qnh) {
+  /* write olc_plus statistics */
+  PyObject *py_olc_plus = Py_BuildValue("{s:N,s:N,s:N}",
+    "classic", Python::WriteContest(olc_plus.result[0], olc_plus.solution[0]),
+    "triangle", Python::WriteContest(olc_plus.result[1], olc_plus.solution[1]),
+    "plus", Python::WriteContest(olc_plus.result[2], olc_plus.solution[2]));
+
+  /* write dmst statistics */
+  PyObject *py_dmst = Py_BuildValue("{s:N}",
+    "quadrilateral", Python::WriteContest(dmst.result[0], dmst.solution[0]));
+
+  /* write contests */
+  PyObject *py_contests = Py_BuildValue("{s:N,s:N}",
+    "olc_plus", py_olc_plus,
+    "dmst", py_dmst);
+
+  /* write fligh phases */
+  PyObject *py_phases = PyList_New(0);
+
+  for (const Phase &phase : phase_list) {
+    PyObject *py_phase = Python::WritePhase(phase);
+    if (PyList_Append(py_phases, py_phase) != 0)
+      return nullptr;
+
+    Py_DECREF(py_phase);
+  }
+
+  /* write wind list*/
+  PyObject *py_wind_list = PyList_New(0);
+
+  for (const WindListItem &wind_item : wind_list) {
+    PyObject *py_wind = Python::WriteWindItem(wind_item);
+    if (PyList_Append(py_wind_list, py_wind) != 0)
+      return nullptr;
+
+    Py_DECREF(py_wind);
+  }
+
+  /* write QNH */
+  PyObject *py_qnh;
+
+  if (qnh_available) {
+    py_qnh = PyFloat_FromDouble(qnh.GetHectoPascal());
+  } else {
+    py_qnh = Py_None;
+    Py_INCREF(Py_None);
+  }
+
+  PyObject *py_result = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
+    "contests", py_contests,
+    "phases", py_phases,
+    "performance", Python::WritePerformanceStats(phase_totals),
+    "wind", py_wind_list,
+    "qnh", py_qnh);
+
+  return py_result;
+}
+
 PyObject* xcsoar_Flight_analyse(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs) {
   static char *kwlist[] = {"takeoff", "scoring_start", "scoring_end", "landing",
                            "full", "triangle", "sprint",
@@ -339,61 +488,8 @@ PyObject* xcsoar_Flight_analyse(Pyxcsoar_Flight *self, PyObject *args, PyObject
   if (!success)
     Py_RETURN_NONE;
 
-  /* write olc_plus statistics */
-  PyObject *py_olc_plus = Py_BuildValue("{s:N,s:N,s:N}",
-    "classic", Python::WriteContest(olc_plus.result[0], olc_plus.solution[0]),
-    "triangle", Python::WriteContest(olc_plus.result[1], olc_plus.solution[1]),
-    "plus", Python::WriteContest(olc_plus.result[2], olc_plus.solution[2]));
-
-  /* write dmst statistics */
-  PyObject *py_dmst = Py_BuildValue("{s:N}",
-    "quadrilateral", Python::WriteContest(dmst.result[0], dmst.solution[0]));
-
-  /* write contests */
-  PyObject *py_contests = Py_BuildValue("{s:N,s:N}",
-    "olc_plus", py_olc_plus,
-    "dmst", py_dmst);
-
-  /* write fligh phases */
-  PyObject *py_phases = PyList_New(0);
-
-  for (Phase phase : phase_list) {
-    PyObject *py_phase = Python::WritePhase(phase);
-    if (PyList_Append(py_phases, py_phase) != 0)
-      return nullptr;
-
-    Py_DECREF(py_phase);
-  }
-
-  /* write wind list*/
-  PyObject *py_wind_list = PyList_New(0);
-
-  for (WindListItem wind_item: wind_list) {
-    PyObject *py_wind = Python::WriteWindItem(wind_item);
-    if (PyList_Append(py_wind_list, py_wind) != 0)
-      return nullptr;
-
-    Py_DECREF(py_wind);
-  }
-
-  /* write QNH */
-  PyObject *py_qnh;
-
-  if (self->flight->qnh_available) {
-    py_qnh = PyFloat_FromDouble(self->flight->qnh.GetHectoPascal());
-  } else {
-    py_qnh = Py_None;
-    Py_INCREF(Py_None);
-  }
-
-  PyObject *py_result = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}",
-    "contests", py_contests,
-    "phases", py_phases,
-    "performance", Python::WritePerformanceStats(phase_totals),
-    "wind", py_wind_list,
-    "qnh", py_qnh);
-
-  return py_result;
+  return WriteAnalysis(olc_plus, dmst, phase_list, phase_totals, wind_list,
+                       self->flight->qnh_available, self->flight->qnh);
 }
 
 PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args) {
@@ -469,9 +565,212 @@ PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args) {
   return py_result;
 }
 
+namespace {
+
+/**
+ * The analysis of one flight found by xcsoar.analyse_flights().
+ */
+struct BatchAnalysis {
+  FlightTimeResult times;
+
+  bool success = false;
+  ContestStatistics olc_plus;
+  ContestStatistics dmst;
+  PhaseList phase_list;
+  PhaseTotals phase_totals;
+  WindList wind_list;
+  bool qnh_available = false;
+  AtmosphericPressure qnh;
+};
+
+/**
+ * The analysis of one file passed to xcsoar.analyse_flights().
+ */
+struct BatchResult {
+  bool success = false;
+  std::vector<BatchAnalysis> flights;
+};
+
+struct BatchParameters {
+  unsigned full, triangle, sprint;
+  unsigned max_iterations, max_tree_size;
+};
+
+}
+
+static void AnalyseFile(const char *path, const BatchParameters &parameters,
+                        BatchResult &result) {
+  Flight flight(path, true);
+
+  std::vector<FlightTimeResult> times;
+  flight.Times(times);
+
+  result.flights.reserve(times.size());
+
+  for (const auto &t : times) {
+    result.flights.emplace_back();
+    BatchAnalysis &analysis = result.flights.back();
+    analysis.times = t;
+
+    if (!t.takeoff_time.IsPlausible() || !t.landing_time.IsPlausible())
+      continue;
+
+    /* score from the release if known, otherwise AnalyseFlight()
+       falls back to takeoff and landing */
+    const BrokenDateTime scoring_start = t.release_time.IsPlausible()
+      ? t.release_time
+      : BrokenDateTime();
+
+    analysis.success = flight.Analyse(t.takeoff_time, scoring_start,
+                                      BrokenDateTime(), t.landing_time,
+                                      analysis.olc_plus, analysis.dmst,
+                                      analysis.phase_list,
+                                      analysis.phase_totals,
+                                      analysis.wind_list,
+                                      parameters.full, parameters.triangle,
+                                      parameters.sprint,
+                                      parameters.max_iterations,
+                                      parameters.max_tree_size);
+    analysis.qnh_available = flight.qnh_available;
+    analysis.qnh = flight.qnh;
+  }
+
+  result.success = true;
+}
+
+PyObject* xcsoar_analyse_flights(PyObject *self, PyObject *args, PyObject *kwargs) {
+  static char *kwlist[] = {"files", "threads", "full", "triangle", "sprint",
+                           "max_iterations", "max_tree_size", nullptr};
+  PyObject *py_files;
+  unsigned n_threads = 0;
+  BatchParameters parameters{512, 1024, 96, unsigned(20e6), unsigned(5e6)};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|IIIIII", kwlist,
+                                   &py_files, &n_threads,
+                                   &parameters.full, &parameters.triangle,
+                                   &parameters.sprint,
+                                   &parameters.max_iterations,
+                                   &parameters.max_tree_size)) {
+    return nullptr;
+  }
+
+  PyObject *py_sequence = PySequence_Fast(py_files, "Expected a list of file names.");
+  if (py_sequence == nullptr)
+    return nullptr;
+
+  std::vector<std::string> files;
+  const Py_ssize_t num_items = PySequence_Fast_GET_SIZE(py_sequence);
+  files.reserve(num_items);
+
+  for (Py_ssize_t i = 0; i < num_items; ++i) {
+    PyObject *py_item = PySequence_Fast_GET_ITEM(py_sequence, i);
+
+#if PY_MAJOR_VERSION >= 3
+    const char *path = PyUnicode_Check(py_item) ? PyUnicode_AsUTF8(py_item) : nullptr;
+#else
+    const char *path = PyString_Check(py_item) ? PyString_AsString(py_item) : nullptr;
+#endif
+
+    if (path == nullptr) {
+      Py_DECREF(py_sequence);
+      if (!PyErr_Occurred())
+        PyErr_SetString(PyExc_TypeError, "Expected a list of file names.");
+      return nullptr;
+    }
+
+    files.emplace_back(path);
+  }
+
+  Py_DECREF(py_sequence);
+
+  if (n_threads == 0)
+    n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  n_threads = std::min<std::size_t>(n_threads, files.size());
+
+  std::vector<BatchResult> results(files.size());
+
+  Py_BEGIN_ALLOW_THREADS
+
+  /* the flights are independent; each worker picks the next file
+     until all are done */
+  std::atomic<std::size_t> next{0};
+  const auto worker = [&](){
+    std::size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < files.size()) {
+      try {
+        AnalyseFile(files[i].c_str(), parameters, results[i]);
+      } catch (...) {
+        results[i].success = false;
+        results[i].flights.clear();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+  for (unsigned i = 1; i < n_threads; ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  Py_END_ALLOW_THREADS
+
+  PyObject *py_results = PyList_New(0);
+
+  for (const auto &result : results) {
+    PyObject *py_result;
+
+    if (result.success) {
+      py_result = PyList_New(0);
+
+      for (const auto &analysis : result.flights) {
+        PyObject *py_analysis;
+
+        if (analysis.success) {
+          py_analysis = WriteAnalysis(analysis.olc_plus, analysis.dmst,
+                                      analysis.phase_list,
+                                      analysis.phase_totals,
+                                      analysis.wind_list,
+                                      analysis.qnh_available, analysis.qnh);
+          if (py_analysis == nullptr)
+            return nullptr;
+        } else {
+          py_analysis = Py_None;
+          Py_INCREF(Py_None);
+        }
+
+        PyObject *py_flight = Py_BuildValue("{s:N,s:N}",
+          "times", WriteFlightTimes(analysis.times),
+          "analysis", py_analysis);
+
+        if (PyList_Append(py_result, py_flight) != 0)
+          return nullptr;
+
+        Py_DECREF(py_flight);
+      }
+    } else {
+      py_result = Py_None;
+      Py_INCREF(Py_None);
+    }
+
+    if (PyList_Append(py_results, py_result) != 0)
+      return nullptr;
+
+    Py_DECREF(py_result);
+  }
+
+  return py_results;
+}
+
 PyMethodDef xcsoar_Flight_methods[] = {
   {"setQNH", (PyCFunction)xcsoar_Flight_setQNH, METH_VARARGS, "Set QNH for the flight (in hPa)."},
   {"path", (PyCFunction)xcsoar_Flight_path, METH_VARARGS, "Get flight as list."},
+  {"fixes", (PyCFunction)xcsoar_Flight_fixes, METH_VARARGS, "Get flight as xcsoar.FixArray."},
+  {"chunks", (PyCFunction)xcsoar_Flight_chunks, METH_VARARGS | METH_KEYWORDS, "Iterate over the flight in xcsoar.FixArray chunks."},
   {"times", (PyCFunction)xcsoar_Flight_times, METH_VARARGS, "Get takeoff/release/landing times from flight."},
   {"reduce", (PyCFunction)xcsoar_Flight_reduce, METH_VARARGS | METH_KEYWORDS, "Reduce flight."},
   {"analyse", (PyCFunction)xcsoar_Flight_analyse, METH_VARARGS | METH_KEYWORDS, "Analyse flight."},
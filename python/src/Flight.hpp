@@ -40,11 +40,16 @@ void xcsoar_Flight_dealloc(Pyxcsoar_Flight *self);
 
 PyObject* xcsoar_Flight_setQNH(Pyxcsoar_Flight *self, PyObject *args);
 PyObject* xcsoar_Flight_path(Pyxcsoar_Flight *self, PyObject *args);
+PyObject* xcsoar_Flight_fixes(Pyxcsoar_Flight *self, PyObject *args);
+PyObject* xcsoar_Flight_chunks(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs);
 PyObject* xcsoar_Flight_times(Pyxcsoar_Flight *self);
 PyObject* xcsoar_Flight_reduce(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs);
 PyObject* xcsoar_Flight_analyse(Pyxcsoar_Flight *self, PyObject *args, PyObject *kwargs);
 PyObject* xcsoar_Flight_encode(Pyxcsoar_Flight *self, PyObject *args);
 
+/* xcsoar methods */
+PyObject* xcsoar_analyse_flights(PyObject *self, PyObject *args, PyObject *kwargs);
+
 bool Flight_init(PyObject* m);
 
 #endif /* PYTHON_FLIGHT_HPP */
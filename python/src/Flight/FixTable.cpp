@@ -0,0 +1,118 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FixTable.hpp"
+#include "IGCFixEnhanced.hpp"
+#include "DebugReplay.hpp"
+#include "time/BrokenDateTime.hpp"
+
+#include <limits>
+
+const char *const FixTable::column_names[N_COLUMNS] = {
+  "time",
+  "clock",
+  "longitude",
+  "latitude",
+  "gps_altitude",
+  "pressure_altitude",
+  "enl",
+  "trt",
+  "gsp",
+  "tas",
+  "ias",
+  "siu",
+  "elevation",
+  "level",
+};
+
+static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * Convert an optional IGC extension (negative if not available).
+ */
+static constexpr double
+Optional(int value)
+{
+  return value > -1 ? value : NaN;
+}
+
+void
+FixTable::Append(const IGCFixEnhanced &fix)
+{
+  const std::chrono::duration<double> time =
+    BrokenDateTime(fix.date, fix.time).ToTimePoint().time_since_epoch();
+
+  const double row[N_COLUMNS] = {
+    time.count(),
+    fix.clock.ToDuration().count(),
+    fix.location.longitude.Degrees(),
+    fix.location.latitude.Degrees(),
+    double(fix.gps_altitude),
+    double(fix.pressure_altitude),
+    Optional(fix.enl),
+    Optional(fix.trt),
+    Optional(fix.gsp),
+    Optional(fix.tas),
+    Optional(fix.ias),
+    Optional(fix.siu),
+    fix.elevation > -999 ? fix.elevation : NaN,
+    double(fix.level),
+  };
+
+  data.insert(data.end(), row, row + N_COLUMNS);
+}
+
+bool
+FixTable::Fill(DebugReplay &replay,
+               std::chrono::system_clock::time_point begin,
+               std::chrono::system_clock::time_point end,
+               std::size_t max_rows)
+{
+  while (GetRowCount() < max_rows) {
+    if (!replay.Next())
+      return false;
+
+    if (replay.Level() == -1) continue;
+
+    const MoreData &basic = replay.Basic();
+    const auto date_time_utc = basic.date_time_utc.ToTimePoint();
+
+    if (date_time_utc < begin)
+      continue;
+    else if (date_time_utc > end)
+      return false;
+
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    IGCFixEnhanced fix;
+    fix.Clear();
+    fix.Apply(basic, replay.Calculated());
+    fix.level = replay.Level();
+
+    Append(fix);
+  }
+
+  return true;
+}
@@ -0,0 +1,100 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef PYTHON_FLIGHT_FIX_TABLE_HPP
+#define PYTHON_FLIGHT_FIX_TABLE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+struct IGCFixEnhanced;
+class DebugReplay;
+
+/**
+ * A table of fixes, stored row by row in one contiguous array of
+ * doubles.  It can be exported through the Python buffer protocol
+ * without creating a Python object per fix.  Values which are not
+ * available are NaN.
+ */
+class FixTable {
+public:
+  enum Column : unsigned {
+    /** POSIX time stamp (UTC) */
+    TIME,
+    /** seconds since midnight of the first day of the flight */
+    CLOCK,
+    LONGITUDE,
+    LATITUDE,
+    GPS_ALTITUDE,
+    PRESSURE_ALTITUDE,
+    ENL,
+    TRT,
+    GSP,
+    TAS,
+    IAS,
+    SIU,
+    ELEVATION,
+    LEVEL,
+    N_COLUMNS
+  };
+
+  static const char *const column_names[N_COLUMNS];
+
+private:
+  std::vector<double> data;
+
+public:
+  std::size_t GetRowCount() const {
+    return data.size() / N_COLUMNS;
+  }
+
+  bool IsEmpty() const {
+    return data.empty();
+  }
+
+  const double *GetData() const {
+    return data.data();
+  }
+
+  void Reserve(std::size_t n_rows) {
+    data.reserve(n_rows * N_COLUMNS);
+  }
+
+  void Append(const IGCFixEnhanced &fix);
+
+  /**
+   * Append the fixes of the replay which would be returned by
+   * xcsoar.Flight.path(), until the end time is passed or the table
+   * has #max_rows rows.  The replay can be passed again to continue.
+   *
+   * @return false if the replay has no more fixes in the given time
+   * range
+   */
+  bool Fill(DebugReplay &replay,
+            std::chrono::system_clock::time_point begin,
+            std::chrono::system_clock::time_point end,
+            std::size_t max_rows);
+};
+
+#endif /* PYTHON_FLIGHT_FIX_TABLE_HPP */
@@ -26,12 +26,14 @@
 
 #include "PythonGlue.hpp"
 #include "Flight.hpp"
+#include "FixArray.hpp"
 #include "Airspaces.hpp"
 #include "Util.hpp"
 
 
 PyMethodDef xcsoar_methods[] = {
   {"encode", (PyCFunction)xcsoar_encode, METH_VARARGS | METH_KEYWORDS, "Encode a list of numbers."},
+  {"analyse_flights", (PyCFunction)xcsoar_analyse_flights, METH_VARARGS | METH_KEYWORDS, "Analyse a list of flight files in parallel."},
   {nullptr, nullptr, 0, nullptr}
 };
 
@@ -70,6 +72,9 @@ MOD_INIT(xcsoar) {
   if (!Flight_init(m))
     return MOD_ERROR_VAL;
 
+  if (!FixArray_init(m))
+    return MOD_ERROR_VAL;
+
   if (!Airspaces_init(m))
     return MOD_ERROR_VAL;
 
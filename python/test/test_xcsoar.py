@@ -97,3 +97,39 @@ for i, fix in enumerate(flight.path()):
   print(fix)
 
 del flight
+
+
+print()
+print("Read the flight as xcsoar.FixArray, without a python object per fix")
+flight = xcsoar.Flight(args.file_name, False)
+
+fixes = flight.fixes()
+view = memoryview(fixes)
+print("{} fixes, columns {}".format(len(fixes), fixes.columns))
+assert view.shape == (len(fixes), len(fixes.columns))
+assert view.format == 'd'
+
+# numpy.asarray(fixes) shares the buffer as well
+if len(fixes):
+  print([view[0, i] for i in range(view.shape[1])])
+
+print("Stream the flight in chunks")
+num_fixes = 0
+for chunk in flight.chunks(size=1000):
+  num_fixes += len(chunk)
+
+assert num_fixes == len(fixes)
+
+del flight
+
+
+print()
+print("Analyse all flights of a list of files in parallel")
+for result in xcsoar.analyse_flights([args.file_name], threads=2):
+  if result is None:
+    print("Failed to read file")
+    continue
+
+  for single_flight in result:
+    pprint(single_flight['times'])
+    pprint(single_flight['analysis'])
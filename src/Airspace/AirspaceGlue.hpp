@@ -24,17 +24,16 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_GLUE_HPP
 #define XCSOAR_AIRSPACE_GLUE_HPP
 
-class RasterTerrain;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
 
 /**
- * Reads the airspace files into the memory
+ * Reads the airspace files into the memory.  Ground levels are not
+ * calculated; that is done by #AsyncAirspaceTerrainLoader.
  */
 void
 ReadAirspace(Airspaces &airspaces,
-             RasterTerrain *terrain,
              AtmosphericPressure press,
              OperationEnvironment &operation);
 
@@ -351,6 +351,7 @@ ReadAltitude(StringParser<TCHAR> &input, AirspaceAltitude &altitude)
   case SFC:
     altitude.reference = AltitudeReference::AGL;
     altitude.altitude_above_terrain = -1;
+    altitude.terrain = AirspaceTerrainEnvelope::Invalid();
 
     /* prepare fallback, just in case we have no terrain */
     altitude.altitude = 0;
@@ -371,6 +372,7 @@ ReadAltitude(StringParser<TCHAR> &input, AirspaceAltitude &altitude)
   case AGL:
     altitude.reference = AltitudeReference::AGL;
     altitude.altitude_above_terrain = value;
+    altitude.terrain = AirspaceTerrainEnvelope::Invalid();
 
     /* prepare fallback, just in case we have no terrain */
     altitude.altitude = value;
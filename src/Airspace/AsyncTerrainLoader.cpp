@@ -0,0 +1,244 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "AsyncTerrainLoader.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceTerrainEnvelope.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Job/Job.hpp"
+#include "io/FileCache.hpp"
+#include "io/BufferedReader.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/Reader.hxx"
+#include "system/Path.hpp"
+#include "LogFile.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+static const TCHAR *const airspace_terrain_cache_name = _T("airspace_terrain");
+
+static constexpr uint32_t CACHE_VERSION = 1;
+
+/**
+ * Calculate a key which identifies the geometry of an airspace
+ * (64 bit FNV-1a over its border).
+ */
+[[gnu::pure]]
+static uint64_t
+GeometryKey(const AbstractAirspace &airspace) noexcept
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+
+  const auto update = [&hash](const void *data, std::size_t size){
+    const auto *p = (const uint8_t *)data;
+    for (std::size_t i = 0; i < size; ++i)
+      hash = (hash ^ p[i]) * 0x100000001b3ULL;
+  };
+
+  const auto shape = airspace.GetShape();
+  update(&shape, sizeof(shape));
+
+  for (const auto &i : airspace.GetPoints()) {
+    const double location[2] = {
+      i.GetLocation().longitude.Native(),
+      i.GetLocation().latitude.Native(),
+    };
+    update(location, sizeof(location));
+  }
+
+  return hash;
+}
+
+using EnvelopeMap = std::unordered_map<uint64_t, AirspaceTerrainEnvelope>;
+
+static EnvelopeMap
+LoadCache(FileCache &cache, Path terrain_path)
+{
+  EnvelopeMap map;
+
+  auto r = cache.Load(airspace_terrain_cache_name, terrain_path);
+  if (!r)
+    return map;
+
+  BufferedReader br(*r);
+
+  uint32_t header[2];
+  br.ReadFull({header, sizeof(header)});
+  if (header[0] != CACHE_VERSION || header[1] > 1024 * 1024)
+    throw std::runtime_error("Malformed airspace terrain cache");
+
+  for (uint32_t i = 0; i < header[1]; ++i) {
+    uint64_t key;
+    AirspaceTerrainEnvelope envelope;
+    br.ReadFull({&key, sizeof(key)});
+    br.ReadFull({&envelope, sizeof(envelope)});
+    map.emplace(key, envelope);
+  }
+
+  return map;
+}
+
+class AsyncAirspaceTerrainLoader::ScanJob final : public Job {
+  struct Item {
+    AirspacePtr airspace;
+    uint64_t key;
+    AirspaceTerrainEnvelope envelope;
+  };
+
+  const RasterTerrain &terrain;
+  FileCache *const cache;
+  const AllocatedPath terrain_path;
+
+  std::vector<Item> items;
+
+public:
+  ScanJob(const Airspaces &airspaces, const RasterTerrain &_terrain,
+          FileCache *_cache, Path _terrain_path) noexcept
+    :terrain(_terrain), cache(_cache), terrain_path(_terrain_path)
+  {
+    /* copy the pointers, because the Airspaces object may be
+       cleared while this job runs */
+    for (const auto &i : airspaces.QueryAll())
+      if (i.NeedGroundLevel())
+        items.push_back({i.GetAirspacePtr(), 0,
+                         AirspaceTerrainEnvelope::Invalid()});
+  }
+
+  unsigned Apply() noexcept {
+    unsigned n = 0;
+    for (const auto &i : items) {
+      if (i.envelope.IsDefined()) {
+        i.airspace->SetTerrainEnvelope(i.envelope);
+        ++n;
+      }
+    }
+
+    return n;
+  }
+
+  void Run(OperationEnvironment &env) override {
+    EnvelopeMap cached;
+    if (cache != nullptr && terrain_path != nullptr) {
+      try {
+        cached = LoadCache(*cache, terrain_path);
+      } catch (...) {
+        LogError(std::current_exception(),
+                 "Failed to load airspace terrain cache");
+      }
+    }
+
+    env.SetProgressRange(items.size());
+
+    unsigned n_scanned = 0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      if (env.IsCancelled())
+        return;
+
+      auto &item = items[i];
+      item.key = GeometryKey(*item.airspace);
+
+      if (auto j = cached.find(item.key); j != cached.end()) {
+        item.envelope = j->second;
+      } else {
+        /* lock the terrain for each airspace only, to give the
+           calculation and drawing threads a chance */
+        RasterTerrain::Lease lease(terrain);
+        item.envelope = ScanTerrainEnvelope(lease, *item.airspace);
+        ++n_scanned;
+      }
+
+      env.SetProgressPosition(i);
+    }
+
+    LogFormat("Airspace terrain: %u of %u envelopes scanned",
+              n_scanned, unsigned(items.size()));
+
+    if (n_scanned > 0 && cache != nullptr && terrain_path != nullptr) {
+      try {
+        SaveCache(*cache);
+      } catch (...) {
+        LogError(std::current_exception(),
+                 "Failed to save airspace terrain cache");
+      }
+    }
+  }
+
+private:
+  /**
+   * Save the envelopes of all current airspaces; entries of
+   * airspaces which no longer exist are discarded.
+   */
+  void SaveCache(FileCache &_cache) const {
+    auto os = _cache.Save(airspace_terrain_cache_name, terrain_path);
+
+    BufferedOutputStream bos(*os);
+
+    const uint32_t header[2] = {CACHE_VERSION, uint32_t(items.size())};
+    bos.Write(header, sizeof(header));
+
+    for (const auto &i : items) {
+      bos.Write(&i.key, sizeof(i.key));
+      bos.Write(&i.envelope, sizeof(i.envelope));
+    }
+
+    bos.Flush();
+    os->Commit();
+  }
+};
+
+AsyncAirspaceTerrainLoader::AsyncAirspaceTerrainLoader() noexcept = default;
+
+AsyncAirspaceTerrainLoader::~AsyncAirspaceTerrainLoader() noexcept
+{
+  if (async.IsBusy()) {
+    async.Cancel();
+    try {
+      async.Wait();
+    } catch (...) {
+    }
+  }
+}
+
+void
+AsyncAirspaceTerrainLoader::Start(const Airspaces &airspaces,
+                                  const RasterTerrain &terrain,
+                                  FileCache *cache, Path terrain_path,
+                                  UI::Notify &notify) noexcept
+{
+  job = std::make_unique<ScanJob>(airspaces, terrain, cache, terrain_path);
+  async.Start(job.get(), env, &notify);
+}
+
+unsigned
+AsyncAirspaceTerrainLoader::Apply()
+{
+  assert(job);
+
+  async.Wait();
+  return job->Apply();
+}
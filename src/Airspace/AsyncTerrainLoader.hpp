@@ -0,0 +1,82 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#pragma once
+
+#include "Job/Async.hpp"
+#include "Operation/Operation.hpp"
+
+#include <memory>
+
+class FileCache;
+class Path;
+class RasterTerrain;
+class Airspaces;
+
+namespace UI { class Notify; }
+
+/**
+ * This class calculates the terrain envelopes of all AGL-referenced
+ * airspaces in a separate thread.  The envelopes are stored in the
+ * #FileCache, keyed by the airspace geometry; the cache is discarded
+ * when the terrain file changes.
+ */
+class AsyncAirspaceTerrainLoader final {
+  class ScanJob;
+
+  std::unique_ptr<ScanJob> job;
+
+  /**
+   * The job runs in the background without showing progress.
+   */
+  NullOperationEnvironment env;
+
+  AsyncJobRunner async;
+
+public:
+  AsyncAirspaceTerrainLoader() noexcept;
+  ~AsyncAirspaceTerrainLoader() noexcept;
+
+  /**
+   * Start scanning the terrain below all airspaces which need a
+   * ground level.  The #RasterTerrain must remain valid until this
+   * object is destructed; the #Airspaces may be modified meanwhile.
+   *
+   * @param terrain_path the terrain file; it is used to validate
+   * the cache
+   */
+  void Start(const Airspaces &airspaces, const RasterTerrain &terrain,
+             FileCache *cache, Path terrain_path,
+             UI::Notify &notify) noexcept;
+
+  /**
+   * Wait for the job to finish and apply the envelopes to the
+   * airspaces.  The caller must make sure that no other thread
+   * accesses the airspaces.
+   *
+   * Throws on error.
+   *
+   * @return the number of airspaces which were updated
+   */
+  unsigned Apply();
+};
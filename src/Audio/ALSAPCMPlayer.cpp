@@ -30,6 +30,18 @@ Copyright_License {
 
 #include <alsa/asoundlib.h>
 
+#include <algorithm>
+
+/**
+ * After this number of buffer underruns, the buffer time is doubled.
+ */
+static constexpr unsigned MAX_UNDERRUNS = 3;
+
+/**
+ * Never grow the buffer time beyond this value [us].
+ */
+static constexpr unsigned MAX_LATENCY = 200000;
+
 static void alsa_error_handler_stub(const char *, int, const char *,
                                     int, const char *, ...) {}
 
@@ -112,6 +124,17 @@ ALSAPCMPlayer::WriteFrames(snd_pcm_t &alsa_handle, int16_t *buffer,
   return true;
 }
 
+void
+ALSAPCMPlayer::OnUnderrun() noexcept
+{
+  if (++n_underruns < MAX_UNDERRUNS || latency >= MAX_LATENCY)
+    return;
+
+  n_underruns = 0;
+  latency = std::min(latency * 2, MAX_LATENCY);
+  LogFormat("Increasing ALSA PCM latency to %u μs", latency);
+}
+
 void
 ALSAPCMPlayer::StopEventHandling()
 {
@@ -123,6 +146,9 @@ ALSAPCMPlayer::OnEvent()
 {
   snd_pcm_sframes_t n_available = snd_pcm_avail_update(alsa_handle.get());
   if (n_available < 0) {
+    if (-EPIPE == n_available)
+      OnUnderrun();
+
     if (!TryRecoverFromError(static_cast<int>(n_available)))
       return false;
 
@@ -422,14 +448,20 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
 
   if ((nullptr != source) &&
       alsa_handle &&
-      (source->GetSampleRate() == new_sample_rate)) {
+      (sample_rate == new_sample_rate)) {
     /* just change the source / resume playback */
     bool success = false;
     BlockingCall(event_loop, [this, &_source, &success]() {
+      /* #latency is modified by OnUnderrun() in the event thread, so
+         it must be compared there */
+      if (configured_latency != latency)
+        return;
+
       bool recovered_from_underrun = false;
 
       switch (snd_pcm_state(alsa_handle.get())) {
       case SND_PCM_STATE_XRUN:
+        OnUnderrun();
         if (0 != snd_pcm_prepare(alsa_handle.get()))
           return;
         else {
@@ -463,10 +495,15 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
       return true;
   }
 
+  /* after this, no event handler is running which could modify
+     #latency */
   Stop();
 
   assert(!alsa_handle);
 
+  if (latency == 0)
+    latency = ALSAEnv::GetALSALatency();
+
   AlsaHandleUniquePtr new_alsa_handle = MakeAlsaHandleUniquePtr();
   {
     const char *alsa_device = ALSAEnv::GetALSADeviceName();
@@ -484,14 +521,15 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
     assert(new_alsa_handle);
   }
 
-  unsigned latency = ALSAEnv::GetALSALatency();
-
   channels = 1;
   bool big_endian_source = _source.IsBigEndian();
   if (!SetParameters(*new_alsa_handle, new_sample_rate, big_endian_source,
                      latency, channels))
     return false;
 
+  sample_rate = new_sample_rate;
+  configured_latency = latency;
+
   snd_pcm_sframes_t n_available = snd_pcm_avail(new_alsa_handle.get());
   if (n_available <= 0) {
     LogFormat("snd_pcm_avail(0x%p) failed: %ld - %s",
@@ -544,6 +582,16 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   return true;
 }
 
+std::chrono::microseconds
+ALSAPCMPlayer::GetLatency() const noexcept
+{
+  if (!alsa_handle)
+    return {};
+
+  return std::chrono::microseconds(uint_least64_t(buffer_size / channels)
+                                   * 1000000 / sample_rate);
+}
+
 void
 ALSAPCMPlayer::Stop()
 {
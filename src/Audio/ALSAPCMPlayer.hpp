@@ -59,6 +59,28 @@ class ALSAPCMPlayer : public PCMPlayer {
   EventLoop &event_loop;
 
   snd_pcm_uframes_t buffer_size;
+  unsigned sample_rate;
+
+  /**
+   * The requested buffer time [us].  It starts small (see
+   * ALSAEnv::GetALSALatency()) to keep the vario tone responsive,
+   * and is doubled after repeated buffer underruns; the new value
+   * takes effect the next time the device is opened.
+   *
+   * While the device is open, this (and #n_underruns) must only be
+   * accessed from the event thread.
+   */
+  unsigned latency = 0;
+
+  /**
+   * The number of buffer underruns with the current #latency.
+   */
+  unsigned n_underruns = 0;
+
+  /**
+   * The #latency value the open device was configured with.
+   */
+  unsigned configured_latency = 0;
   std::unique_ptr<int16_t[]> buffer;
 
   std::forward_list<SocketEvent> poll_events;
@@ -79,6 +101,8 @@ class ALSAPCMPlayer : public PCMPlayer {
     return WriteFrames(*alsa_handle, buffer.get(), n, try_recover_on_error);
   }
 
+  void OnUnderrun() noexcept;
+
   bool OnEvent();
 
   static bool SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
@@ -92,6 +116,7 @@ public:
   /* virtual methods from class PCMPlayer */
   bool Start(PCMDataSource &source) override;
   void Stop() override;
+  std::chrono::microseconds GetLatency() const noexcept override;
 
 private:
   void OnSocketReady(unsigned events) noexcept;
@@ -52,3 +52,9 @@ MixerPCMPlayer::Stop()
     source = nullptr;
   }
 }
+
+std::chrono::microseconds
+MixerPCMPlayer::GetLatency() const noexcept
+{
+  return pcm_mixer->GetLatency();
+}
@@ -37,6 +37,7 @@ public:
   /* virtual methods from class PCMPlayer */
   bool Start(PCMDataSource &source) override;
   void Stop() override;
+  std::chrono::microseconds GetLatency() const noexcept override;
 };
 
 #endif
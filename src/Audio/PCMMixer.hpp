@@ -66,6 +66,13 @@ public:
     mixer_data_source.SetVolume(vol_percent);
   }
 
+  /**
+   * @see PCMPlayer::GetLatency()
+   */
+  std::chrono::microseconds GetLatency() const noexcept {
+    return player->GetLatency();
+  }
+
   static constexpr unsigned GetMaxSafeVolume() {
     return decltype(mixer_data_source)::GetMaxSafeVolume();
   }
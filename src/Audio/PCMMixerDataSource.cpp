@@ -72,8 +72,7 @@ PCMMixerDataSource::SetVolume(unsigned _vol_percent)
 {
   assert(_vol_percent <= 100);
 
-  const std::lock_guard<Mutex> protect(lock);
-  vol_percent = _vol_percent;
+  vol_percent.store(_vol_percent, std::memory_order_relaxed);
 }
 
 size_t
@@ -84,7 +83,16 @@ PCMMixerDataSource::GetData(int16_t *buffer, size_t n)
   PCMDataSource *sources_to_remove[MAX_MIXER_SOURCES_COUNT];
   unsigned sources_to_remove_count = 0;
 
-  const std::lock_guard<Mutex> protect(lock);
+  std::unique_lock<Mutex> protect(lock, std::try_to_lock);
+  if (!protect.owns_lock()) {
+    /* a source is being added or removed right now; don't block the
+       audio thread, play a short silence instead */
+    std::fill_n(buffer, n, 0);
+    return n;
+  }
+
+  const unsigned vol_percent =
+    this->vol_percent.load(std::memory_order_relaxed);
 
   for (unsigned i = 0; i < MAX_MIXER_SOURCES_COUNT; ++i) {
     PCMDataSource *source = sources[i];
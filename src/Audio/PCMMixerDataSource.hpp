@@ -29,6 +29,8 @@ Copyright_License {
 #include "util/ByteOrder.hxx"
 #include "thread/Mutex.hxx"
 
+#include <atomic>
+
 
 /**
  * #PCMDataSource implementation which mixes PCM data streams from multiple
@@ -42,10 +44,15 @@ class PCMMixerDataSource : public PCMDataSource {
 
   const unsigned sample_rate;
 
-  unsigned vol_percent = 100 / MAX_MIXER_SOURCES_COUNT;
+  std::atomic_uint vol_percent{100 / MAX_MIXER_SOURCES_COUNT};
 
   PCMDataSource *sources[MAX_MIXER_SOURCES_COUNT] = {};
 
+  /**
+   * Protects #sources.  GetData() is called by the audio thread and
+   * never waits for it; if it is contended, silence is played
+   * instead.
+   */
   Mutex lock;
 
 public:
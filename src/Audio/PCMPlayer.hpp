@@ -28,6 +28,8 @@ Copyright_License {
 #define PCMPLAYER_SYNTHESISER_ONLY
 #endif
 
+#include <chrono>
+
 #if !defined(ANDROID) && !defined(_WIN32)
 
 #include "util/Compiler.h"
@@ -69,6 +71,15 @@ public:
    */
   virtual void Stop() = 0;
 
+  /**
+   * Returns the duration of the output buffer, i.e. how long it
+   * takes for a sample to be played after it has been obtained from
+   * the source.  Returns zero if that is unknown.
+   */
+  virtual std::chrono::microseconds GetLatency() const noexcept {
+    return {};
+  }
+
   virtual ~PCMPlayer() {}
 
 protected:
@@ -26,6 +26,7 @@ Copyright_License {
 #include "PCMPlayerFactory.hpp"
 #include "VarioSynthesiser.hpp"
 #include "VarioSettings.hpp"
+#include "LogFile.hpp"
 
 #ifdef ANDROID
 #include "SLES/Init.hpp"
@@ -71,6 +72,16 @@ AudioVarioGlue::Initialise()
 void
 AudioVarioGlue::Deinitialise()
 {
+  if (synthesiser != nullptr) {
+    const auto stats = synthesiser->GetLatencyStats();
+    if (stats.count > 0)
+      LogFormat("Vario audio latency: %u values, average %ld us, max %ld us, "
+                "output buffer %ld us",
+                stats.count, (long)stats.average.count(),
+                (long)stats.max.count(),
+                (long)player->GetLatency().count());
+  }
+
   delete player;
   player = nullptr;
   delete synthesiser;
@@ -101,7 +112,8 @@ AudioVarioGlue::Configure(const VarioSoundSettings &settings)
 }
 
 void
-AudioVarioGlue::SetValue(double vario)
+AudioVarioGlue::SetValue(double vario,
+                         std::chrono::steady_clock::time_point received)
 {
 #ifdef ANDROID
   if (!have_sles)
@@ -111,7 +123,7 @@ AudioVarioGlue::SetValue(double vario)
   assert(player != nullptr);
   assert(synthesiser != nullptr);
 
-  synthesiser->SetVario(vario);
+  synthesiser->SetVario(vario, received);
 }
 
 void
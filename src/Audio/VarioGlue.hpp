@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "Features.hpp"
 
+#include <chrono>
+
 struct VarioSoundSettings;
 
 namespace AudioVarioGlue {
@@ -37,7 +39,7 @@ namespace AudioVarioGlue {
   void Initialise();
 
   /**
-   * Global initialisation on shutdown.
+   * Global initialisation on shutdown.  Logs the latency statistics.
    */
   void Deinitialise();
 
@@ -51,8 +53,11 @@ namespace AudioVarioGlue {
    * Update the vario value.
    *
    * @param vario the current vario value [m/s]
+   * @param received the time when the value was received from the
+   * device, for latency statistics
    */
-  void SetValue(double vario);
+  void SetValue(double vario,
+                std::chrono::steady_clock::time_point received=std::chrono::steady_clock::now());
 
   /**
    * Declare that no vario value is known (e.g. when connection to all
@@ -71,7 +76,8 @@ namespace AudioVarioGlue {
   static inline void Initialise() {}
   static inline void Deinitialise() {}
   static inline void Configure(const VarioSoundSettings &settings) {}
-  static inline void SetValue(double vario) {}
+  static inline void SetValue(double vario,
+                              std::chrono::steady_clock::time_point received={}) {}
   static inline void NoValue() {}
   static inline bool HaveAudioVario() { return false; }
 #endif
@@ -43,16 +43,39 @@ VarioSynthesiser::VarioToFrequency(int ivario)
     : (zero_frequency - (unsigned)(ivario * (int)(zero_frequency - min_frequency) / min_vario));
 }
 
-void
-VarioSynthesiser::SetVario(double vario)
+/**
+ * Convert a time stamp to a wrapping 32 bit microsecond value, which
+ * can be stored in an atomic variable on all platforms.
+ */
+static uint32_t
+ToMicroseconds(VarioSynthesiser::Clock::time_point t) noexcept
 {
-  const std::lock_guard<Mutex> lock(mutex);
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+}
 
+void
+VarioSynthesiser::SetVario(double vario, Clock::time_point received)
+{
   const int ivario = Clamp((int)(vario * 100), min_vario, max_vario);
 
-  if (dead_band_enabled && InDeadBand(ivario)) {
+  request_time.store(ToMicroseconds(received), std::memory_order_relaxed);
+  request.store(ivario, std::memory_order_release);
+}
+
+void
+VarioSynthesiser::SetSilence()
+{
+  request_time.store(ToMicroseconds(Clock::now()), std::memory_order_relaxed);
+  request.store(SILENCE, std::memory_order_release);
+}
+
+void
+VarioSynthesiser::Apply(int32_t ivario)
+{
+  if (ivario == SILENCE ||
+      (dead_band_enabled && InDeadBand(ivario))) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
@@ -87,14 +110,7 @@ VarioSynthesiser::SetVario(double vario)
 }
 
 void
-VarioSynthesiser::SetSilence()
-{
-  const std::lock_guard<Mutex> lock(mutex);
-  UnsafeSetSilence();
-}
-
-void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ApplySilence()
 {
   audible_count = 0;
   silence_count = 1;
@@ -108,11 +124,53 @@ VarioSynthesiser::UnsafeSetSilence()
   silence_remaining = 0;
 }
 
+void
+VarioSynthesiser::AddLatency(uint32_t received_us) noexcept
+{
+  /* unsigned subtraction works across the wraparound */
+  const uint32_t latency = ToMicroseconds(Clock::now()) - received_us;
+
+  /* only the audio thread writes these, so there is no need for
+     read-modify-write operations */
+  const uint32_t count = latency_count.load(std::memory_order_relaxed);
+  uint32_t average = latency_average_us.load(std::memory_order_relaxed);
+
+  /* exponential moving average with a weight of 1/16 */
+  average = count == 0
+    ? latency
+    : average - average / 16 + latency / 16;
+
+  latency_average_us.store(average, std::memory_order_relaxed);
+  if (latency > latency_max_us.load(std::memory_order_relaxed))
+    latency_max_us.store(latency, std::memory_order_relaxed);
+  latency_count.store(count + 1, std::memory_order_relaxed);
+}
+
+VarioSynthesiser::LatencyStats
+VarioSynthesiser::GetLatencyStats() const noexcept
+{
+  LatencyStats stats;
+  stats.count = latency_count.load(std::memory_order_relaxed);
+  stats.average = std::chrono::microseconds(latency_average_us.load(std::memory_order_relaxed));
+  stats.max = std::chrono::microseconds(latency_max_us.load(std::memory_order_relaxed));
+  return stats;
+}
 
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard<Mutex> lock(mutex);
+  /* pick up the most recent SetVario() call; the time stamp
+     distinguishes a repeated value from one which has already been
+     applied */
+  const int32_t ivario = request.load(std::memory_order_acquire);
+  const uint32_t received_us = request_time.load(std::memory_order_relaxed);
+  if (ivario != applied || received_us != applied_time) {
+    applied = ivario;
+    applied_time = received_us;
+    Apply(ivario);
+    if (ivario != SILENCE)
+      AddLatency(received_us);
+  }
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -25,18 +25,70 @@ Copyright_License {
 #define XCSOAR_AUDIO_VARIO_SYNTHESISER_HPP
 
 #include "ToneSynthesiser.hpp"
-#include "thread/Mutex.hxx"
 #include "util/Compiler.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 /**
  * This class generates vario sound.
+ *
+ * SetVario() and SetSilence() may be called from any one thread; they
+ * publish the new value through an atomic variable, and the audio
+ * thread picks it up in Synthesise() without ever blocking.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Statistics about the time between receiving a vario value and
+   * the audio thread starting to synthesise the according tone.
+   */
+  struct LatencyStats {
+    unsigned count;
+
+    /**
+     * An exponential moving average.
+     */
+    std::chrono::microseconds average;
+
+    std::chrono::microseconds max;
+  };
+
+private:
+  /**
+   * A special #request value which asks for silence.
+   */
+  static constexpr int32_t SILENCE = INT32_MIN;
+
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * The most recent vario value [cm/s] or #SILENCE.  Written by
+   * SetVario(), consumed by Synthesise().
    */
-  Mutex mutex;
+  std::atomic<int32_t> request{SILENCE};
+
+  /**
+   * The time stamp when #request was received [us, wrapping].  It is
+   * written before #request.
+   */
+  std::atomic<uint32_t> request_time{0};
+
+  std::atomic<uint32_t> latency_count{0};
+  std::atomic<uint32_t> latency_average_us{0}, latency_max_us{0};
+
+  /* the following attributes are only used by the audio thread */
+
+  /**
+   * The #request value which was last applied.
+   */
+  int32_t applied = SILENCE;
+
+  /**
+   * The #request_time value which was last applied.
+   */
+  uint32_t applied_time = 0;
 
   /**
    * The number of audible samples in each period.
@@ -56,6 +108,9 @@ class VarioSynthesiser final : public ToneSynthesiser {
    */
   size_t audible_remaining, silence_remaining;
 
+  /* the following settings are written only while the vario is
+     being configured */
+
   bool dead_band_enabled;
 
   /**
@@ -100,12 +155,15 @@ public:
      min_dead(-30), max_dead(10) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The audio thread will calculate a new
+   * tone frequency and a new "silence" rate (for positive vario
+   * values) the next time it asks for samples.
    *
    * @param vario the current vario value [m/s]
+   * @param received the time when the value was received from the
+   * device, for latency statistics
    */
-  void SetVario(double vario);
+  void SetVario(double vario, Clock::time_point received=Clock::now());
 
   /**
    * Produce silence from now on.
@@ -144,14 +202,28 @@ public:
     max_dead = (int)(max * 100);
   }
 
+  /**
+   * Obtain the latency statistics.  May be called from any thread.
+   */
+  [[gnu::pure]]
+  LatencyStats GetLatencyStats() const noexcept;
+
   /* methods from class PCMSynthesiser */
   virtual void Synthesise(int16_t *buffer, size_t n);
 
 private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply a new #request value.  Called by the audio thread.
    */
-  void UnsafeSetSilence();
+  void Apply(int32_t ivario);
+
+  /**
+   * Update the latency statistics after a new #request value has
+   * been applied.
+   */
+  void AddLatency(uint32_t received_us) noexcept;
+
+  void ApplySilence();
 
   /**
    * Convert a vario value to a tone frequency.
@@ -32,6 +32,7 @@ Copyright_License {
 #include "time/WrapClock.hpp"
 
 #include <cassert>
+#include <chrono>
 
 class MultipleDevices;
 class AtmosphericPressure;
@@ -79,6 +80,13 @@ class DeviceBlackboard
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * The time when new data was last received from a physical device.
+   * The MergeThread forwards it to the audio vario for latency
+   * statistics.
+   */
+  std::chrono::steady_clock::time_point last_received;
+
 public:
   Mutex mutex;
 
@@ -109,6 +117,14 @@ public:
     return per_device_data[i];
   }
 
+  /**
+   * Remember that new data has just been received from a physical
+   * device.  The caller must lock the mutex.
+   */
+  void MarkReceived() noexcept {
+    last_received = std::chrono::steady_clock::now();
+  }
+
   /**
    * Return a copy of a device's data after updating its clock via
    * NMEAInfo::UpdateClock().  The method takes care for locking and
@@ -132,6 +148,7 @@ public:
     {
       const std::lock_guard<Mutex> lock(mutex);
       per_device_data[i] = src;
+      MarkReceived();
     }
 
     ScheduleMerge();
@@ -45,6 +45,13 @@ CalculationThread::CalculationThread(GlideComputer &_glide_computer)
                 std::chrono::milliseconds{50}),
    force(false),
    glide_computer(_glide_computer) {
+  /* interrupt slow calculations as soon as there is a new fix */
+  glide_computer.SetIdleYield([this]{ return IsGPSPending(); });
+}
+
+CalculationThread::~CalculationThread() noexcept
+{
+  glide_computer.SetIdleYield(nullptr);
 }
 
 void
@@ -61,6 +68,13 @@ CalculationThread::SetScreenDistanceMeters(double new_value)
   screen_distance_meters = new_value;
 }
 
+bool
+CalculationThread::IsGPSPending() const noexcept
+{
+  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  return device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+}
+
 /**
  * Main loop of the CalculationThread
  */
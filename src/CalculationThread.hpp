@@ -58,6 +58,7 @@ class CalculationThread final : public WorkerThread {
 
 public:
   CalculationThread(GlideComputer &_glide_computer);
+  ~CalculationThread() noexcept;
 
   void SetComputerSettings(const ComputerSettings &new_value);
   void SetScreenDistanceMeters(double new_value);
@@ -72,6 +73,14 @@ public:
 
   void ForceTrigger();
 
+private:
+  /**
+   * Has the device blackboard received a GPS fix which has not been
+   * processed yet?
+   */
+  [[gnu::pure]]
+  bool IsGPSPending() const noexcept;
+
 protected:
   void Tick() noexcept override;
 };
@@ -114,6 +114,22 @@ CloudClientContainer::Insert(CloudClient &client)
   rtree.insert(client.shared_from_this());
 }
 
+void
+CloudClientContainer::Apply(const CloudClient &src)
+{
+  auto *client = Find(src.key);
+  if (client == nullptr) {
+    auto ptr = std::make_shared<CloudClient>(src);
+    Insert(*ptr);
+
+    if (src.id >= next_id)
+      next_id = src.id + 1;
+  } else {
+    Refresh(*client, src.address, src.location, src.altitude);
+    client->stamp = src.stamp;
+  }
+}
+
 void
 CloudClientContainer::Remove(CloudClient &client)
 {
@@ -252,6 +252,12 @@ public:
 
   void Insert(CloudClient &client);
 
+  /**
+   * Insert a copy of the given #CloudClient (e.g. loaded from a
+   * journal), or update the existing one with the same key.
+   */
+  void Apply(const CloudClient &src);
+
   /**
    * Remove a #CloudClient and its data.  Be careful - the given reference
    * is invalidated, unless the caller holds another #CloudClientPtr.
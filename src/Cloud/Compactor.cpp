@@ -0,0 +1,84 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Compactor.hpp"
+#include "Journal.hpp"
+#include "Data.hpp"
+#include "system/FileUtil.hpp"
+
+#include <memory>
+
+CloudCompactor::CloudCompactor(Path _db_path, Path _journal_path,
+                               std::chrono::steady_clock::time_point _expire_before)
+  :Thread("CloudCompactor"),
+   db_path(_db_path), journal_path(_journal_path),
+   expire_before(_expire_before)
+{
+  Start();
+}
+
+CloudCompactor::~CloudCompactor() noexcept
+{
+  if (IsDefined())
+    Join();
+}
+
+void
+CloudCompactor::Wait()
+{
+  if (IsDefined())
+    Join();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+CloudCompactor::Run() noexcept
+{
+  SetIdlePriority();
+
+  try {
+    /* allocate on the heap; CloudClientContainer has a large hash
+       table */
+    auto data = std::make_unique<CloudData>();
+
+    if (File::Exists(db_path))
+      LoadCloudSnapshot(*data, db_path);
+
+    ReplayCloudJournal(*data, journal_path);
+
+    data->clients.Expire(expire_before);
+
+    SaveCloudSnapshot(*data, db_path);
+
+    /* the journal is in the snapshot now; if we crash before this
+       line, replaying it again is skipped because of its
+       generation */
+    File::Delete(journal_path);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  finished.store(true, std::memory_order_release);
+}
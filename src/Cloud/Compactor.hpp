@@ -0,0 +1,88 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CLOUD_COMPACTOR_HPP
+#define XCSOAR_CLOUD_COMPACTOR_HPP
+
+#include "thread/Thread.hpp"
+#include "system/Path.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+/**
+ * Merges a closed #CloudJournal into the snapshot file in a separate
+ * thread: it loads the old snapshot into a private #CloudData,
+ * replays the journal, expires stale clients and writes a new
+ * snapshot.  After that, the journal is deleted.
+ *
+ * This works on files only and never touches the server's
+ * in-memory state, so the event loop doesn't need to wait for it.
+ */
+class CloudCompactor final : private Thread {
+  const AllocatedPath db_path, journal_path;
+
+  /**
+   * Clients whose last fix is older than this are not copied to the
+   * new snapshot.
+   */
+  const std::chrono::steady_clock::time_point expire_before;
+
+  std::atomic_bool finished{false};
+
+  /**
+   * The error which has occurred in the thread.  Only valid after
+   * #finished has been set.
+   */
+  std::exception_ptr error;
+
+public:
+  /**
+   * Throws on error.
+   */
+  CloudCompactor(Path _db_path, Path _journal_path,
+                 std::chrono::steady_clock::time_point _expire_before);
+
+  /**
+   * Waits for the thread to finish.
+   */
+  ~CloudCompactor() noexcept;
+
+  bool IsFinished() const noexcept {
+    return finished.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Waits for the thread to finish.
+   *
+   * Throws the error which has occurred in the thread.
+   */
+  void Wait();
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
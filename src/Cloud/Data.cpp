@@ -58,6 +58,8 @@ CloudData::Save(Serialiser &s) const
   clients.Save(s);
   s.Write8(1);
   thermals.Save(s);
+  s.Write8(2);
+  s.Write64(journal_generation);
   s.Write8(0);
 }
 
@@ -74,6 +76,10 @@ CloudData::Load(Deserialiser &s)
 
   if (s.Read8() != 0) {
     thermals.Load(s);
-    s.Read8();
+
+    if (s.Read8() != 0) {
+      journal_generation = s.Read64();
+      s.Read8();
+    }
   }
 }
@@ -34,6 +34,13 @@ struct CloudData {
   CloudClientContainer clients;
   CloudThermalContainer thermals;
 
+  /**
+   * The generation of the newest #CloudJournal whose records have
+   * been merged into this object.  Older journals are skipped during
+   * replay.
+   */
+  uint64_t journal_generation = 0;
+
   void DumpClients();
 
   void Save(Serialiser &s) const;
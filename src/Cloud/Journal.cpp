@@ -0,0 +1,178 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Journal.hpp"
+#include "Data.hpp"
+#include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Error.hxx"
+
+#include <stdexcept>
+
+static constexpr uint32_t JOURNAL_MAGIC = 0x5753f610;
+static constexpr uint32_t JOURNAL_VERSION = 1;
+
+/**
+ * The records of a journal file.  Zero marks the end (and it is
+ * what a block of unwritten data looks like after a crash).
+ */
+enum class JournalRecord : uint8_t {
+  END = 0,
+  CLIENT = 1,
+  THERMAL = 2,
+};
+
+/**
+ * The maximum time between appending a record and writing it to the
+ * file.  This limits how much data a crash can lose.
+ */
+static constexpr std::chrono::steady_clock::duration JOURNAL_COMMIT_INTERVAL =
+  std::chrono::seconds(2);
+
+CloudJournal::CloudJournal(Path path, uint64_t _generation)
+  :file(path, FileOutputStream::Mode::CREATE_VISIBLE),
+   threaded(file, JOURNAL_COMMIT_INTERVAL, 256 * 1024),
+   s(threaded),
+   generation(_generation)
+{
+  s.Write32(JOURNAL_MAGIC);
+  s.Write32(JOURNAL_VERSION);
+  s.Write64(generation);
+  s.Flush();
+}
+
+void
+CloudJournal::Append(const CloudClient &client)
+{
+  s.Write8(uint8_t(JournalRecord::CLIENT));
+  client.Save(s);
+
+  /* pass the record to the ring buffer right away; this is only a
+     memcpy() */
+  s.Flush();
+}
+
+void
+CloudJournal::Append(const CloudThermal &thermal)
+{
+  s.Write8(uint8_t(JournalRecord::THERMAL));
+  thermal.Save(s);
+  s.Flush();
+}
+
+void
+CloudJournal::Commit()
+{
+  s.Flush();
+  threaded.Flush();
+  file.Commit();
+}
+
+unsigned
+ReplayCloudJournal(CloudData &data, Path path)
+{
+  if (!File::Exists(path))
+    return 0;
+
+  FileReader fr(path);
+  Deserialiser s(fr);
+
+  if (s.Read32() != JOURNAL_MAGIC)
+    throw std::runtime_error("Bad journal magic");
+
+  if (s.Read32() != JOURNAL_VERSION)
+    throw std::runtime_error("Bad journal version");
+
+  const uint64_t generation = s.Read64();
+  if (generation <= data.journal_generation)
+    /* already merged into the snapshot */
+    return 0;
+
+  data.journal_generation = generation;
+
+  unsigned n = 0;
+
+  try {
+    while (true) {
+      /* each record is parsed completely before it is applied, so a
+         torn record at the end is discarded as a whole */
+      switch (JournalRecord(s.Read8())) {
+      case JournalRecord::END:
+        return n;
+
+      case JournalRecord::CLIENT:
+        data.clients.Apply(CloudClient::Load(s));
+        break;
+
+      case JournalRecord::THERMAL:
+        {
+          auto thermal =
+            std::make_shared<CloudThermal>(CloudThermal::Load(s));
+          data.thermals.Insert(*thermal);
+        }
+        break;
+
+      default:
+        /* garbage; this is probably the end of a partially written
+           journal */
+        return n;
+      }
+
+      ++n;
+    }
+  } catch (const std::runtime_error &) {
+    /* premature end of file: the server has crashed while writing
+       the last record */
+  }
+
+  return n;
+}
+
+void
+LoadCloudSnapshot(CloudData &data, Path path)
+{
+  FileReader fr(path);
+  Deserialiser s(fr);
+  data.Load(s);
+}
+
+void
+SaveCloudSnapshot(const CloudData &data, Path path)
+{
+  const auto tmp_path = path + ".tmp";
+
+  {
+    FileOutputStream fos(tmp_path, FileOutputStream::Mode::CREATE_VISIBLE);
+
+    {
+      Serialiser s(fos);
+      data.Save(s);
+      s.Flush();
+    }
+
+    fos.Commit();
+  }
+
+  if (!File::Replace(tmp_path, path))
+    throw FormatErrno("Failed to rename %s", tmp_path.c_str());
+}
@@ -0,0 +1,120 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CLOUD_JOURNAL_HPP
+#define XCSOAR_CLOUD_JOURNAL_HPP
+
+#include "Serialiser.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/ThreadedOutputStream.hpp"
+
+#include <cstdint>
+
+class Path;
+struct CloudData;
+struct CloudClient;
+struct CloudThermal;
+
+/**
+ * An append-only log of all changes to #CloudData since the last
+ * snapshot.  Appending only copies the record into a ring buffer;
+ * the file is written by a #ThreadedOutputStream, so the event loop
+ * never waits for the disk.
+ *
+ * Each journal has a "generation" number which is stored in its
+ * header.  A snapshot remembers the generation of the newest journal
+ * merged into it (#CloudData::journal_generation), which makes
+ * replaying a journal twice harmless.
+ */
+class CloudJournal {
+  FileOutputStream file;
+  ThreadedOutputStream threaded;
+  Serialiser s;
+
+  const uint64_t generation;
+
+public:
+  /**
+   * Create a new (empty) journal file, replacing an existing one.
+   *
+   * Throws on error.
+   */
+  CloudJournal(Path path, uint64_t _generation);
+
+  uint64_t GetGeneration() const noexcept {
+    return generation;
+  }
+
+  /**
+   * Throws on error.
+   */
+  void Append(const CloudClient &client);
+
+  /**
+   * Throws on error.
+   */
+  void Append(const CloudThermal &thermal);
+
+  /**
+   * Wait until all records have been written and close the file.
+   * After that, this object must be destructed.
+   *
+   * Throws on error.
+   */
+  void Commit();
+};
+
+/**
+ * Apply the records of a journal file to the given #CloudData.  A
+ * journal which does not exist or which is not newer than
+ * #CloudData::journal_generation is skipped.  A truncated or
+ * corrupt tail, left by a crash, ends the replay silently; all
+ * complete records before it are applied.
+ *
+ * Throws on error.
+ *
+ * @return the number of records which were applied
+ */
+unsigned
+ReplayCloudJournal(CloudData &data, Path path);
+
+/**
+ * Load a snapshot file written by SaveCloudSnapshot() into the given
+ * (empty) #CloudData.
+ *
+ * Throws on error.
+ */
+void
+LoadCloudSnapshot(CloudData &data, Path path);
+
+/**
+ * Write a snapshot of the given #CloudData.  The file is written
+ * under a temporary name and then renamed, so a crash leaves either
+ * the old or the new snapshot, but never a partial one.
+ *
+ * Throws on error.
+ */
+void
+SaveCloudSnapshot(const CloudData &data, Path path);
+
+#endif
@@ -22,6 +22,8 @@ Copyright_License {
 */
 
 #include "Data.hpp"
+#include "Journal.hpp"
+#include "Compactor.hpp"
 #include "Dump.hpp"
 #include "Sender.hpp"
 #include "Serialiser.hpp"
@@ -32,14 +34,15 @@ Copyright_License {
 #include "event/CoarseTimerEvent.hxx"
 #include "event/SignalMonitor.hxx"
 #include "net/IPv4Address.hxx"
-#include "io/FileOutputStream.hxx"
-#include "io/FileReader.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Error.hxx"
 #include "util/PrintException.hxx"
 #include "util/Exception.hxx"
 #include "util/Compiler.h"
 #include "util/ScopeExit.hxx"
 
 #include <array>
+#include <memory>
 #include <iostream>
 #include <iomanip>
 
@@ -52,6 +55,8 @@ static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chro
 
 static constexpr std::chrono::steady_clock::duration REQUEST_EXPIRY = std::chrono::minutes(5);
 
+static constexpr std::chrono::steady_clock::duration CLIENT_EXPIRY = std::chrono::minutes(10);
+
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -61,6 +66,16 @@ class CloudServer final
 {
   const AllocatedPath db_path;
 
+  /**
+   * The journal being written, and the one being merged into the
+   * snapshot by #compactor.
+   */
+  const AllocatedPath journal_path, old_journal_path;
+
+  std::unique_ptr<CloudJournal> journal;
+
+  std::unique_ptr<CloudCompactor> compactor;
+
   CoarseTimerEvent save_timer, expire_timer;
 
 public:
@@ -68,6 +83,8 @@ public:
               SocketAddress bind_address)
     :SkyLinesTracking::Server(event_loop, bind_address),
      db_path(std::move(_db_path)),
+     journal_path(db_path + ".journal"),
+     old_journal_path(db_path + ".journal.old"),
      save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
      expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
   {
@@ -83,12 +100,33 @@ public:
     ScheduleSave();
   }
 
+  /**
+   * Load the snapshot and replay the journals left by the previous
+   * process.
+   */
   void Load();
+
+  /**
+   * Write a complete snapshot synchronously and start a new journal.
+   * This blocks the event loop and is only used at startup, at
+   * shutdown and if compacting has failed.
+   */
   void Save();
 
 private:
+  /**
+   * Close the current journal, start a new one and let
+   * #CloudCompactor merge the old one into the snapshot.
+   */
+  void Compact() noexcept;
+
+  void OpenJournal();
+
+  void AppendJournal(const CloudClient &client) noexcept;
+  void AppendJournal(const CloudThermal &thermal) noexcept;
+
   void OnSaveTimer() noexcept {
-    Save();
+    Compact();
     ScheduleSave();
   }
 
@@ -97,7 +135,7 @@ private:
   }
 
   void OnExpireTimer() noexcept {
-    clients.Expire(GetEventLoop().SteadyNow() - std::chrono::minutes(10));
+    clients.Expire(GetEventLoop().SteadyNow() - CLIENT_EXPIRY);
     if (!clients.empty())
       ScheduleExpire();
   }
@@ -150,7 +188,7 @@ protected:
   }
 
   void OnReloadSignal() noexcept {
-    Save();
+    Compact();
   }
 
   void OnDumpSignal() noexcept {
@@ -180,6 +218,8 @@ CloudServer::OnFix(const Client &c,
          << client->altitude << 'm'
          << endl;
 
+    AppendJournal(*client);
+
     if (was_empty)
       ScheduleExpire();
   } else {
@@ -304,6 +344,8 @@ CloudServer::OnThermalSubmit(const Client &c,
                   AGeoPoint(top_location, top_altitude),
                   lift);
 
+  AppendJournal(thermal);
+
   /* send this new thermal to all interested clients immediately */
   const auto now = std::chrono::steady_clock::now();
   for (const auto &i : clients.QueryWithinRange(bottom_location,
@@ -364,9 +406,13 @@ CloudServer::OnThermalRequest(const Client &c)
 void
 CloudServer::Load()
 {
-  FileReader fr(db_path);
-  Deserialiser s(fr);
-  CloudData::Load(s);
+  if (File::Exists(db_path))
+    LoadCloudSnapshot(*this, db_path);
+
+  /* the old journal exists only if the server was stopped while
+     compacting */
+  ReplayCloudJournal(*this, old_journal_path);
+  ReplayCloudJournal(*this, journal_path);
 }
 
 void
@@ -374,15 +420,107 @@ CloudServer::Save()
 {
   cout << "Saving data to " << db_path.c_str() << endl;
 
-  FileOutputStream fos(db_path);
+  if (compactor) {
+    try {
+      compactor->Wait();
+    } catch (...) {
+      /* doesn't matter, we're going to write everything */
+    }
 
-  {
-    Serialiser s(fos);
-    CloudData::Save(s);
-    s.Flush();
+    compactor.reset();
+  }
+
+  if (journal) {
+    /* all records are in memory already, so the snapshot includes
+       this journal */
+    journal_generation = journal->GetGeneration();
+    journal.reset();
+  }
+
+  SaveCloudSnapshot(*this, db_path);
+
+  File::Delete(old_journal_path);
+  File::Delete(journal_path);
+
+  OpenJournal();
+}
+
+void
+CloudServer::OpenJournal()
+{
+  journal = std::make_unique<CloudJournal>(journal_path,
+                                           journal_generation + 1);
+}
+
+void
+CloudServer::Compact() noexcept
+try {
+  if (compactor) {
+    if (!compactor->IsFinished())
+      /* still busy; try again next time */
+      return;
+
+    auto c = std::move(compactor);
+    c->Wait();
   }
 
-  fos.Commit();
+  if (!journal) {
+    /* a previous journal write has failed; start over */
+    Save();
+    return;
+  }
+
+  const uint64_t generation = journal->GetGeneration();
+  journal->Commit();
+  journal.reset();
+
+  if (!File::Rename(journal_path, old_journal_path))
+    throw FormatErrno("Failed to rename %s", journal_path.c_str());
+
+  journal_generation = generation;
+  OpenJournal();
+
+  compactor = std::make_unique<CloudCompactor>(db_path, old_journal_path,
+                                               GetEventLoop().SteadyNow() - CLIENT_EXPIRY);
+} catch (...) {
+  cerr << "Failed to compact database: " << GetFullMessage(std::current_exception())
+       << endl;
+
+  /* fall back to writing everything synchronously, so no journal
+     gets lost */
+  try {
+    Save();
+  } catch (...) {
+    PrintException(std::current_exception());
+  }
+}
+
+void
+CloudServer::AppendJournal(const CloudClient &client) noexcept
+{
+  if (!journal)
+    return;
+
+  try {
+    journal->Append(client);
+  } catch (...) {
+    PrintException(std::current_exception());
+    journal.reset();
+  }
+}
+
+void
+CloudServer::AppendJournal(const CloudThermal &thermal) noexcept
+{
+  if (!journal)
+    return;
+
+  try {
+    journal->Append(thermal);
+  } catch (...) {
+    PrintException(std::current_exception());
+    journal.reset();
+  }
 }
 
 int
@@ -409,6 +547,9 @@ try {
     PrintException(e);
   }
 
+  /* merge everything into a fresh snapshot and start a new journal */
+  server.Save();
+
   event_loop.Run();
 
   server.Save();
@@ -33,6 +33,7 @@ FileCache *file_cache;
 TopographyStore *topography;
 RasterTerrain *terrain;
 AsyncTerrainOverviewLoader *terrain_loader;
+AsyncAirspaceTerrainLoader *airspace_terrain_loader;
 
 #ifndef ENABLE_OPENGL
 DrawThread *draw_thread;
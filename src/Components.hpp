@@ -28,6 +28,7 @@ class FileCache;
 class TopographyStore;
 class RasterTerrain;
 class AsyncTerrainOverviewLoader;
+class AsyncAirspaceTerrainLoader;
 class GlideComputer;
 class DrawThread;
 class MultipleDevices;
@@ -54,6 +55,7 @@ extern Replay *replay;
 extern TopographyStore *topography;
 extern RasterTerrain *terrain;
 extern AsyncTerrainOverviewLoader *terrain_loader;
+extern AsyncAirspaceTerrainLoader *airspace_terrain_loader;
 extern GlideComputer *glide_computer;
 #ifndef ENABLE_OPENGL
 extern DrawThread *draw_thread;
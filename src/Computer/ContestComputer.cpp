@@ -32,12 +32,12 @@ ContestComputer::ContestComputer(const Trace &trace_full,
   contest_manager.SetIncremental(true);
 }
 
-void
+bool
 ContestComputer::Solve(const ContestSettings &settings,
                        ContestStatistics &contest_stats)
 {
   if (!settings.enable)
-    return;
+    return false;
 
   contest_manager.SetHandicap(settings.handicap);
   contest_manager.SetContest(settings.contest);
@@ -45,6 +45,8 @@ ContestComputer::Solve(const ContestSettings &settings,
   contest_manager.UpdateIdle();
 
   contest_stats = contest_manager.GetStats();
+
+  return contest_manager.IsIncomplete();
 }
 
 bool
@@ -53,7 +53,13 @@ public:
     contest_manager.SetPredicted(predicted);
   }
 
-  void Solve(const ContestSettings &settings_computer,
+  /**
+   * Perform one incremental step of the solver.
+   *
+   * @return true if the solver has more work to do and wants to be
+   * called again
+   */
+  bool Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
   bool SolveExhaustive(const ContestSettings &settings_computer,
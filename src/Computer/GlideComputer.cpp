@@ -47,6 +47,64 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
   idle_clock.Update();
+
+  AddIdleTasks();
+}
+
+void
+GlideComputer::AddIdleTasks()
+{
+  using Priority = IdleScheduler::Priority;
+
+  /* warnings first: they must never wait for the contest solver */
+
+  idle_scheduler.Add("airspace warnings", Priority::CRITICAL,
+                     milliseconds{50}, [this](bool){
+    warning_computer.Update(GetComputerSettings(), Basic(),
+                            Calculated(), SetCalculated().airspace_warnings);
+    return false;
+  });
+
+  idle_scheduler.Add("condition monitors", Priority::CRITICAL,
+                     milliseconds{10}, [this](bool){
+    idle_condition_monitors.Update(Basic(), Calculated(),
+                                   GetComputerSettings());
+    return false;
+  });
+
+  /* log GPS fixes for internal usage (snail trail, stats, contest,
+     ...); skipping a cycle would lose a sample */
+  idle_scheduler.Add("logging", Priority::CRITICAL,
+                     milliseconds{10}, [this](bool){
+    stats_computer.DoLogging(Basic(), Calculated());
+    log_computer.Run(Basic(), Calculated(), GetComputerSettings().logger);
+    return false;
+  });
+
+  idle_scheduler.Add("task", Priority::NORMAL,
+                     milliseconds{20}, [this](bool){
+    task_computer.ProcessIdle(Basic(), Calculated());
+    return false;
+  });
+
+  idle_scheduler.Add("retrospective", Priority::NORMAL,
+                     milliseconds{5}, [this](bool){
+    // Calculate summary of flight
+    if (Basic().location_available)
+      retrospective.UpdateSample(Basic().location);
+    return false;
+  });
+
+  /* the contest solver is incremental: it is resumed until its
+     budget is used up or new GPS data arrives (see
+     CalculationThread), and continues in the next cycle; the budget
+     is small, because on a single-core device, the next ProcessGPS()
+     call waits for it */
+  idle_scheduler.Add("contest", Priority::BACKGROUND,
+                     milliseconds{20}, [this](bool exhaustive){
+    return task_computer.ProcessContest(Basic(), SetCalculated(),
+                                        GetComputerSettings(), exhaustive);
+  });
 }
 
 void
@@ -161,25 +219,7 @@ GlideComputer::ProcessGPS(bool force)
 void
 GlideComputer::ProcessIdle(bool exhaustive)
 {
-  const MoreData &basic = Basic();
-  DerivedInfo &calculated = SetCalculated();
-
-  // Log GPS fixes for internal usage
-  // (snail trail, stats, contest, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
-
-  idle_condition_monitors.Update(basic, calculated, GetComputerSettings());
-
-  // Calculate summary of flight
-  if (basic.location_available)
-    retrospective.UpdateSample(basic.location);
+  idle_scheduler.Run(exhaustive);
 }
 
 bool
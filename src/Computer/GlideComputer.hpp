@@ -33,6 +33,7 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "IdleScheduler.hpp"
 #include "util/Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 #include "ConditionMonitor/ConditionMonitors.hpp"
@@ -68,6 +69,11 @@ class GlideComputer : public GlideComputerBlackboard
 
   PeriodClock idle_clock;
 
+  /**
+   * Runs the slow calculations of ProcessIdle().
+   */
+  IdleScheduler idle_scheduler;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
@@ -112,6 +118,10 @@ public:
 
   /**
    * Process slow calculations. Called by the CalculationThread.
+   *
+   * Warnings are calculated first; other calculations may be
+   * deferred or suspended if they exceed their time budget, see
+   * #IdleScheduler.
    */
   void ProcessIdle(bool exhaustive=false);
 
@@ -119,6 +129,24 @@ public:
     ProcessIdle(true);
   }
 
+  const IdleScheduler &GetIdleScheduler() const {
+    return idle_scheduler;
+  }
+
+  /**
+   * @see IdleScheduler::SetTimeSlicing()
+   */
+  void SetIdleTimeSlicing(bool enable) {
+    idle_scheduler.SetTimeSlicing(enable);
+  }
+
+  /**
+   * @see IdleScheduler::SetYield()
+   */
+  void SetIdleYield(IdleScheduler::YieldFunction yield) {
+    idle_scheduler.SetYield(std::move(yield));
+  }
+
   void OnStartTask();
   void OnFinishTask();
   void OnTransitionEnter();
@@ -194,6 +222,8 @@ private:
    */
   void CalculateOwnTeamCode();
 
+  void AddIdleTasks();
+
   void CalculateWorkingBand();
   void CalculateVarioScale();
 };
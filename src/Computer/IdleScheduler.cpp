@@ -0,0 +1,105 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "IdleScheduler.hpp"
+
+#include <algorithm>
+
+void
+IdleScheduler::Add(const char *name, Priority priority, Duration budget,
+                   Function function)
+{
+  const auto i = std::find_if(tasks.begin(), tasks.end(),
+                              [priority](const Task &task){
+                                return task.priority > priority;
+                              });
+
+  tasks.insert(i, Task{name, priority, budget, std::move(function)});
+}
+
+void
+IdleScheduler::Run(bool exhaustive)
+{
+  const auto start = Clock::now();
+  const auto deadline = start + slice;
+
+  for (auto &task : tasks) {
+    const auto task_start = Clock::now();
+
+    if (!exhaustive && time_slicing &&
+        task.priority != Priority::CRITICAL &&
+        (task_start >= deadline || ShouldYield()) &&
+        task.consecutive_deferrals < MAX_DEFERRALS) {
+      ++task.metrics.deferrals;
+      ++task.consecutive_deferrals;
+      continue;
+    }
+
+    task.consecutive_deferrals = 0;
+
+    /* critical tasks are limited only by their own budget */
+    const auto task_deadline = task.priority == Priority::CRITICAL
+      ? task_start + task.budget
+      : std::min(task_start + task.budget, deadline);
+
+    Metrics &metrics = task.metrics;
+    bool more;
+    Clock::time_point now;
+    do {
+      more = task.function(exhaustive);
+      ++metrics.steps;
+      now = Clock::now();
+    } while (more && !exhaustive && time_slicing && now < task_deadline &&
+             (task.priority == Priority::CRITICAL || !ShouldYield()));
+
+    task.suspended = more;
+
+    const auto duration = now - task_start;
+    const auto latency = task_start - start;
+
+    ++metrics.runs;
+    if (duration > task.budget)
+      ++metrics.overruns;
+
+    metrics.last_duration = duration;
+    metrics.max_duration = std::max(metrics.max_duration, duration);
+    metrics.total_duration += duration;
+    metrics.last_latency = latency;
+    metrics.max_latency = std::max(metrics.max_latency, latency);
+  }
+}
+
+bool
+IdleScheduler::IsSuspended() const noexcept
+{
+  return std::any_of(tasks.begin(), tasks.end(), [](const Task &task){
+    return task.suspended;
+  });
+}
+
+void
+IdleScheduler::ResetMetrics() noexcept
+{
+  for (auto &task : tasks)
+    task.metrics = {};
+}
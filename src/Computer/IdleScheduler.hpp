@@ -0,0 +1,222 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef XCSOAR_IDLE_SCHEDULER_HPP
+#define XCSOAR_IDLE_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/**
+ * A cooperative scheduler for the slow calculations done by
+ * GlideComputer::ProcessIdle().
+ *
+ * Each task has a priority and a time budget.  Critical tasks
+ * (warnings) always run first and are never deferred.  The others
+ * run in order of priority as long as the time slice of the current
+ * cycle lasts; the remaining ones are deferred to the next cycle.
+ *
+ * A task which has more work to do (e.g. an incremental solver which
+ * has not converged yet) returns true; it is called again while its
+ * budget lasts, and resumed in the next cycle after that.
+ */
+class IdleScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  enum class Priority : uint8_t {
+    /**
+     * Warning-critical work.  Runs first in each cycle and is never
+     * deferred.
+     */
+    CRITICAL,
+
+    NORMAL,
+
+    /**
+     * Optimisations which can wait, e.g. the contest solver.
+     */
+    BACKGROUND,
+  };
+
+  /**
+   * Perform one step of the task.
+   *
+   * @param exhaustive finish the work now, ignoring all time limits
+   * @return true if there is more work to do
+   */
+  using Function = std::function<bool(bool exhaustive)>;
+
+  /**
+   * Determine whether the current cycle should end early, e.g.
+   * because new input is waiting to be processed.
+   */
+  using YieldFunction = std::function<bool()>;
+
+  /**
+   * A task which was deferred this number of cycles in a row runs
+   * anyway, so low-priority work cannot starve.
+   */
+  static constexpr unsigned MAX_DEFERRALS = 4;
+
+  struct Metrics {
+    /**
+     * The number of cycles in which the task ran.
+     */
+    unsigned runs = 0;
+
+    /**
+     * The number of calls to the #Function.
+     */
+    unsigned steps = 0;
+
+    /**
+     * The number of cycles in which the task was skipped because
+     * the time slice was used up.
+     */
+    unsigned deferrals = 0;
+
+    /**
+     * The number of cycles in which the task exceeded its budget.
+     */
+    unsigned overruns = 0;
+
+    /**
+     * The execution time in one cycle.
+     */
+    Duration last_duration{}, max_duration{}, total_duration{};
+
+    /**
+     * The time from the start of the cycle until the task started
+     * running.
+     */
+    Duration last_latency{}, max_latency{};
+
+    Duration GetAverageDuration() const noexcept {
+      return runs > 0 ? total_duration / runs : Duration{};
+    }
+  };
+
+  struct Task {
+    const char *name;
+    Priority priority;
+    Duration budget;
+    Function function;
+
+    Metrics metrics;
+
+    /**
+     * The number of cycles since the task ran last.
+     */
+    unsigned consecutive_deferrals = 0;
+
+    /**
+     * Did the task return with more work to do?
+     */
+    bool suspended = false;
+  };
+
+private:
+  /**
+   * All tasks, sorted by priority; tasks with the same priority
+   * keep the order in which they were added.
+   */
+  std::vector<Task> tasks;
+
+  Duration slice = std::chrono::milliseconds{100};
+
+  bool time_slicing = true;
+
+  YieldFunction yield;
+
+public:
+  /**
+   * Register a new task.
+   *
+   * @param name a string literal for diagnostics
+   * @param budget the execution time per cycle; a task which has more
+   * work to do is called again until this time is used up
+   */
+  void Add(const char *name, Priority priority, Duration budget,
+           Function function);
+
+  /**
+   * Set the time after which a cycle stops starting non-critical
+   * tasks.
+   */
+  void SetSlice(Duration _slice) noexcept {
+    slice = _slice;
+  }
+
+  /**
+   * Enable or disable time slicing.  If disabled, every task runs
+   * exactly one step per cycle, regardless of the wall clock.  This
+   * makes the results independent of the CPU speed, which is useful
+   * for replays and benchmarks.
+   */
+  void SetTimeSlicing(bool _time_slicing) noexcept {
+    time_slicing = _time_slicing;
+  }
+
+  /**
+   * Install a check which is polled before each step of a
+   * non-critical task.  If it returns true, the task is suspended
+   * and the remaining non-critical tasks are deferred, as if the
+   * time slice was used up.  It is ignored if time slicing is
+   * disabled.
+   */
+  void SetYield(YieldFunction _yield) noexcept {
+    yield = std::move(_yield);
+  }
+
+  /**
+   * Run one cycle.
+   *
+   * @param exhaustive run all tasks to completion, ignoring the
+   * slice and the budgets
+   */
+  void Run(bool exhaustive=false);
+
+  /**
+   * Is there a task which has returned with more work to do?
+   */
+  [[gnu::pure]]
+  bool IsSuspended() const noexcept;
+
+  std::span<const Task> GetTasks() const noexcept {
+    return tasks;
+  }
+
+  void ResetMetrics() noexcept;
+
+private:
+  bool ShouldYield() const {
+    return yield && yield();
+  }
+};
+
+#endif
@@ -146,20 +146,25 @@ Predicted(const ContestSettings &settings,
                     0, 0);
 }
 
-void
-TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                          const ComputerSettings &settings_computer,
-                          bool exhaustive)
+bool
+TaskComputer::ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             bool exhaustive)
 {
   contest.SetPredicted(Predicted(settings_computer.contest, basic,
                                  calculated.task_stats.current_leg));
 
-  if (exhaustive)
+  if (exhaustive) {
     contest.SolveExhaustive(settings_computer.contest,
                             calculated.contest_stats);
-  else
-    contest.Solve(settings_computer.contest, calculated.contest_stats);
+    return false;
+  } else
+    return contest.Solve(settings_computer.contest, calculated.contest_stats);
+}
 
+void
+TaskComputer::ProcessIdle(const MoreData &basic, const DerivedInfo &calculated)
+{
   const AircraftState as = ToAircraftState(basic, calculated);
 
   ProtectedTaskManager::ExclusiveLease _task(task);
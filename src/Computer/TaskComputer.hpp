@@ -102,9 +102,17 @@ public:
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
-  void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                   const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+  /**
+   * Run the contest solver.  In incremental mode, this performs only
+   * one step.
+   *
+   * @return true if the solver has more work to do
+   */
+  bool ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
+
+  void ProcessIdle(const MoreData &basic, const DerivedInfo &calculated);
 };
 
 #endif
@@ -29,9 +29,7 @@
 struct AirspaceLook;
 class Canvas;
 class ChartRenderer;
-class Airspaces;
-struct GeoPoint;
-struct GeoVector;
+class CrossSectionProfile;
 struct AircraftState;
 
 /**
@@ -47,8 +45,7 @@ public:
   AirspaceXSRenderer(const AirspaceLook &_look): look(_look) {}
 
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const Airspaces &database,
-            const GeoPoint &start, const GeoVector &vec,
+            const CrossSectionProfile &profile,
             const AircraftState &state) const;
 
   void SetSettings(const AirspaceRendererSettings &_settings) {
@@ -0,0 +1,190 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CrossSectionProfile.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include <math.h>
+
+/**
+ * A new track line is started when the cross-section window has
+ * moved this far (in multiples of the range) away from the line
+ * origin, to limit the error of the flat-earth approximations.
+ */
+static constexpr double MAX_LINE_LENGTH_FACTOR = 4;
+
+GeoPoint
+CrossSectionProfile::GetLinePoint(double distance) const noexcept
+{
+  return GeoVector(distance, bearing).EndPoint(origin);
+}
+
+void
+CrossSectionProfile::StartLine(const GeoPoint &start,
+                               const GeoVector &vec) noexcept
+{
+  origin = start;
+  bearing = vec.bearing;
+  spacing = vec.distance / (NUM_SLICES - 1);
+  offset = 0;
+  n_samples = 0;
+  airspaces.clear();
+  airspace_end = -1;
+}
+
+void
+CrossSectionProfile::Update(const GeoPoint &start,
+                            const GeoVector &vec) noexcept
+{
+  range = vec.distance;
+
+  if (!origin.IsValid() ||
+      fabs(vec.distance / (NUM_SLICES - 1) - spacing) > spacing * 1e-6) {
+    StartLine(start, vec);
+    return;
+  }
+
+  /* where is the new cross-section relative to the track line? */
+  const GeoVector to_start = origin.DistanceBearingS(start);
+  const Angle start_delta = (to_start.bearing - bearing).AsDelta();
+  const double along = to_start.distance * start_delta.cos();
+  const double start_cross = to_start.distance * start_delta.sin();
+  const double end_cross = start_cross +
+    vec.distance * (vec.bearing - bearing).AsDelta().sin();
+
+  /* the samples are one spacing apart, so a lateral deviation up to
+     that is below the resolution of the cross-section */
+  if (along < 0 ||
+      along + vec.distance > MAX_LINE_LENGTH_FACTOR * vec.distance ||
+      fabs(start_cross) > spacing || fabs(end_cross) > spacing) {
+    StartLine(start, vec);
+    return;
+  }
+
+  offset = along;
+}
+
+void
+CrossSectionProfile::UpdateTerrain(const RasterMap &map) noexcept
+{
+  assert(origin.IsValid());
+
+  if (&map != terrain_source || map.GetSerial() != terrain_serial) {
+    /* tiles have been loaded or the terrain has been replaced */
+    terrain_source = &map;
+    terrain_serial = map.GetSerial();
+    n_samples = 0;
+  }
+
+  const unsigned first = unsigned(offset / spacing);
+
+  if (first < first_sample || first >= first_sample + n_samples) {
+    n_samples = 0;
+  } else if (first > first_sample) {
+    /* drop the samples which are behind */
+    const unsigned shift = first - first_sample;
+    std::copy(samples.begin() + shift, samples.begin() + n_samples,
+              samples.begin());
+    n_samples -= shift;
+  }
+
+  first_sample = first;
+
+  /* look up only the samples which have come into view */
+  for (; n_samples < NUM_SAMPLES; ++n_samples) {
+    samples[n_samples] =
+      map.GetHeight(GetLinePoint((first_sample + n_samples) * spacing));
+    ++terrain_queries;
+  }
+}
+
+/**
+ * Collects the intersections of all airspaces with the track line.
+ */
+class AirspaceSliceCollector final : public AirspaceIntersectionVisitor {
+  std::vector<CrossSectionProfile::AirspaceSlice> &slices;
+
+  const GeoPoint begin;
+  const double begin_distance, end_distance;
+
+public:
+  AirspaceSliceCollector(std::vector<CrossSectionProfile::AirspaceSlice> &_slices,
+                         const GeoPoint &_begin,
+                         double _begin_distance, double _end_distance) noexcept
+    :slices(_slices), begin(_begin),
+     begin_distance(_begin_distance), end_distance(_end_distance) {}
+
+  void Visit(ConstAirspacePtr as) noexcept override {
+    if (intersections.empty())
+      return;
+
+    CrossSectionProfile::AirspaceSlice slice;
+    slice.airspace = std::move(as);
+
+    for (const auto &i : intersections) {
+      const double a = begin_distance + begin.Distance(i.first);
+
+      /* only one edge found: the next one is beyond the end */
+      const double b = i.first == i.second
+        ? end_distance
+        : begin_distance + begin.Distance(i.second);
+
+      slice.intervals.emplace_back(a, b);
+    }
+
+    slices.emplace_back(std::move(slice));
+  }
+};
+
+void
+CrossSectionProfile::UpdateAirspaces(const Airspaces &database) noexcept
+{
+  assert(origin.IsValid());
+
+  if (&database != airspace_source ||
+      database.GetSerial() != airspace_serial) {
+    airspace_source = &database;
+    airspace_serial = database.GetSerial();
+    airspace_end = -1;
+  }
+
+  if (offset >= airspace_begin && offset + range <= airspace_end)
+    /* still covered */
+    return;
+
+  airspace_begin = offset;
+  airspace_end = offset + 2 * range;
+  const GeoPoint begin = GetLinePoint(airspace_begin);
+
+  airspaces.clear();
+  AirspaceSliceCollector collector(airspaces, begin,
+                                   airspace_begin, airspace_end);
+  database.VisitIntersecting(begin, GetLinePoint(airspace_end), true,
+                             collector);
+}
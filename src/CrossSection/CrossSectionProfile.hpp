@@ -0,0 +1,201 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef CROSS_SECTION_PROFILE_HPP
+#define CROSS_SECTION_PROFILE_HPP
+
+#include "Terrain/Height.hpp"
+#include "Engine/Airspace/Ptr.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/Angle.hpp"
+#include "util/Serial.hpp"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+struct GeoVector;
+class RasterMap;
+class Airspaces;
+
+/**
+ * Caches the terrain profile and the airspace intersections of the
+ * cross-section along a straight "track line".  As long as the
+ * aircraft flies along this line, the cross-section is drawn from
+ * the samples which are still ahead, and only the samples which come
+ * into view at the far end are looked up.  When the aircraft turns
+ * away from the line or the range changes, a new line is started.
+ *
+ * All distances returned by this class are relative to the start of
+ * the cross-section which was passed to Update().
+ */
+class CrossSectionProfile {
+public:
+  static constexpr unsigned NUM_SLICES = 64;
+
+  /**
+   * One more than #NUM_SLICES, because the samples are aligned to the
+   * track line, not to the start of the cross-section.
+   */
+  static constexpr unsigned NUM_SAMPLES = NUM_SLICES + 1;
+
+  struct AirspaceSlice {
+    ConstAirspacePtr airspace;
+
+    /**
+     * The intervals where the track line is inside the airspace,
+     * distances along the track line [m].
+     */
+    std::vector<std::pair<double, double>> intervals;
+  };
+
+private:
+  /**
+   * The start of the track line; invalid if there is none.
+   */
+  GeoPoint origin = GeoPoint::Invalid();
+
+  Angle bearing;
+
+  /**
+   * The distance between two samples [m].
+   */
+  double spacing = 0;
+
+  /**
+   * The distance of the cross-section start along the track line
+   * [m].
+   */
+  double offset = 0;
+
+  /**
+   * The length of the cross-section [m].
+   */
+  double range = 0;
+
+  /**
+   * The track line index of samples[0].
+   */
+  unsigned first_sample = 0;
+
+  /**
+   * The number of valid items in #samples.
+   */
+  unsigned n_samples = 0;
+
+  std::array<TerrainHeight, NUM_SAMPLES> samples;
+
+  const RasterMap *terrain_source = nullptr;
+  Serial terrain_serial;
+
+  std::vector<AirspaceSlice> airspaces;
+
+  /**
+   * The track line interval in which #airspaces have been collected;
+   * #airspace_end is negative if they need to be collected.
+   */
+  double airspace_begin = 0, airspace_end = -1;
+
+  const Airspaces *airspace_source = nullptr;
+  Serial airspace_serial;
+
+  /**
+   * The number of terrain lookups; for diagnostics and unit tests.
+   */
+  unsigned terrain_queries = 0;
+
+public:
+  /**
+   * Follow the given cross-section: continue the current track line
+   * if it is close enough, or start a new one.
+   */
+  void Update(const GeoPoint &start, const GeoVector &vec) noexcept;
+
+  /**
+   * Make sure all terrain samples of the current cross-section are
+   * available.  Samples from a previous call are reused unless the
+   * terrain has been modified since.
+   *
+   * @param map the terrain map; the caller must hold a lease on the
+   * #RasterTerrain which owns it
+   */
+  void UpdateTerrain(const RasterMap &map) noexcept;
+
+  /**
+   * Make sure all airspace intersections of the current
+   * cross-section are available.  They are collected for twice the
+   * range ahead, so this needs to query the airspace database only
+   * occasionally.
+   */
+  void UpdateAirspaces(const Airspaces &database) noexcept;
+
+  /**
+   * Forget everything.
+   */
+  void Clear() noexcept {
+    origin.SetInvalid();
+    n_samples = 0;
+    airspaces.clear();
+    airspace_end = -1;
+  }
+
+  const TerrainHeight *GetSamples() const noexcept {
+    return samples.data();
+  }
+
+  /**
+   * The distance of the first sample from the cross-section start;
+   * this is zero or negative.
+   */
+  double GetFirstSampleDistance() const noexcept {
+    return first_sample * spacing - offset;
+  }
+
+  double GetSpacing() const noexcept {
+    return spacing;
+  }
+
+  const std::vector<AirspaceSlice> &GetAirspaces() const noexcept {
+    return airspaces;
+  }
+
+  /**
+   * Convert a track line distance (e.g. from
+   * AirspaceSlice::intervals) to a cross-section distance.
+   */
+  double ToCrossSectionDistance(double line_distance) const noexcept {
+    return line_distance - offset;
+  }
+
+  unsigned GetTerrainQueries() const noexcept {
+    return terrain_queries;
+  }
+
+private:
+  [[gnu::pure]]
+  GeoPoint GetLinePoint(double distance) const noexcept;
+
+  void StartLine(const GeoPoint &start, const GeoVector &vec) noexcept;
+};
+
+#endif
@@ -26,13 +26,13 @@
 #include "Renderer/GradientRenderer.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "Look/CrossSectionLook.hpp"
-#include "Terrain/RasterTerrain.hpp"
 #include "MapSettings.hpp"
 #include "Units/Units.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Engine/GlideSolvers/GlideState.hpp"
 #include "Engine/GlideSolvers/MacCready.hpp"
+#include "Terrain/RasterTerrain.hpp"
 #include "Language/Language.hpp"
 
 CrossSectionRenderer::CrossSectionRenderer(const CrossSectionLook &_look,
@@ -89,16 +89,19 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.ScaleYFromValue(hmin);
   chart.ScaleYFromValue(hmax);
 
-  TerrainHeight elevations[NUM_SLICES];
-  UpdateTerrain(elevations);
+  profile.Update(start, vec);
 
   if (airspace_database != nullptr) {
+    profile.UpdateAirspaces(*airspace_database);
+
     const AircraftState aircraft = ToAircraftState(Basic(), Calculated());
-    airspace_renderer.Draw(canvas, chart, *airspace_database, start, vec,
-                           aircraft);
+    airspace_renderer.Draw(canvas, chart, profile, aircraft);
   }
 
-  terrain_renderer.Draw(canvas, chart, elevations);
+  if (terrain != nullptr) {
+    profile.UpdateTerrain(RasterTerrain::Lease(*terrain));
+    terrain_renderer.Draw(canvas, chart, profile);
+  }
   PaintWorking(chart);
   PaintGlide(chart);
   PaintAircraft(canvas, chart, rc);
@@ -111,26 +114,6 @@ CrossSectionRenderer::Paint(Canvas &canvas, const PixelRect rc) const
   chart.Finish();
 }
 
-void
-CrossSectionRenderer::UpdateTerrain(TerrainHeight *elevations) const
-{
-  if (terrain == NULL) {
-    const auto invalid = TerrainHeight::Invalid();
-    std::fill_n(elevations, NUM_SLICES, invalid);
-    return;
-  }
-
-  const GeoPoint point_diff = vec.EndPoint(start) - start;
-
-  RasterTerrain::Lease map(*terrain);
-  for (unsigned i = 0; i < NUM_SLICES; ++i) {
-    const auto slice_distance_factor = double(i) / (NUM_SLICES - 1);
-    const GeoPoint slice_point = start + point_diff * slice_distance_factor;
-
-    elevations[i] = map->GetHeight(slice_point);
-  }
-}
-
 void
 CrossSectionRenderer::PaintGlide(ChartRenderer &chart) const
 {
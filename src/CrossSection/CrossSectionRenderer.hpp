@@ -27,6 +27,7 @@
 #include "Blackboard/BaseBlackboard.hpp"
 #include "TerrainXSRenderer.hpp"
 #include "AirspaceXSRenderer.hpp"
+#include "CrossSectionProfile.hpp"
 #include "Engine/GlideSolvers/GlideSettings.hpp"
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 
@@ -48,7 +49,7 @@ class CrossSectionRenderer :
   public BaseBlackboard
 {
 public:
-  static constexpr unsigned NUM_SLICES = 64;
+  static constexpr unsigned NUM_SLICES = CrossSectionProfile::NUM_SLICES;
   const bool inverse;
 
 protected:
@@ -72,6 +73,12 @@ protected:
   /** Range and direction of the CrossSection */
   GeoVector vec{50000, Angle::Zero()};
 
+  /**
+   * Terrain samples and airspace intersections, reused between
+   * repaints while the aircraft keeps flying along the same line.
+   */
+  mutable CrossSectionProfile profile;
+
 public:
   /**
    * Constructor. Initializes most class members.
@@ -140,7 +147,6 @@ public:
   }
 
 protected:
-  void UpdateTerrain(TerrainHeight *elevations) const;
 
   void PaintGlide(ChartRenderer &chart) const;
   void PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
@@ -22,19 +22,26 @@
 */
 
 #include "TerrainXSRenderer.hpp"
-#include "CrossSectionRenderer.hpp"
+#include "CrossSectionProfile.hpp"
 #include "Renderer/ChartRenderer.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "Look/CrossSectionLook.hpp"
 #include "util/StaticArray.hxx"
 
+#include <algorithm>
+
 void
 TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
-                        const TerrainHeight *elevations) const
+                        const CrossSectionProfile &profile) const
 {
+  static constexpr unsigned n = CrossSectionProfile::NUM_SAMPLES;
+
   const auto max_distance = chart.GetXMax();
+  const TerrainHeight *elevations = profile.GetSamples();
+  const double first_distance = profile.GetFirstSampleDistance();
+  const double spacing = profile.GetSpacing();
 
-  StaticArray<BulkPixelPoint, CrossSectionRenderer::NUM_SLICES + 2> points;
+  StaticArray<BulkPixelPoint, n + 2> points;
 
   canvas.SelectNullPen();
 
@@ -42,10 +49,11 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
   double last_distance = 0;
   const double hmin = chart.GetYMin();
 
-  for (unsigned j = 0; j < CrossSectionRenderer::NUM_SLICES; ++j) {
-    const auto distance_factor =
-        double(j) / (CrossSectionRenderer::NUM_SLICES - 1);
-    const auto distance = distance_factor * max_distance;
+  for (unsigned j = 0; j < n; ++j) {
+    /* the samples are aligned to the track line; the outermost ones
+       may be slightly outside of the chart */
+    const auto distance = std::clamp(first_distance + j * spacing,
+                                     0., max_distance);
 
     const TerrainHeight e = elevations[j];
     const TerrainType type = e.GetType();
@@ -77,7 +85,7 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
         points.append() = chart.ToScreen(center_distance, hmin);
       }
 
-      if (j + 1 == CrossSectionRenderer::NUM_SLICES) {
+      if (j + 1 == n) {
         // Close and paint last polygon
         points.append() = chart.ToScreen(distance, h);
         points.append() = chart.ToScreen(distance, hmin);
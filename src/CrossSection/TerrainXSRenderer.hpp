@@ -28,6 +28,7 @@
 
 class Canvas;
 class ChartRenderer;
+class CrossSectionProfile;
 struct CrossSectionLook;
 struct BulkPixelPoint;
 
@@ -42,7 +43,7 @@ public:
   TerrainXSRenderer(const CrossSectionLook &_look): look(_look) {}
 
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const TerrainHeight *elevations) const;
+            const CrossSectionProfile &profile) const;
 
 private:
   void DrawPolygon(Canvas &canvas, TerrainType type,
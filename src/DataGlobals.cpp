@@ -24,6 +24,7 @@ Copyright_License {
 #include "DataGlobals.hpp"
 #include "Profile/Current.hpp"
 #include "Terrain/RasterTerrain.hpp"
+#include "Airspace/AsyncTerrainLoader.hpp"
 #include "Waypoint/WaypointGlue.hpp"
 #include "Weather/Rasp/RaspStore.hpp"
 #include "MapWindow/GlueMapWindow.hpp"
@@ -46,6 +47,10 @@ DataGlobals::UnsetTerrain() noexcept
   main_window.SetTerrain(nullptr);
   glide_computer->SetTerrain(nullptr);
 
+  /* the airspace terrain job reads the old terrain object */
+  delete airspace_terrain_loader;
+  airspace_terrain_loader = nullptr;
+
   delete terrain;
   terrain = nullptr;
 }
@@ -61,6 +66,8 @@ DataGlobals::SetTerrain(std::unique_ptr<RasterTerrain> _terrain) noexcept
   main_window.SetTerrain(terrain);
   glide_computer->SetTerrain(terrain);
 
+  main_window.LoadAirspaceTerrain();
+
   /* re-create the bottom widget if it was deleted by
      UnsetTerrain() */
   PageActions::Update();
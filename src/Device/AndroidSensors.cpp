@@ -413,14 +413,14 @@ DeviceDescriptor::OnGliderLinkTraffic(GliderLinkId id, const char *callsign,
 
   GliderLinkTraffic *traffic = traffic_list.FindTraffic(id);
   if (traffic == nullptr) {
-    traffic = traffic_list.AllocateTraffic();
+    traffic = traffic_list.AllocateTraffic(id, location,
+                                           basic.location_available
+                                           ? basic.location
+                                           : GeoPoint::Invalid());
     if (traffic == nullptr)
       // no more slots available
       return;
 
-    traffic->Clear();
-    traffic->id = id;
-
     traffic_list.new_traffic.Update(basic.clock);
   }
 
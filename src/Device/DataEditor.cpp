@@ -32,5 +32,6 @@ DeviceDataEditor::DeviceDataEditor(DeviceBlackboard &_blackboard,
 void
 DeviceDataEditor::Commit() const noexcept
 {
+  blackboard.MarkReceived();
   blackboard.ScheduleMerge();
 }
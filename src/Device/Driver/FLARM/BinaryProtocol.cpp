@@ -24,6 +24,7 @@ Copyright_License {
 #include "Device.hpp"
 #include "CRC16.hpp"
 #include "Device/Port/Port.hpp"
+#include "Device/Error.hpp"
 #include "time/TimeoutClock.hpp"
 
 gcc_pure
@@ -293,4 +294,93 @@ FlarmDevice::BinaryReset(OperationEnvironment &env,
   // Send request and wait for positive answer
   SendStartByte();
   SendFrameHeader(header, env, timeout.GetRemainingOrZero());
+
+  if (old_baud_rate != 0) {
+    /* the FLARM falls back to its configured baud rate when it
+       leaves binary mode */
+    port.Drain();
+    port.SetBaudrate(old_baud_rate);
+    old_baud_rate = 0;
+  }
+}
+
+/**
+ * Convert a baud rate to the MT_SETBAUDRATE payload value.
+ *
+ * @return the code or -1 if the FLARM does not support this baud
+ * rate
+ */
+static constexpr int
+BaudRateToCode(unsigned baud_rate) noexcept
+{
+  switch (baud_rate) {
+  case 4800:
+    return 0;
+
+  case 9600:
+    return 1;
+
+  case 19200:
+    return 2;
+
+  case 38400:
+    return 4;
+
+  case 57600:
+    return 5;
+
+  case 115200:
+    return 6;
+
+  case 230400:
+    return 7;
+
+  default:
+    return -1;
+  }
+}
+
+bool
+FlarmDevice::BinarySetBaudRate(OperationEnvironment &env)
+{
+  assert(mode == Mode::BINARY);
+  assert(bulk_baud_rate != 0);
+  assert(old_baud_rate == 0);
+
+  const int code = BaudRateToCode(bulk_baud_rate);
+  const unsigned current_baud_rate = port.GetBaudrate();
+  if (code < 0 || current_baud_rate == 0 ||
+      current_baud_rate == bulk_baud_rate)
+    return false;
+
+  const uint8_t data[1] = { (uint8_t)code };
+  FLARM::FrameHeader header = PrepareFrameHeader(FLARM::MT_SETBAUDRATE,
+                                                 data, sizeof(data));
+
+  SendStartByte();
+  SendFrameHeader(header, env, std::chrono::seconds(1));
+  SendEscaped(data, sizeof(data), env, std::chrono::seconds(1));
+
+  // The FLARM sends the ACK at the old baud rate and switches afterwards
+  if (!WaitForACK(header.sequence_number, env, std::chrono::seconds(1)))
+    return false;
+
+  port.Drain();
+  port.SetBaudrate(bulk_baud_rate);
+
+  for (unsigned i = 0; i < 3; ++i) {
+    try {
+      if (BinaryPing(env, std::chrono::milliseconds(500))) {
+        old_baud_rate = current_baud_rate;
+        return true;
+      }
+    } catch (const DeviceTimeout &) {
+    }
+  }
+
+  /* the FLARM does not talk to us at the new baud rate; go back
+     and let the caller re-check the connection */
+  port.SetBaudrate(current_baud_rate);
+  mode = Mode::UNKNOWN;
+  return false;
 }
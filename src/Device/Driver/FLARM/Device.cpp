@@ -35,6 +35,13 @@ void
 FlarmDevice::LinkTimeout()
 {
   mode = Mode::UNKNOWN;
+
+  if (old_baud_rate != 0) {
+    /* the FLARM has left binary mode and uses its configured baud
+       rate again */
+    port.SetBaudrate(old_baud_rate);
+    old_baud_rate = 0;
+  }
 }
 
 bool
@@ -31,11 +31,14 @@ Copyright_License {
 #include "Device/Driver.hpp"
 #include "Device/SettingsMap.hpp"
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
 
 class Port;
+class BufferedOutputStream;
 struct Declaration;
 class OperationEnvironment;
 class RecordedFlightList;
@@ -53,6 +56,24 @@ class FlarmDevice: public AbstractDevice
 
   Port &port;
 
+  /**
+   * The baud rate which is negotiated with MT_SETBAUDRATE for binary
+   * transfers; 0 means don't change the baud rate.
+   */
+  const unsigned bulk_baud_rate;
+
+  /**
+   * The port's baud rate before switching to #bulk_baud_rate; 0 if
+   * it has not been switched.
+   */
+  unsigned old_baud_rate = 0;
+
+  /**
+   * The number of MT_GETIGCDATA requests which are sent without
+   * waiting for the response.
+   */
+  unsigned download_window = 4;
+
   Mode mode = Mode::UNKNOWN;
 
   uint16_t sequence_number = 0;
@@ -63,8 +84,17 @@ class FlarmDevice: public AbstractDevice
   DeviceSettingsMap<std::string> settings;
 
 public:
-  FlarmDevice(Port &_port)
-    :port(_port) {}
+  explicit FlarmDevice(Port &_port, unsigned _bulk_baud_rate=0)
+    :port(_port), bulk_baud_rate(_bulk_baud_rate) {}
+
+  /**
+   * Set the number of MT_GETIGCDATA requests to be kept in flight
+   * while downloading a flight.  1 disables pipelining.
+   */
+  void SetDownloadWindow(unsigned n) noexcept {
+    assert(n > 0);
+    download_window = n;
+  }
 
   /**
    * Write a setting to the FLARM.
@@ -259,10 +289,22 @@ private:
 
   /**
    * "Resets the device. The only way to resume normal operation."
+   *
+   * This also restores the port's baud rate if it was switched by
+   * BinarySetBaudRate().
    */
   void BinaryReset(OperationEnvironment &env,
                    std::chrono::steady_clock::duration timeout);
 
+  /**
+   * Ask the FLARM to switch to #bulk_baud_rate for the rest of the
+   * binary session and switch the port.  If the FLARM does not
+   * respond at the new baud rate, the old one is restored.
+   *
+   * @return true if the baud rate was switched
+   */
+  bool BinarySetBaudRate(OperationEnvironment &env);
+
   /**
    * Sends a SelectRecord message to the Flarm
    * @param record_number Number of the record
@@ -281,11 +323,20 @@ private:
 
   /**
    * Sends GetIGCData messages to the Flarm and downloads the currently
-   * selected flight
-   * @param path Path to the IGC file to write into
+   * selected flight.  Up to #download_window requests are kept in
+   * flight.
+   *
+   * Throws on error (e.g. DeviceTimeout).
+   *
+   * @param os the stream to write the IGC data to
+   * @param position the number of bytes which have already been
+   * written to #os by a previous (interrupted) attempt; these are
+   * skipped, and the value is updated with the new total
+   * @param window the maximum number of requests in flight
    * @return True if received and written successfully, otherwise False
    */
-  bool DownloadFlight(Path path, OperationEnvironment &env);
+  bool DownloadFlight(BufferedOutputStream &os, std::size_t &position,
+                      unsigned window, OperationEnvironment &env);
 
 public:
   /**
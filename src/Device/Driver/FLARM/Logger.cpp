@@ -27,7 +27,10 @@
 #include "io/BufferedOutputStream.hxx"
 #include "system/Path.hpp"
 #include "Operation/Operation.hpp"
+#include "Device/Port/Port.hpp"
+#include "Device/Error.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -301,25 +304,52 @@ FlarmDevice::ReadFlightList(RecordedFlightList &flight_list,
   return true;
 }
 
+/**
+ * The maximum value for FlarmDevice::download_window.
+ */
+static constexpr unsigned MAX_DOWNLOAD_WINDOW = 16;
+
+/**
+ * How often shall a download be resumed after a transfer error?
+ */
+static constexpr unsigned MAX_RESUME_ATTEMPTS = 3;
+
 bool
-FlarmDevice::DownloadFlight(Path path, OperationEnvironment &env)
+FlarmDevice::DownloadFlight(BufferedOutputStream &os, std::size_t &position,
+                            unsigned window, OperationEnvironment &env)
 {
-  FileOutputStream fos(path);
-  BufferedOutputStream os(fos);
+  window = std::clamp(window, 1u, MAX_DOWNLOAD_WINDOW);
+
+  // The sequence numbers of the requests in flight, oldest first
+  uint16_t in_flight[MAX_DOWNLOAD_WINDOW];
+  unsigned n_in_flight = 0;
+
+  // The number of IGC bytes received in this attempt
+  std::size_t offset = 0;
+
+  AllocatedArray<uint8_t> data;
 
   env.SetProgressRange(100);
   while (true) {
-    // Create header for getting IGC file data
-    FLARM::FrameHeader header = PrepareFrameHeader(FLARM::MT_GETIGCDATA);
+    // Keep the pipeline full; the FLARM answers all requests in order
+    while (n_in_flight < window) {
+      // Create header for getting IGC file data
+      FLARM::FrameHeader header = PrepareFrameHeader(FLARM::MT_GETIGCDATA);
+
+      // Send request
+      SendStartByte();
+      SendFrameHeader(header, env, std::chrono::seconds(1));
 
-    // Send request
-    SendStartByte();
-    SendFrameHeader(header, env, std::chrono::seconds(1));
+      in_flight[n_in_flight++] = header.sequence_number;
+    }
+
+    const uint16_t sequence_number = in_flight[0];
+    std::copy(in_flight + 1, in_flight + n_in_flight, in_flight);
+    --n_in_flight;
 
     // Wait for an answer and save the payload for further processing
-    AllocatedArray<uint8_t> data;
     uint16_t length;
-    bool ack = WaitForACKOrNACK(header.sequence_number, data,
+    bool ack = WaitForACKOrNACK(sequence_number, data,
                                 length, env, std::chrono::seconds(10)) == FLARM::MT_ACK;
 
     // If no ACK was received
@@ -332,21 +362,33 @@ FlarmDevice::DownloadFlight(Path path, OperationEnvironment &env)
     uint8_t progress = *(data.begin() + 2);
     env.SetProgressPosition(std::min((unsigned)progress, 100u));
 
-    const char *last_char = (const char *)data.end() - 1;
+    const char *last_char = (const char *)data.begin() + 3 + length - 1;
     bool is_last_packet = (*last_char == 0x1A);
     if (is_last_packet)
       length--;
 
-    // Read IGC data
+    // Write the IGC data which was not already written by a previous attempt
     const char *igc_data = (const char *)data.begin() + 3;
-    os.Write(igc_data, length);
+    if (offset + length > position) {
+      const std::size_t skip = position > offset ? position - offset : 0;
+      os.Write(igc_data + skip, length - skip);
+      position = offset + length;
+    }
+
+    offset += length;
 
     if (is_last_packet)
       break;
   }
 
-  os.Flush();
-  fos.Commit();
+  // Consume the answers to the surplus requests
+  for (unsigned i = 0; i < n_in_flight; ++i) {
+    try {
+      WaitForACKOrNACK(in_flight[i], env, std::chrono::milliseconds(500));
+    } catch (const DeviceTimeout &) {
+      break;
+    }
+  }
 
   return true;
 }
@@ -356,24 +398,52 @@ bool
 FlarmDevice::DownloadFlight(const RecordedFlightInfo &flight,
                             Path path, OperationEnvironment &env)
 {
-  if (!BinaryMode(env))
-    return false;
+  FileOutputStream fos(path);
+  BufferedOutputStream os(fos);
 
-  FLARM::MessageType ack_result = SelectFlight(flight.internal.flarm, env);
+  /* the number of bytes written so far; after a transfer error, the
+     FLARM sends the file from the beginning, and these bytes are
+     skipped */
+  std::size_t position = 0;
 
-  // If no ACK was received -> cancel
-  if (ack_result != FLARM::MT_ACK)
-    return false;
+  unsigned window = download_window;
 
-  try {
-    if (DownloadFlight(path, env))
-      return true;
-  } catch (...) {
-    mode = Mode::UNKNOWN;
-    throw;
-  }
+  for (unsigned attempt = 0;; ++attempt) {
+    if (!BinaryMode(env))
+      return false;
+
+    FLARM::MessageType ack_result = SelectFlight(flight.internal.flarm, env);
 
-  mode = Mode::UNKNOWN;
+    // If no ACK was received -> cancel
+    if (ack_result != FLARM::MT_ACK)
+      return false;
 
-  return false;
+    try {
+      if (DownloadFlight(os, position, window, env)) {
+        os.Flush();
+        fos.Commit();
+        return true;
+      }
+    } catch (const DeviceTimeout &) {
+      if (attempt >= MAX_RESUME_ATTEMPTS) {
+        mode = Mode::UNKNOWN;
+        throw;
+      }
+    } catch (...) {
+      mode = Mode::UNKNOWN;
+      throw;
+    }
+
+    if (attempt >= MAX_RESUME_ATTEMPTS) {
+      mode = Mode::UNKNOWN;
+      return false;
+    }
+
+    /* the link has hiccuped: discard everything which is still in
+       transit, check the connection and continue without pipelining */
+    port.FullFlush(env, std::chrono::milliseconds(200),
+                   std::chrono::seconds(2));
+    mode = Mode::UNKNOWN;
+    window = 1;
+  }
 }
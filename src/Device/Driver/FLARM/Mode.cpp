@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Device.hpp"
 #include "Device/Port/Port.hpp"
+#include "Device/Error.hpp"
 #include "Operation/Operation.hpp"
 
 bool
@@ -81,13 +82,32 @@ FlarmDevice::BinaryMode(OperationEnvironment &env)
   // of time (around 1.5 sec). Due to that it is recommended to issue new pings
   // for a certain time until the ping is ACKed properly or a timeout occurs.
   for (unsigned i = 0; i < 10; ++i) {
-    if (BinaryPing(env, std::chrono::milliseconds(500))) {
-      // We are now in binary mode and have verified that with a binary ping
-
-      // Remember that we should now be in binary mode (for further assert() calls)
-      mode = Mode::BINARY;
-      return true;
+    try {
+      if (!BinaryPing(env, std::chrono::milliseconds(500)))
+        continue;
+    } catch (const DeviceTimeout &) {
+      continue;
     }
+
+    // We are now in binary mode and have verified that with a binary ping
+
+    // Remember that we should now be in binary mode (for further assert() calls)
+    mode = Mode::BINARY;
+
+    if (bulk_baud_rate != 0 && old_baud_rate == 0 &&
+        !BinarySetBaudRate(env) && mode != Mode::BINARY)
+      /* the FLARM got lost while switching the baud rate */
+      return false;
+
+    return true;
+  }
+
+  if (old_baud_rate != 0) {
+    /* the FLARM may have left binary mode and fallen back to its
+       configured baud rate; try again with that one */
+    port.SetBaudrate(old_baud_rate);
+    old_baud_rate = 0;
+    return BinaryMode(env);
   }
 
   // Apparently the switch to binary mode didn't work
@@ -27,6 +27,7 @@ Copyright_License {
 #include "FLARM/Version.hpp"
 #include "FLARM/Status.hpp"
 #include "FLARM/List.hpp"
+#include "FLARM/TrafficStore.hpp"
 #include "util/Macros.hpp"
 #include "util/StringAPI.hxx"
 
@@ -104,7 +105,8 @@ ReadBearing(NMEAInputLine &line, Angle &value_r)
 }
 
 void
-ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
+ParsePFLAA(NMEAInputLine &line, TrafficStore &store, TrafficList &flarm,
+           TimeStamp clock) noexcept
 {
   flarm.modified.Update(clock);
 
@@ -179,21 +181,11 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
   else
     traffic.type = (FlarmTraffic::AircraftType)type;
 
-  FlarmTraffic *flarm_slot = flarm.FindTraffic(traffic.id);
-  if (flarm_slot == nullptr) {
-    flarm_slot = flarm.AllocateTraffic();
-    if (flarm_slot == nullptr)
-      // no more slots available
-      return;
+  const bool is_new = store.Update(traffic, clock);
 
-    flarm_slot->Clear();
-    flarm_slot->id = traffic.id;
+  store.Expire(clock);
+  store.Publish(flarm);
 
+  if (is_new && flarm.FindTraffic(traffic.id) != nullptr)
     flarm.new_traffic.Update(clock);
-  }
-
-  // set time of fix to current time
-  flarm_slot->valid.Update(clock);
-
-  flarm_slot->Update(traffic);
 }
@@ -30,6 +30,7 @@ struct FlarmError;
 struct FlarmVersion;
 struct FlarmStatus;
 struct TrafficList;
+class TrafficStore;
 
 /**
  * Parses a PFLAE sentence (self-test results).
@@ -58,10 +59,14 @@ ParsePFLAU(NMEAInputLine &line, FlarmStatus &flarm, TimeStamp clock) noexcept;
  * Parses a PFLAA sentence
  * (Data on other moving objects around)
  *
+ * The target is added to the #TrafficStore, and then the most
+ * important targets of the store are published to the #TrafficList.
+ *
  * @param line A NMEAInputLine instance that can be used for parsing
  * @see http://flarm.com/support/manual/FLARM_DataportManual_v5.00E.pdf
  */
 void
-ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept;
+ParsePFLAA(NMEAInputLine &line, TrafficStore &store, TrafficList &flarm,
+           TimeStamp clock) noexcept;
 
 #endif
@@ -43,6 +43,7 @@ NMEAParser::Reset()
   real = true;
   use_geoid = true;
   last_time = {};
+  flarm_traffic.Clear();
 }
 
 bool
@@ -99,7 +100,7 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
     }
 
     if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
+      ParsePFLAA(line, flarm_traffic, info.flarm.traffic, info.clock);
       return true;
     }
 
@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_DEVICE_PARSER_HPP
 
 #include "time/Stamp.hpp"
+#include "FLARM/TrafficStore.hpp"
 
 struct NMEAInfo;
 class NMEAInputLine;
@@ -36,6 +37,12 @@ class NMEAParser
 {
   TimeStamp last_time;
 
+  /**
+   * All targets received in PFLAA sentences; only the most important
+   * ones are published to NMEAInfo::flarm.
+   */
+  TrafficStore flarm_traffic;
+
 public:
   bool real;
 
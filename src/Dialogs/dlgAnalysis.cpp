@@ -188,7 +188,8 @@ protected:
     chart.MoveAndShow(layout.main);
 
     Update();
-    update_timer.Schedule(std::chrono::milliseconds(2500));
+    update_timer.Schedule(std::chrono::milliseconds(2500),
+                          std::chrono::milliseconds(500));
   }
 
   void Hide() noexcept override {
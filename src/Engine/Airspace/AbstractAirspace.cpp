@@ -57,6 +57,13 @@ AbstractAirspace::SetGroundLevel(const double alt) noexcept
   altitude_top.SetGroundLevel(alt);
 }
 
+void
+AbstractAirspace::SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) noexcept
+{
+  altitude_base.SetTerrainEnvelope(envelope);
+  altitude_top.SetTerrainEnvelope(envelope);
+}
+
 void
 AbstractAirspace::SetFlightLevel(const AtmosphericPressure press) noexcept
 {
@@ -182,6 +182,12 @@ public:
    */
   void SetGroundLevel(double alt) noexcept;
 
+  /**
+   * Set the terrain envelope for AGL-referenced airspace altitudes
+   * (replaces SetGroundLevel()).
+   */
+  void SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) noexcept;
+
   /**
    * Is it necessary to call SetGroundLevel() for this AbstractAirspace?
    */
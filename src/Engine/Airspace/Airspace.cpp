@@ -62,6 +62,13 @@ Airspace::SetGroundLevel(const double alt) const noexcept
   airspace->SetGroundLevel(alt);
 }
 
+void
+Airspace::SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) const noexcept
+{
+  assert(airspace != nullptr);
+  airspace->SetTerrainEnvelope(envelope);
+}
+
 bool
 Airspace::NeedGroundLevel() const noexcept
 {
@@ -33,6 +33,7 @@ struct GeoPoint;
 struct AircraftState;
 class AtmosphericPressure;
 class AbstractAirspace;
+struct AirspaceTerrainEnvelope;
 class AirspaceActivity;
 class AirspaceIntersectionVector;
 class FlatProjection;
@@ -118,6 +119,11 @@ public:
    */
   void SetGroundLevel(double alt) const noexcept;
 
+  /**
+   * Set the terrain envelope for AGL-referenced airspace altitudes
+   */
+  void SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) const noexcept;
+
   /**
    * Is it necessary to call SetGroundLevel() for this AbstractAirspace?
    */
@@ -24,6 +24,8 @@
 #include "Atmosphere/Pressure.hpp"
 #include "Navigation/Aircraft.hpp"
 
+#include <algorithm>
+
 void
 AirspaceAltitude::SetFlightLevel(const AtmosphericPressure press) noexcept
 {
@@ -39,6 +41,15 @@ AirspaceAltitude::SetGroundLevel(const double alt) noexcept
     altitude = altitude_above_terrain + alt;
 }
 
+void
+AirspaceAltitude::SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) noexcept
+{
+  if (reference == AltitudeReference::AGL) {
+    terrain = envelope;
+    altitude = altitude_above_terrain + envelope.center;
+  }
+}
+
 bool
 AirspaceAltitude::IsAbove(const AltitudeState &state,
                           const double margin) const noexcept
@@ -60,8 +71,33 @@ AirspaceAltitude::IsBelow(const AltitudeState &state,
 double
 AirspaceAltitude::GetAltitude(const AltitudeState &state) const noexcept
 {
-  // TODO: check if state.altitude_agl is valid
-  return reference == AltitudeReference::AGL
-    ? altitude_above_terrain + (state.altitude - state.altitude_agl)
-    : altitude;
+  if (reference != AltitudeReference::AGL)
+    return altitude;
+
+  double terrain_altitude = state.altitude - state.altitude_agl;
+  if (terrain.IsDefined())
+    /* the terrain below the aircraft is meaningless if the aircraft
+       is not above this airspace, and if there is no terrain at the
+       aircraft's location, altitude_agl is 0 */
+    terrain_altitude = std::clamp(terrain_altitude,
+                                  double(terrain.minimum),
+                                  double(terrain.maximum));
+
+  return altitude_above_terrain + terrain_altitude;
+}
+
+double
+AirspaceAltitude::GetMinimumAltitude(const AltitudeState &state) const noexcept
+{
+  return HasTerrainEnvelope()
+    ? altitude_above_terrain + terrain.minimum
+    : GetAltitude(state);
+}
+
+double
+AirspaceAltitude::GetMaximumAltitude(const AltitudeState &state) const noexcept
+{
+  return HasTerrainEnvelope()
+    ? altitude_above_terrain + terrain.maximum
+    : GetAltitude(state);
 }
@@ -23,6 +23,7 @@
 #ifndef AIRSPACE_ALTITUDE_HPP
 #define AIRSPACE_ALTITUDE_HPP
 
+#include "AirspaceTerrainEnvelope.hpp"
 #include "Geo/AltitudeReference.hpp"
 
 class AtmosphericPressure;
@@ -56,11 +57,20 @@ struct AirspaceAltitude
    */
   double altitude_above_terrain;
 
+  /**
+   * The range of terrain heights below the airspace.
+   *
+   * Only valid if reference==AltitudeReference::AGL and
+   * SetTerrainEnvelope() has been called.
+   */
+  AirspaceTerrainEnvelope terrain;
+
   /** Type of airspace boundary */
   AltitudeReference reference;
 
   static constexpr AirspaceAltitude Invalid() noexcept {
     AirspaceAltitude a;
+    a.terrain = AirspaceTerrainEnvelope::Invalid();
     a.reference = AltitudeReference::NONE;
     return a;
   }
@@ -68,11 +78,28 @@ struct AirspaceAltitude
   /**
    * Get Altitude AMSL (m) resolved from type.
    * For AGL types, this assumes the terrain height
-   * is the terrain height at the aircraft.
+   * is the terrain height at the aircraft, limited to the terrain
+   * envelope of the airspace (if known).
    */
   [[gnu::pure]]
   double GetAltitude(const AltitudeState &state) const noexcept;
 
+  /**
+   * Get the lowest Altitude AMSL (m) this boundary has anywhere in
+   * the airspace.  Without a terrain envelope, this is the same as
+   * GetAltitude().
+   */
+  [[gnu::pure]]
+  double GetMinimumAltitude(const AltitudeState &state) const noexcept;
+
+  /**
+   * Get the highest Altitude AMSL (m) this boundary has anywhere in
+   * the airspace.  Without a terrain envelope, this is the same as
+   * GetAltitude().
+   */
+  [[gnu::pure]]
+  double GetMaximumAltitude(const AltitudeState &state) const noexcept;
+
   /** Is this altitude reference at or above the aircraft state? */
   [[gnu::pure]]
   bool IsAbove(const AltitudeState &state, double margin = 0) const noexcept;
@@ -100,6 +127,16 @@ struct AirspaceAltitude
    */
   void SetGroundLevel(double alt) noexcept;
 
+  /**
+   * Like SetGroundLevel(), but also remember the range of terrain
+   * heights below the airspace.
+   */
+  void SetTerrainEnvelope(const AirspaceTerrainEnvelope &envelope) noexcept;
+
+  constexpr bool HasTerrainEnvelope() const noexcept {
+    return reference == AltitudeReference::AGL && terrain.IsDefined();
+  }
+
   /**
    * Is it necessary to call SetGroundLevel() for this AirspaceAltitude?
    */
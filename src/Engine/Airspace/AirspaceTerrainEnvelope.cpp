@@ -0,0 +1,131 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "AirspaceTerrainEnvelope.hpp"
+#include "AbstractAirspace.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Geo/GeoBounds.hpp"
+
+#include <algorithm>
+
+/**
+ * The desired distance between two grid samples [m].
+ */
+static constexpr double SAMPLE_SPACING = 250;
+
+/**
+ * The maximum number of grid rows and columns.  This limits the cost
+ * of very large airspaces; their border vertices are sampled anyway.
+ */
+static constexpr unsigned MAX_GRID_SIZE = 32;
+
+/**
+ * The maximum number of border vertices to be sampled.
+ */
+static constexpr unsigned MAX_BORDER_SAMPLES = 64;
+
+static unsigned
+GridSize(double distance) noexcept
+{
+  return std::clamp(unsigned(distance / SAMPLE_SPACING) + 1,
+                    2u, MAX_GRID_SIZE);
+}
+
+class TerrainEnvelopeBuilder {
+  AirspaceTerrainEnvelope envelope = AirspaceTerrainEnvelope::Invalid();
+
+public:
+  void Add(TerrainHeight h) noexcept {
+    if (h.IsInvalid())
+      return;
+
+    const float value = h.GetValueOr0();
+    if (!envelope.IsDefined()) {
+      envelope.minimum = envelope.maximum = value;
+    } else {
+      envelope.minimum = std::min(envelope.minimum, value);
+      envelope.maximum = std::max(envelope.maximum, value);
+    }
+  }
+
+  AirspaceTerrainEnvelope Finish(TerrainHeight center) noexcept {
+    /* the center may be outside of the airspace (e.g. a crescent
+       shape), but it is the reference for SetGroundLevel() and must
+       be inside the envelope */
+    Add(center);
+
+    envelope.center = center.GetValueOr0();
+    if (!envelope.IsDefined())
+      /* no terrain at all: behave like the old ground level */
+      envelope.minimum = envelope.maximum = envelope.center;
+
+    return envelope;
+  }
+};
+
+AirspaceTerrainEnvelope
+ScanTerrainEnvelope(const RasterMap &map,
+                    const AbstractAirspace &airspace) noexcept
+{
+  TerrainEnvelopeBuilder builder;
+
+  /* the border of a circle is an enclosing polygon, its vertices
+     are outside of the airspace */
+  const auto &border = airspace.GetPoints();
+  if (airspace.GetShape() == AbstractAirspace::Shape::POLYGON &&
+      !border.empty()) {
+    const std::size_t step =
+      std::max<std::size_t>(border.size() / MAX_BORDER_SAMPLES, 1);
+    for (std::size_t i = 0; i < border.size(); i += step)
+      builder.Add(map.GetHeight(border[i].GetLocation()));
+  }
+
+  const GeoBounds bounds = airspace.GetGeoBounds();
+  if (bounds.IsValid() && !bounds.IsEmpty()) {
+    const unsigned n_rows = GridSize(bounds.GetGeoHeight());
+    const unsigned n_columns = GridSize(bounds.GetGeoWidth());
+
+    TerrainHeight row[MAX_GRID_SIZE];
+
+    for (unsigned y = 0; y < n_rows; ++y) {
+      const Angle latitude = bounds.GetSouth() +
+        bounds.GetHeight() * ((y + 0.5) / n_rows);
+      const GeoPoint west(bounds.GetWest(), latitude);
+      const GeoPoint east(bounds.GetEast(), latitude);
+
+      map.ScanLine(west, east, row, n_columns, false);
+
+      for (unsigned x = 0; x < n_columns; ++x) {
+        if (row[x].IsInvalid())
+          continue;
+
+        const GeoPoint p = west.Interpolate(east,
+                                            double(x) / (n_columns - 1));
+        if (airspace.Inside(p))
+          builder.Add(row[x]);
+      }
+    }
+  }
+
+  return builder.Finish(map.GetHeight(airspace.GetCenter()));
+}
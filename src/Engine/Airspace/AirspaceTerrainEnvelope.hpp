@@ -0,0 +1,63 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#pragma once
+
+class RasterMap;
+class AbstractAirspace;
+
+/**
+ * The range of terrain heights below an airspace.  It is used to
+ * resolve AGL-referenced airspace altitudes without knowing the
+ * terrain height at a particular location.
+ */
+struct AirspaceTerrainEnvelope {
+  /** Lowest terrain height (m AMSL) inside the airspace */
+  float minimum;
+
+  /** Highest terrain height (m AMSL) inside the airspace */
+  float maximum;
+
+  /** Terrain height (m AMSL) at the airspace center */
+  float center;
+
+  static constexpr AirspaceTerrainEnvelope Invalid() noexcept {
+    return {1, 0, 0};
+  }
+
+  constexpr bool IsDefined() const noexcept {
+    return minimum <= maximum;
+  }
+};
+
+/**
+ * Sample the terrain on a grid covering the airspace and at the
+ * vertices of a polygon airspace.  Each grid row is obtained with one
+ * RasterMap::ScanLine() call.
+ *
+ * The caller is responsible for locking the #RasterMap.
+ */
+[[gnu::pure]]
+AirspaceTerrainEnvelope
+ScanTerrainEnvelope(const RasterMap &map,
+                    const AbstractAirspace &airspace) noexcept;
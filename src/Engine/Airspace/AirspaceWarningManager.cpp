@@ -268,7 +268,9 @@ private:
     if (max_alt <= 0)
       return false;
 
-    return (airspace.GetBaseAltitude(state) > max_alt);
+    /* with a terrain envelope, an AGL base is checked at the lowest
+       terrain below the airspace, not at the aircraft's location */
+    return airspace.GetBase().GetMinimumAltitude(state) > max_alt;
   }
 };
 
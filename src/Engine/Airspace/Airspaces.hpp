@@ -114,6 +114,13 @@ public:
   /**
    * Set terrain altitude for all AGL-referenced airspace altitudes
    *
+   * This is expensive: for each AGL-referenced airspace, it scans
+   * the terrain envelope with ScanTerrainEnvelope() (up to 32 grid
+   * rows of 32 samples each plus up to 64 border vertices), and
+   * nothing is cached.  The user interface should use
+   * #AsyncAirspaceTerrainLoader instead, which does this in a
+   * separate thread and caches the results.
+   *
    * @param terrain Terrain model for lookup
    */
   void SetGroundLevels(const RasterTerrain &terrain) noexcept;
@@ -21,6 +21,7 @@
 */
 
 #include "Airspaces.hpp"
+#include "AirspaceTerrainEnvelope.hpp"
 #include "Terrain/RasterTerrain.hpp"
 
 void
@@ -31,9 +32,10 @@ Airspaces::SetGroundLevels(const RasterTerrain &terrain) noexcept
     if (!v.NeedGroundLevel())
       continue;
 
-    FlatGeoPoint c_flat = v.GetCenter();
-    GeoPoint g = task_projection.Unproject(c_flat);
-    v.SetGroundLevel(terrain.GetTerrainHeight(g).GetValueOr0());
+    /* lock the terrain for each airspace only, to give other
+       threads a chance */
+    RasterTerrain::Lease lease(terrain);
+    v.SetTerrainEnvelope(ScanTerrainEnvelope(lease, v.GetAirspace()));
   }
 }
 
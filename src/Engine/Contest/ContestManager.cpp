@@ -102,14 +102,18 @@ ContestManager::SetHandicap(unsigned handicap) noexcept
   weglide_or.SetHandicap(handicap);
 }
 
-static bool
-RunContest(AbstractContest &_contest,
-           ContestResult &result, ContestTraceVector &solution,
-           bool exhaustive) noexcept
+bool
+ContestManager::RunContest(AbstractContest &_contest,
+                           ContestResult &result,
+                           ContestTraceVector &solution,
+                           bool exhaustive) noexcept
 {
   // run solver, return immediately if further processing is required
   // by subsequent calls
   SolverResult r = _contest.Solve(exhaustive);
+  if (r == SolverResult::INCOMPLETE)
+    incomplete = true;
+
   if (r != SolverResult::VALID)
     return false;
 
@@ -129,6 +133,7 @@ bool
 ContestManager::UpdateIdle(bool exhaustive) noexcept
 {
   bool retval = false;
+  incomplete = false;
 
   switch (contest) {
   case Contest::NONE:
@@ -70,6 +70,12 @@ class ContestManager
   WeglideFAI weglide_fai;
   WeglideOR weglide_or;
 
+  /**
+   * Did one of the solvers stop in the last UpdateIdle() call before
+   * it was finished?
+   */
+  bool incomplete = false;
+
 public:
   /**
    * Base constructor.
@@ -114,6 +120,15 @@ public:
    */
   bool UpdateIdle(bool exhaustive = false) noexcept;
 
+  /**
+   * Has the last UpdateIdle() call left work for the next call?  This
+   * is the case when a solver has reached its iteration limit in
+   * incremental mode.
+   */
+  bool IsIncomplete() const noexcept {
+    return incomplete;
+  }
+
   bool SolveExhaustive() noexcept {
     return UpdateIdle(true);
   }
@@ -141,6 +156,11 @@ public:
   const ContestStatistics &GetStats() const noexcept {
     return stats;
   }
+
+private:
+  bool RunContest(AbstractContest &_contest,
+                  ContestResult &result, ContestTraceVector &solution,
+                  bool exhaustive) noexcept;
 };
 
 #endif
@@ -0,0 +1,70 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef AATISOLINE_CACHE_HPP
+#define AATISOLINE_CACHE_HPP
+
+#include "AATIsolineSegment.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <optional>
+
+/**
+ * Keeps the #AATIsolineSegment of the active #AATPoint between
+ * calculation cycles.  Constructing the segment searches for its end
+ * points, but the isoline only changes when the neighbouring task
+ * points or the target move, which happens rarely compared to the
+ * rate at which the target optimiser runs.
+ *
+ * The cache must be cleared whenever the task geometry (observation
+ * zones or projection) changes.
+ */
+class AATIsolineCache {
+  const AATPoint *point = nullptr;
+
+  /* the locations the cached segment was built for */
+  GeoPoint previous, next, target;
+
+  std::optional<AATIsolineSegment> segment;
+
+public:
+  void Clear() noexcept {
+    point = nullptr;
+    segment.reset();
+  }
+
+  /**
+   * Returns the isoline segment of the given #AATPoint, building it
+   * only if the cached one does not match.
+   */
+  const AATIsolineSegment &Get(const AATPoint &ap,
+                               const FlatProjection &projection) noexcept;
+
+  /**
+   * The target of the given #AATPoint has been moved along the
+   * cached isoline (e.g. by #TaskOptTarget); remember the new
+   * location, so the segment is still considered up to date.
+   */
+  void UpdateTarget(const AATPoint &ap) noexcept;
+};
+
+#endif
@@ -164,6 +164,7 @@ OrderedTask::UpdateGeometry()
 
   // projection can now be determined
   task_projection = TaskProjection(bounds);
+  isoline_cache.Clear();
 
   // update OZ's for items that depend on next-point geometry
   UpdateObservationZones(task_points, task_projection);
@@ -625,8 +626,12 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       // very nasty hack
       TaskOptTarget tot(tps, active_task_point, state,
                         task_behaviour.glide, glide_polar,
-                        *ap, task_projection, *taskpoint_start);
+                        *ap, isoline_cache.Get(*ap, task_projection),
+                        *taskpoint_start);
       tot.search(0.5);
+
+      /* the target has been moved along the same isoline */
+      isoline_cache.UpdateTarget(*ap);
     }
     retval = true;
   }
@@ -652,6 +657,9 @@ OrderedTask::UpdateSample(const AircraftState &state,
 void
 OrderedTask::SetNeighbours(unsigned position)
 {
+  /* the neighbours of an AAT point define its isoline */
+  isoline_cache.Clear();
+
   OrderedTaskPoint* prev = nullptr;
   OrderedTaskPoint* next = nullptr;
 
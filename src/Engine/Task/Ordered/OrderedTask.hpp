@@ -26,6 +26,7 @@
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Task/AbstractTask.hpp"
 #include "SmartTaskAdvance.hpp"
+#include "AATIsolineCache.hpp"
 #include "Waypoint/Ptr.hpp"
 #include "util/DereferenceIterator.hxx"
 #include "util/StaticString.hxx"
@@ -83,6 +84,12 @@ private:
 
   TaskProjection task_projection;
 
+  /**
+   * The isoline of the active AAT point, used by the target
+   * optimiser.
+   */
+  AATIsolineCache isoline_cache;
+
   GeoPoint last_min_location;
 
   TaskFactoryType factory_mode;
@@ -52,7 +52,7 @@ class TaskOptTarget final : public ZeroFinder
   /** Active AATPoint */
   AATPoint &tp_current;
   /** Isoline for active AATPoint target */
-  AATIsolineSegment iso;
+  const AATIsolineSegment &iso;
 
 public:
   /**
@@ -63,6 +63,7 @@ public:
    * @param _aircraft Current aircraft state
    * @param _gp Glide polar to copy for calculations
    * @param _tp_current Active AATPoint
+   * @param _iso Isoline segment of the active AATPoint's target
    * @param _ts StartPoint of task (to initiate scans)
    */
   template<typename T>
@@ -71,7 +72,7 @@ public:
                 const AircraftState &_aircraft,
                 const GlideSettings &settings, const GlidePolar &_gp,
                 AATPoint& _tp_current,
-                const FlatProjection &projection,
+                const AATIsolineSegment &_iso,
                 StartPoint &_ts) noexcept
     :ZeroFinder(0.02, 0.98, TOLERANCE),
      tm(tps.begin(), tps.end(), activeTaskPoint, settings, _gp,
@@ -80,7 +81,7 @@ public:
      aircraft(_aircraft),
      tp_start(_ts),
      tp_current(_tp_current),
-     iso(_tp_current, projection)
+     iso(_iso)
   {
   }
 
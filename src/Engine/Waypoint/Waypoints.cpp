@@ -102,19 +102,23 @@ Waypoints::Waypoints()
 void
 Waypoints::Optimise()
 {
-  if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
+  if (waypoint_tree.IsEmpty())
     return;
 
-  task_projection.Update();
+  if (!waypoint_tree.HaveBounds()) {
+    task_projection.Update();
 
-  for (auto &i : waypoint_tree) {
-    // TODO: eliminate this const_cast hack
-    Waypoint &w = const_cast<Waypoint &>(*i);
-    w.Project(task_projection);
+    for (auto &i : waypoint_tree) {
+      // TODO: eliminate this const_cast hack
+      Waypoint &w = const_cast<Waypoint &>(*i);
+      w.Project(task_projection);
+    }
+
+    waypoint_tree.Optimise();
   }
 
-  waypoint_tree.Optimise();
+  if (waypoint_index.IsEmpty())
+    waypoint_index.Build(waypoint_tree.begin(), waypoint_tree.end());
 }
 
 void
@@ -135,6 +139,7 @@ Waypoints::Append(WaypointPtr wp)
   task_projection.Scan(w.location);
   w.id = next_id++;
 
+  waypoint_index.Clear();
   waypoint_tree.Add(wp);
   name_tree.Add(wp);
 
@@ -148,8 +153,16 @@ Waypoints::GetNearest(const GeoPoint &loc, double range) const
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  if (!waypoint_index.IsEmpty()) {
+    const auto found =
+      waypoint_index.FindNearestIf({flat_location.x, flat_location.y}, mrange,
+                                   [](const WaypointPtr &){ return true; });
+    return found.first != nullptr ? *found.first : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const auto found = waypoint_tree.FindNearest(point, mrange);
 
   if (found.first == waypoint_tree.end())
@@ -178,12 +191,20 @@ Waypoints::GetNearestIf(const GeoPoint &loc, double range,
     return nullptr;
 
   const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
-  const auto found = waypoint_tree.FindNearestIf(point, mrange,
-                                                 [predicate](const WaypointPtr &ptr){
-                                                   return predicate(*ptr);
-                                                 });
+  const auto p = [predicate](const WaypointPtr &ptr){
+    return predicate(*ptr);
+  };
+
+  if (!waypoint_index.IsEmpty()) {
+    const auto found =
+      waypoint_index.FindNearestIf({flat_location.x, flat_location.y},
+                                   mrange, p);
+    return found.first != nullptr ? *found.first : nullptr;
+  }
+
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
+  const auto found = waypoint_tree.FindNearestIf(point, mrange, p);
 
   if (found.first == waypoint_tree.end())
     return nullptr;
@@ -247,20 +268,6 @@ Waypoints::LookupId(const unsigned id) const
   return nullptr;
 }
 
-void
-Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
-                            WaypointVisitor visitor) const
-{
-  if (IsEmpty())
-    return; // nothing to do
-
-  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
-  const WaypointTree::Point point(flat_location.x, flat_location.y);
-  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
-
-  waypoint_tree.VisitWithinRange(point, mrange, visitor);
-}
-
 void
 Waypoints::VisitNamePrefix(const TCHAR *prefix,
                            WaypointVisitor visitor) const
@@ -274,6 +281,7 @@ Waypoints::Clear()
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  waypoint_index.Clear();
   waypoint_tree.clear();
   next_id = 1;
 }
@@ -291,6 +299,7 @@ Waypoints::Erase(WaypointPtr &&wp)
   assert(f.first != waypoint_tree.end());
 
   name_tree.Remove(std::move(wp));
+  waypoint_index.Clear();
   waypoint_tree.erase(f.first);
   ++serial;
 }
@@ -305,6 +314,7 @@ Waypoints::EraseUserMarkers()
           home = nullptr;
 
         name_tree.Remove(wp);
+        waypoint_index.Clear();
         ++serial;
         return true;
       } else
@@ -332,6 +342,7 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement)
 
   WaypointPtr new_ptr(new Waypoint(std::move(replacement)));
   name_tree.Add(new_ptr);
+  waypoint_index.Clear();
 
   auto f = waypoint_tree.FindNearestIf(waypoint_tree.GetPosition(orig), 0,
                                        [&orig](const WaypointPtr &ptr){
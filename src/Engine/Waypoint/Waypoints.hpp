@@ -24,6 +24,7 @@
 
 #include "util/RadixTree.hpp"
 #include "util/QuadTree.hxx"
+#include "util/PackedPointIndex.hpp"
 #include "util/Serial.hpp"
 #include "Ptr.hpp"
 #include "Waypoint.hpp"
@@ -59,6 +60,11 @@ class Waypoints {
    */
   typedef QuadTree<WaypointPtr, WaypointAccessor> WaypointTree;
 
+  /**
+   * Type of the read-only index built by Optimise()
+   */
+  typedef PackedPointIndex<WaypointPtr, WaypointAccessor> WaypointIndex;
+
   class WaypointNameTree : public RadixTree<WaypointPtr> {
   public:
     WaypointPtr Get(const TCHAR *name) const;
@@ -77,6 +83,14 @@ class Waypoints {
   unsigned next_id;
 
   WaypointTree waypoint_tree;
+
+  /**
+   * A copy of #waypoint_tree optimised for spatial queries.  It is
+   * built by Optimise() and cleared by each modification; while it
+   * is empty, queries fall back to #waypoint_tree.
+   */
+  WaypointIndex waypoint_index;
+
   WaypointNameTree name_tree;
   TaskProjection task_projection;
 
@@ -171,6 +185,7 @@ public:
    * Prepare and enable the next Optimise() call.
    */
   void ScheduleOptimise() {
+    waypoint_index.Clear();
     waypoint_tree.Flatten();
     waypoint_tree.ClearBounds();
   }
@@ -294,10 +309,26 @@ public:
    *
    * @param loc Location from which to search
    * @param range Distance in meters of search radius
-   * @param visitor Visitor to be called on waypoints within range
+   * @param visitor Visitor to be called on waypoints within range;
+   * a function object accepting a "const WaypointPtr &"
    */
+  template<typename V>
   void VisitWithinRange(const GeoPoint &loc, double range,
-                        WaypointVisitor visitor) const;
+                        V &&visitor) const {
+    if (IsEmpty())
+      return; // nothing to do
+
+    const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+    const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+    if (!waypoint_index.IsEmpty())
+      waypoint_index.VisitWithinRange({flat_location.x, flat_location.y},
+                                      mrange, visitor);
+    else
+      waypoint_tree.VisitWithinRange(WaypointTree::Point(flat_location.x,
+                                                         flat_location.y),
+                                     mrange, visitor);
+  }
 
   /**
    * Call visitor function on waypoints with the specified name
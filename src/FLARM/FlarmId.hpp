@@ -65,6 +65,10 @@ public:
     return value < other.value;
   }
 
+  constexpr uint32_t Hash() const noexcept {
+    return value;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_FLARM_TRAFFIC_LIST_HPP
 
 #include "Traffic.hpp"
+#include "TrafficIdIndex.hpp"
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
@@ -35,7 +36,15 @@ Copyright_License {
  * FLARM.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The maximum number of targets.  This object is part of
+   * #NMEAInfo, which is copied on every blackboard update, so this
+   * is kept small.  OGN and ADS-B receivers connected to the FLARM
+   * port may deliver many more targets; all of them are kept in the
+   * parser's #TrafficStore, which publishes only the most important
+   * ones to this list.
+   */
+  static constexpr size_t MAX_COUNT = 32;
 
   /**
    * Time stamp of the latest modification to this object.
@@ -50,10 +59,17 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Maps #FlarmId to the position in #list.  Don't modify #list
+   * directly, or this index will become stale.
+   */
+  TrafficIdIndex<MAX_COUNT> index;
+
   void Clear() {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    index.Clear();
   }
 
   bool IsEmpty() const {
@@ -68,10 +84,9 @@ struct TrafficList {
     // Add unique traffic from 'add' list
     for (auto &traffic : add.list) {
       if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
-        if (new_traffic == nullptr)
-          return;
-        *new_traffic = traffic;
+        FlarmTraffic * new_traffic = AllocateTraffic(traffic);
+        if (new_traffic != nullptr)
+          *new_traffic = traffic;
       }
     }
   }
@@ -80,9 +95,16 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      index.Rebuild(list);
   }
 
   unsigned GetActiveTrafficCount() const {
@@ -96,11 +118,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(FlarmId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = index.Find(list, id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -110,11 +129,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   const FlarmTraffic *FindTraffic(FlarmId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = index.Find(list, id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -146,14 +162,39 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array for the id
+   * of the given (not yet stored) target.  If the array is full, the
+   * least important target is replaced, but only if the new one is
+   * more important (see FlarmTraffic::IsMoreImportantThan()).
    *
-   * @return the FLARM_TRAFFIC pointer, NULL if the array is full
+   * @return the FLARM_TRAFFIC pointer (cleared, with the id already
+   * set), NULL if the array is full and all targets are more
+   * important
    */
-  FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+  FlarmTraffic *AllocateTraffic(const FlarmTraffic &candidate) {
+    FlarmTraffic *traffic;
+
+    if (!list.full()) {
+      traffic = &list.append();
+      traffic->id = candidate.id;
+      index.Insert(candidate.id, list.size() - 1);
+    } else {
+      traffic = &list.front();
+      for (auto &i : list)
+        if (traffic->IsMoreImportantThan(i))
+          traffic = &i;
+
+      if (!candidate.IsMoreImportantThan(*traffic))
+        return nullptr;
+
+      /* evict the least important target; it is easier to rebuild
+         the index than to remove the old id from it */
+      traffic->id = candidate.id;
+      index.Rebuild(list);
+    }
+
+    traffic->Clear();
+    return traffic;
   }
 
   /**
@@ -165,6 +165,22 @@ struct FlarmTraffic {
     return Angle::FromXY(relative_north, relative_east);
   }
 
+  /**
+   * Is this target more important than the other one?  The higher
+   * alarm level wins; if both are equal, the closer target wins.
+   * This uses only the relative position, which is known before
+   * #FlarmComputer has calculated #distance.
+   */
+  [[gnu::pure]]
+  bool IsMoreImportantThan(const FlarmTraffic &other) const noexcept {
+    if (alarm_level != other.alarm_level)
+      return (unsigned)alarm_level > (unsigned)other.alarm_level;
+
+    return relative_north * relative_north + relative_east * relative_east <
+      other.relative_north * other.relative_north +
+      other.relative_east * other.relative_east;
+  }
+
   bool IsPowered() const {
     return type != AircraftType::GLIDER &&
            type != AircraftType::HANG_GLIDER &&
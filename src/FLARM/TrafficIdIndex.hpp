@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_ID_INDEX_HPP
+#define XCSOAR_FLARM_TRAFFIC_ID_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A hash index for a #TrivialArray of traffic objects which maps the
+ * id (any type with a Hash() method) to the array position.  It uses
+ * open addressing with linear probing and stores array positions
+ * instead of pointers, so it remains valid when the containing
+ * object is copied; like the array, it is a trivial type and must be
+ * initialised with Clear().
+ *
+ * Removing single entries is not supported; after removing items
+ * from the array (which moves other items), call Rebuild().
+ */
+template<std::size_t capacity>
+class TrafficIdIndex {
+  static constexpr std::size_t RoundUpPowerOfTwo(std::size_t n) noexcept {
+    std::size_t result = 1;
+    while (result < n)
+      result <<= 1;
+    return result;
+  }
+
+  /**
+   * Keep the load factor below 50%, so probe sequences remain
+   * short.
+   */
+  static constexpr std::size_t N_SLOTS = RoundUpPowerOfTwo(capacity * 2);
+
+  static_assert(capacity < 0xffff, "Capacity too large");
+
+  /**
+   * The array position plus one; zero means the slot is empty.
+   */
+  uint16_t slots[N_SLOTS];
+
+  template<typename I>
+  static constexpr std::size_t GetStartSlot(I id) noexcept {
+    /* Fibonacci hashing: traffic ids (e.g. ICAO addresses) are not
+       well distributed in the lower bits */
+    return (uint32_t(id.Hash() * 2654435761u) >> 16) & (N_SLOTS - 1);
+  }
+
+public:
+  void Clear() noexcept {
+    std::fill_n(slots, N_SLOTS, 0);
+  }
+
+  /**
+   * Look up an id.
+   *
+   * @param list the array which is indexed by this object
+   * @return the position in the array or -1 if not found
+   */
+  template<typename L, typename I>
+  [[gnu::pure]]
+  int Find(const L &list, I id) const noexcept {
+    for (std::size_t i = GetStartSlot(id);; i = (i + 1) & (N_SLOTS - 1)) {
+      const unsigned slot = slots[i];
+      if (slot == 0)
+        return -1;
+
+      if (list[slot - 1].id == id)
+        return slot - 1;
+    }
+  }
+
+  /**
+   * Add a new id which is not yet in the index.
+   */
+  template<typename I>
+  void Insert(I id, std::size_t position) noexcept {
+    std::size_t i = GetStartSlot(id);
+    while (slots[i] != 0)
+      i = (i + 1) & (N_SLOTS - 1);
+
+    slots[i] = position + 1;
+  }
+
+  /**
+   * Recreate the index from scratch.
+   */
+  template<typename L>
+  void Rebuild(const L &list) noexcept {
+    Clear();
+
+    for (std::size_t i = 0; i < list.size(); ++i)
+      Insert(list[i].id, i);
+  }
+};
+
+#endif
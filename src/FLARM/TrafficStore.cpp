@@ -0,0 +1,174 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TrafficStore.hpp"
+#include "List.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+TrafficStore::TrafficStore()
+{
+  /* allocate everything now, so Update() never needs to */
+  records.reserve(MAX_COUNT);
+  relative_north.reserve(MAX_COUNT);
+  relative_east.reserve(MAX_COUNT);
+  alarm_level.reserve(MAX_COUNT);
+  last_seen.reserve(MAX_COUNT);
+  rank.reserve(MAX_COUNT);
+  order.reserve(MAX_COUNT);
+
+  index.Clear();
+}
+
+void
+TrafficStore::Clear() noexcept
+{
+  records.clear();
+  relative_north.clear();
+  relative_east.clear();
+  alarm_level.clear();
+  last_seen.clear();
+  index.Clear();
+}
+
+inline void
+TrafficStore::Set(std::size_t i, const FlarmTraffic &traffic,
+                  TimeStamp clock) noexcept
+{
+  records[i].valid.Update(clock);
+  records[i].Update(traffic);
+
+  relative_north[i] = traffic.relative_north;
+  relative_east[i] = traffic.relative_east;
+  alarm_level[i] = (uint8_t)traffic.alarm_level;
+  last_seen[i] = clock;
+}
+
+inline void
+TrafficStore::QuickRemove(std::size_t i) noexcept
+{
+  const std::size_t last = records.size() - 1;
+  if (i != last) {
+    records[i] = records[last];
+    relative_north[i] = relative_north[last];
+    relative_east[i] = relative_east[last];
+    alarm_level[i] = alarm_level[last];
+    last_seen[i] = last_seen[last];
+  }
+
+  records.pop_back();
+  relative_north.pop_back();
+  relative_east.pop_back();
+  alarm_level.pop_back();
+  last_seen.pop_back();
+}
+
+void
+TrafficStore::UpdateRanks() noexcept
+{
+  const std::size_t n = records.size();
+  rank.resize(n);
+
+  const double *north = relative_north.data();
+  const double *east = relative_east.data();
+  const uint8_t *alarm = alarm_level.data();
+  double *r = rank.data();
+
+  for (std::size_t i = 0; i < n; ++i)
+    r[i] = Rank(north[i], east[i], alarm[i]);
+}
+
+bool
+TrafficStore::Update(const FlarmTraffic &traffic, TimeStamp clock) noexcept
+{
+  if (const int i = index.Find(records, traffic.id); i >= 0) {
+    Set(i, traffic, clock);
+    return false;
+  }
+
+  std::size_t i;
+  if (records.size() < MAX_COUNT) {
+    i = records.size();
+    records.emplace_back();
+    relative_north.emplace_back();
+    relative_east.emplace_back();
+    alarm_level.emplace_back();
+    last_seen.emplace_back();
+
+    records[i].id = traffic.id;
+    index.Insert(traffic.id, i);
+  } else {
+    UpdateRanks();
+    i = std::max_element(rank.begin(), rank.end()) - rank.begin();
+    if (Rank(traffic) >= rank[i])
+      return false;
+
+    /* replace the least important target; it is easier to rebuild
+       the index than to remove the old id from it */
+    records[i].id = traffic.id;
+    index.Rebuild(records);
+  }
+
+  records[i].Clear();
+  Set(i, traffic, clock);
+  return true;
+}
+
+void
+TrafficStore::Expire(TimeStamp clock) noexcept
+{
+  bool removed = false;
+  for (std::size_t i = records.size(); i-- > 0;) {
+    if (clock < last_seen[i] || /* time warp? */
+        clock - last_seen[i] > MAX_AGE) {
+      QuickRemove(i);
+      removed = true;
+    }
+  }
+
+  if (removed)
+    index.Rebuild(records);
+}
+
+void
+TrafficStore::Publish(TrafficList &list) noexcept
+{
+  list.list.clear();
+
+  UpdateRanks();
+
+  order.resize(records.size());
+  std::iota(order.begin(), order.end(), 0u);
+
+  const auto n = std::min(order.size(), TrafficList::MAX_COUNT);
+  std::partial_sort(order.begin(), order.begin() + n, order.end(),
+                    [this](unsigned a, unsigned b){
+                      return rank[a] < rank[b];
+                    });
+
+  for (std::size_t i = 0; i < n; ++i)
+    list.list.append(records[order[i]]);
+
+  list.index.Rebuild(list.list);
+}
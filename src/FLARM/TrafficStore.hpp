@@ -0,0 +1,174 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_STORE_HPP
+#define XCSOAR_FLARM_TRAFFIC_STORE_HPP
+
+#include "Traffic.hpp"
+#include "TrafficIdIndex.hpp"
+#include "time/Stamp.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+struct TrafficList;
+
+/**
+ * All traffic objects received from one FLARM, including those from
+ * OGN and ADS-B receivers which are connected to the FLARM port and
+ * may deliver hundreds of targets.
+ *
+ * Unlike #TrafficList, this object is not part of the blackboard and
+ * is never copied, so it can be large.  Publish() copies the most
+ * important targets to a #TrafficList.
+ *
+ * The attributes which are needed to rank and expire all targets are
+ * stored in separate arrays (struct of arrays), so the loops over
+ * them touch only a few cache lines and can be vectorised; the
+ * complete target data is stored in #FlarmTraffic records.
+ */
+class TrafficStore {
+public:
+  /**
+   * The maximum number of targets.  When the store is full, the
+   * least important target is replaced.
+   */
+  static constexpr std::size_t MAX_COUNT = 512;
+
+  /**
+   * Targets which have not been received for this duration are
+   * removed; this is the same as in FlarmTraffic::Refresh().
+   */
+  static constexpr std::chrono::seconds MAX_AGE{2};
+
+private:
+  /**
+   * Added to the rank of a target for each alarm level, so the alarm
+   * level is more important than the distance (which can be up to
+   * 1000 km).
+   */
+  static constexpr double ALARM_RANK = -1e12;
+
+  std::vector<FlarmTraffic> records;
+
+  /* the following columns are parallel to #records */
+
+  std::vector<double> relative_north, relative_east;
+  std::vector<uint8_t> alarm_level;
+  std::vector<TimeStamp> last_seen;
+
+  /**
+   * Scratch space for UpdateRanks(): the importance of each target,
+   * lower values are more important.
+   */
+  std::vector<double> rank;
+
+  /**
+   * Scratch space for Publish().
+   */
+  std::vector<unsigned> order;
+
+  /**
+   * Maps #FlarmId to the position in #records.
+   */
+  TrafficIdIndex<MAX_COUNT> index;
+
+public:
+  TrafficStore();
+
+  TrafficStore(const TrafficStore &) = delete;
+  TrafficStore &operator=(const TrafficStore &) = delete;
+
+  void Clear() noexcept;
+
+  bool IsEmpty() const noexcept {
+    return records.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return records.size();
+  }
+
+  /**
+   * Looks up a target.
+   *
+   * @return the FlarmTraffic pointer, nullptr if not found
+   */
+  [[gnu::pure]]
+  const FlarmTraffic *FindTraffic(FlarmId id) const noexcept {
+    const int i = index.Find(records, id);
+    return i >= 0 ? &records[i] : nullptr;
+  }
+
+  /**
+   * Adds a new target or updates an existing one.  If the store is
+   * full, the least important target is replaced, but only if the
+   * new one is more important (see
+   * FlarmTraffic::IsMoreImportantThan()).
+   *
+   * @param traffic the target parsed from a PFLAA sentence
+   * @return true if this is a new target which was added
+   */
+  bool Update(const FlarmTraffic &traffic, TimeStamp clock) noexcept;
+
+  /**
+   * Removes all targets which have not been received for #MAX_AGE.
+   */
+  void Expire(TimeStamp clock) noexcept;
+
+  /**
+   * Replaces the targets in the given list with the
+   * TrafficList::MAX_COUNT most important targets of this object,
+   * the most important one first.  The time stamps of the list are
+   * not modified.
+   */
+  void Publish(TrafficList &list) noexcept;
+
+private:
+  static constexpr double Rank(double north, double east,
+                               uint8_t alarm) noexcept {
+    return north * north + east * east + alarm * ALARM_RANK;
+  }
+
+  static constexpr double Rank(const FlarmTraffic &traffic) noexcept {
+    return Rank(traffic.relative_north, traffic.relative_east,
+                (uint8_t)traffic.alarm_level);
+  }
+
+  /**
+   * Calculate the #rank column.
+   */
+  void UpdateRanks() noexcept;
+
+  void Set(std::size_t i, const FlarmTraffic &traffic,
+           TimeStamp clock) noexcept;
+
+  /**
+   * Remove the target at the given position by moving the last one
+   * there.  The caller is responsible for rebuilding the #index.
+   */
+  void QuickRemove(std::size_t i) noexcept;
+};
+
+#endif
@@ -40,6 +40,18 @@ public:
   GeoClip(const GeoBounds &other)
     :GeoBounds(other), width(GetWidth()) {}
 
+  /**
+   * Check if the given bounds are completely inside the clip
+   * rectangle, i.e. a shape within them does not need to be clipped.
+   */
+  using GeoBounds::IsInside;
+
+  /**
+   * Check if the given bounds overlap the clip rectangle; if not, a
+   * shape within them is invisible.
+   */
+  using GeoBounds::Overlaps;
+
 protected:
   /**
    * Imports a longitude value.  To avoid wraparound bugs, all
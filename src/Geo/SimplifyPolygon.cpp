@@ -0,0 +1,124 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SimplifyPolygon.hpp"
+#include "GeoPoint.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct LocalPoint {
+  double x, y;
+};
+
+}
+
+/**
+ * The square of the distance between #p and the line segment from
+ * #a to #b.
+ */
+[[gnu::const]]
+static double
+SegmentDistanceSquared(LocalPoint p, LocalPoint a, LocalPoint b) noexcept
+{
+  const double dx = b.x - a.x, dy = b.y - a.y;
+  double px = p.x - a.x, py = p.y - a.y;
+
+  const double length_squared = dx * dx + dy * dy;
+  if (length_squared > 0) {
+    double t = (px * dx + py * dy) / length_squared;
+    if (t > 1)
+      t = 1;
+    if (t > 0) {
+      px -= t * dx;
+      py -= t * dy;
+    }
+  }
+
+  return px * px + py * py;
+}
+
+unsigned
+SimplifyPolygon(GeoPoint *points, unsigned n, Angle tolerance) noexcept
+{
+  if (n <= 3)
+    return n;
+
+  const GeoPoint origin = points[0];
+  const double x_scale = origin.latitude.cos();
+
+  std::vector<LocalPoint> local;
+  local.reserve(n);
+  for (unsigned i = 0; i < n; ++i)
+    local.push_back({
+        (points[i].longitude - origin.longitude).AsDelta().Radians() * x_scale,
+        (points[i].latitude - origin.latitude).Radians(),
+      });
+
+  const double tolerance_squared = tolerance.Radians() * tolerance.Radians();
+
+  std::vector<bool> keep(n, false);
+  keep.front() = keep.back() = true;
+
+  std::vector<std::pair<unsigned, unsigned>> stack;
+  stack.emplace_back(0, n - 1);
+
+  while (!stack.empty()) {
+    const auto [first, last] = stack.back();
+    stack.pop_back();
+
+    double max_distance = tolerance_squared;
+    unsigned max_index = 0;
+    for (unsigned i = first + 1; i < last; ++i) {
+      const double d = SegmentDistanceSquared(local[i],
+                                              local[first], local[last]);
+      if (d > max_distance) {
+        max_distance = d;
+        max_index = i;
+      }
+    }
+
+    if (max_index > 0) {
+      keep[max_index] = true;
+      stack.emplace_back(first, max_index);
+      stack.emplace_back(max_index, last);
+    }
+  }
+
+  unsigned count = 0;
+  for (unsigned i = 0; i < n; ++i)
+    if (keep[i])
+      ++count;
+
+  if (count < 3)
+    return n;
+
+  unsigned dest = 0;
+  for (unsigned i = 0; i < n; ++i)
+    if (keep[i])
+      points[dest++] = points[i];
+
+  return dest;
+}
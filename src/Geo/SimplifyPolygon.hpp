@@ -0,0 +1,48 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GEO_SIMPLIFY_POLYGON_HPP
+#define XCSOAR_GEO_SIMPLIFY_POLYGON_HPP
+
+struct GeoPoint;
+class Angle;
+
+/**
+ * Remove all vertices from a closed polygon which are closer than
+ * the given tolerance to the simplified outline (Douglas-Peucker).
+ * The remaining vertices are moved to the front of the array in
+ * their original order; the first and the last vertex are always
+ * kept.
+ *
+ * Distances are calculated in a local equirectangular projection,
+ * which is good enough for screen resolution tolerances.
+ *
+ * @param tolerance the maximum deviation as an angle on the FAI
+ * sphere
+ * @return the new number of vertices; if the simplified polygon
+ * would have less than 3 vertices, the polygon is left unmodified
+ */
+unsigned
+SimplifyPolygon(GeoPoint *points, unsigned n, Angle tolerance) noexcept;
+
+#endif
@@ -47,6 +47,10 @@ public:
   bool operator<(GliderLinkId other) const {
     return value < other.value;
   }
+
+  constexpr uint32_t Hash() const noexcept {
+    return value;
+  }
 };
 
 #endif
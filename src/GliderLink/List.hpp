@@ -25,9 +25,11 @@
 #define XCSOAR_GLIDER_LINK_TRAFFIC_LIST_HPP
 
 #include "Traffic.hpp"
+#include "FLARM/TrafficIdIndex.hpp"
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <limits>
 #include <type_traits>
 
 /**
@@ -35,7 +37,7 @@
  * GLIDER_LINK.
  */
 struct GliderLinkTrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  static constexpr size_t MAX_COUNT = 32;
 
   /**
    * When was the last new traffic received?
@@ -45,9 +47,16 @@ struct GliderLinkTrafficList {
   /** GliderLink traffic information */
   TrivialArray<GliderLinkTraffic, MAX_COUNT> list;
 
+  /**
+   * Maps #GliderLinkId to the position in #list.  Don't modify #list
+   * directly, or this index will become stale.
+   */
+  TrafficIdIndex<MAX_COUNT> index;
+
   void Clear() {
     new_traffic.Clear();
     list.clear();
+    index.Clear();
   }
 
   bool IsEmpty() const {
@@ -73,9 +82,16 @@ struct GliderLinkTrafficList {
   void Expire(TimeStamp clock) noexcept {
     new_traffic.Expire(clock, std::chrono::minutes(5));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      index.Rebuild(list);
   }
 
   /**
@@ -85,11 +101,8 @@ struct GliderLinkTrafficList {
    * @return the GLIDER_LINK_TRAFFIC pointer, NULL if not found
    */
   GliderLinkTraffic *FindTraffic(GliderLinkId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = index.Find(list, id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -99,22 +112,60 @@ struct GliderLinkTrafficList {
    * @return the GLIDER_LINK_TRAFFIC pointer, NULL if not found
    */
   const GliderLinkTraffic *FindTraffic(GliderLinkId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = index.Find(list, id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
-   * Allocates a new GLIDER_LINK_TRAFFIC object from the array.
+   * Allocates a new GLIDER_LINK_TRAFFIC object from the array for a
+   * (not yet stored) target.  If the array is full, the target which
+   * is farthest away from our own location is replaced, but only if
+   * the new one is closer.
    *
-   * @return the GLIDER_LINK_TRAFFIC pointer, NULL if the array is full
+   * @param location the location of the new target
+   * @param own_location our own location; if it is invalid, no target
+   * is replaced
+   * @return the GLIDER_LINK_TRAFFIC pointer (cleared, with the id
+   * already set), NULL if the array is full and all targets are
+   * closer
    */
-  GliderLinkTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+  GliderLinkTraffic *AllocateTraffic(GliderLinkId id,
+                                     const GeoPoint &location,
+                                     const GeoPoint &own_location) {
+    GliderLinkTraffic *traffic;
+
+    if (!list.full()) {
+      traffic = &list.append();
+      traffic->id = id;
+      index.Insert(id, list.size() - 1);
+    } else {
+      if (!own_location.IsValid() || !location.IsValid())
+        return nullptr;
+
+      traffic = nullptr;
+      double max_distance = location.DistanceS(own_location);
+      for (auto &i : list) {
+        const double distance = i.location.IsValid()
+          ? i.location.DistanceS(own_location)
+          /* targets without a location are the least important */
+          : std::numeric_limits<double>::infinity();
+        if (distance > max_distance) {
+          traffic = &i;
+          max_distance = distance;
+        }
+      }
+
+      if (traffic == nullptr)
+        return nullptr;
+
+      /* evict the farthest target; it is easier to rebuild the index
+         than to remove the old id from it */
+      traffic->id = id;
+      index.Rebuild(list);
+    }
+
+    traffic->Clear();
+    return traffic;
   }
 };
 
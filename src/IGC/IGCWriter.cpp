@@ -30,12 +30,14 @@ Copyright_License {
 
 #include <cassert>
 
-IGCWriter::IGCWriter(Path path)
+IGCWriter::IGCWriter(Path path,
+                     std::chrono::steady_clock::duration commit_interval)
   :file(path,
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   threaded(file, commit_interval),
+   buffered(threaded)
 {
   fix.Clear();
 
@@ -27,8 +27,11 @@ Copyright_License {
 #include "Logger/GRecord.hpp"
 #include "IGCFix.hpp"
 #include "io/FileOutputStream.hxx"
+#include "io/ThreadedOutputStream.hpp"
 #include "io/BufferedOutputStream.hxx"
 
+#include <chrono>
+
 #include <tchar.h>
 
 class Path;
@@ -43,6 +46,13 @@ class IGCWriter {
   };
 
   FileOutputStream file;
+
+  /**
+   * Writes to #file in a separate thread, so the calculation thread
+   * never blocks on slow SD cards.
+   */
+  ThreadedOutputStream threaded;
+
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -54,13 +64,32 @@ class IGCWriter {
 public:
   /**
    * Throws on error.
+   *
+   * @param commit_interval the maximum time between logging a record
+   * and writing it to the file
    */
-  explicit IGCWriter(Path path);
+  explicit IGCWriter(Path path,
+                     std::chrono::steady_clock::duration commit_interval=std::chrono::seconds{1});
 
+  /**
+   * Pass all pending records to the writer thread.  This does not
+   * block on file I/O.
+   */
   void Flush() {
     buffered.Flush();
   }
 
+  /**
+   * Like Flush(), but wait until the writer thread has written
+   * everything to the file.
+   *
+   * Throws on error.
+   */
+  void Sync() {
+    buffered.Flush();
+    threaded.Flush();
+  }
+
   void Sign();
 
 private:
@@ -0,0 +1,283 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Graph.hpp"
+#include "Job.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/Thread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <utility>
+
+/**
+ * The resolution of the progress passed to the caller's
+ * #OperationEnvironment per weight unit.
+ */
+static constexpr unsigned PROGRESS_SCALE = 256;
+
+class JobGraph::Node final : public OperationEnvironment {
+  JobGraph &graph;
+
+public:
+  Job &job;
+  const unsigned weight;
+  const std::vector<Handle> depends;
+
+  enum class State {
+    WAITING,
+    RUNNING,
+    FINISHED,
+  } state = State::WAITING;
+
+  std::atomic_uint range{0}, position{0};
+
+  Node(JobGraph &_graph, Job &_job, unsigned _weight,
+       std::initializer_list<Handle> _depends) noexcept
+    :graph(_graph), job(_job), weight(_weight), depends(_depends) {}
+
+  /**
+   * The progress of this job in #PROGRESS_SCALE units.
+   */
+  [[gnu::pure]]
+  unsigned GetProgress() const noexcept {
+    switch (state) {
+    case State::WAITING:
+      break;
+
+    case State::RUNNING:
+      if (const unsigned r = range.load(std::memory_order_relaxed); r > 0)
+        return std::min(position.load(std::memory_order_relaxed), r) *
+          PROGRESS_SCALE / r;
+      break;
+
+    case State::FINISHED:
+      return PROGRESS_SCALE;
+    }
+
+    return 0;
+  }
+
+  /* virtual methods from class OperationEnvironment */
+  bool IsCancelled() const noexcept override {
+    return false;
+  }
+
+  void SetCancelHandler(std::function<void()>) noexcept override {}
+
+  void Sleep(std::chrono::steady_clock::duration duration) noexcept override {
+    std::this_thread::sleep_for(duration);
+  }
+
+  void SetErrorMessage(const TCHAR *_text) noexcept override {
+    graph.SetText(_text);
+  }
+
+  void SetText(const TCHAR *_text) noexcept override {
+    graph.SetText(_text);
+  }
+
+  void SetProgressRange(unsigned _range) noexcept override {
+    range.store(_range, std::memory_order_relaxed);
+  }
+
+  void SetProgressPosition(unsigned _position) noexcept override {
+    position.store(_position, std::memory_order_relaxed);
+  }
+};
+
+class JobGraph::Worker final : public Thread {
+  JobGraph &graph;
+
+public:
+  explicit Worker(JobGraph &_graph) noexcept
+    :Thread("JobGraph"), graph(_graph) {}
+
+  ~Worker() noexcept {
+    if (IsDefined())
+      Join();
+  }
+
+private:
+  /* virtual methods from class Thread */
+  void Run() noexcept override {
+    graph.RunWorker();
+  }
+};
+
+JobGraph::JobGraph() noexcept = default;
+JobGraph::~JobGraph() noexcept = default;
+
+JobGraph::Handle
+JobGraph::Add(Job &job, unsigned weight,
+              std::initializer_list<Handle> depends) noexcept
+{
+  /* depending only on jobs added before rules out cycles */
+  assert(std::all_of(depends.begin(), depends.end(),
+                     [this](Handle h){ return h < nodes.size(); }));
+
+  nodes.emplace_back(std::make_unique<Node>(*this, job, weight, depends));
+  return nodes.size() - 1;
+}
+
+JobGraph::Node *
+JobGraph::FindReady() const noexcept
+{
+  for (const auto &node : nodes)
+    if (node->state == Node::State::WAITING &&
+        std::all_of(node->depends.begin(), node->depends.end(),
+                    [this](Handle h){
+                      return nodes[h]->state == Node::State::FINISHED;
+                    }))
+      return node.get();
+
+  return nullptr;
+}
+
+unsigned
+JobGraph::GetProgress() const noexcept
+{
+  unsigned progress = 0;
+  for (const auto &node : nodes)
+    progress += node->weight * node->GetProgress();
+  return progress;
+}
+
+void
+JobGraph::SetText(const TCHAR *_text) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  text = _text;
+  text_modified = true;
+}
+
+void
+JobGraph::RunWorker() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  while (!error) {
+    Node *node = FindReady();
+    if (node == nullptr) {
+      if (n_finished == nodes.size())
+        break;
+
+      cond.wait(lock);
+      continue;
+    }
+
+    node->state = Node::State::RUNNING;
+    ++n_running;
+
+    std::exception_ptr e;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      try {
+        node->job.Run(*node);
+      } catch (...) {
+        e = std::current_exception();
+      }
+    }
+
+    node->state = Node::State::FINISHED;
+    --n_running;
+    ++n_finished;
+
+    if (e && !error)
+      error = std::move(e);
+
+    cond.notify_all();
+  }
+
+  /* wake up the other workers, which may be waiting for a job that
+     will never be started after an error */
+  cond.notify_all();
+}
+
+void
+JobGraph::Run(OperationEnvironment &env, unsigned n_threads)
+{
+  unsigned total_weight = 0;
+  for (const auto &node : nodes)
+    total_weight += node->weight;
+
+  env.SetProgressRange(total_weight * PROGRESS_SCALE);
+  env.SetProgressPosition(0);
+
+  if (nodes.empty())
+    return;
+
+  n_threads = std::clamp(n_threads, 1U, unsigned(nodes.size()));
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  workers.reserve(n_threads);
+  for (unsigned i = 0; i < n_threads; ++i) {
+    auto worker = std::make_unique<Worker>(*this);
+
+    try {
+      worker->Start();
+    } catch (...) {
+      if (workers.empty())
+        throw;
+
+      /* continue with the threads we have */
+      break;
+    }
+
+    workers.emplace_back(std::move(worker));
+  }
+
+  {
+    std::unique_lock<Mutex> lock(mutex);
+
+    while (!IsDone()) {
+      cond.wait_for(lock, std::chrono::milliseconds(100));
+
+      const unsigned progress = GetProgress();
+
+      StaticString<128> new_text;
+      const bool update_text = std::exchange(text_modified, false);
+      if (update_text)
+        new_text = text;
+
+      const ScopeUnlock unlock(mutex);
+
+      if (update_text)
+        env.SetText(new_text);
+      env.SetProgressPosition(progress);
+    }
+  }
+
+  /* the last poll may have happened before the last job finished */
+  env.SetProgressPosition(total_weight * PROGRESS_SCALE);
+
+  /* the Worker destructor joins the thread */
+  workers.clear();
+
+  if (error)
+    std::rethrow_exception(error);
+}
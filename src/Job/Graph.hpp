@@ -0,0 +1,131 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_JOB_GRAPH_HPP
+#define XCSOAR_JOB_GRAPH_HPP
+
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+#include "util/StaticString.hxx"
+
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <tchar.h>
+
+class Job;
+class OperationEnvironment;
+
+/**
+ * Runs a set of #Job instances on a small pool of worker threads,
+ * honouring the dependencies between them.  Jobs which do not
+ * depend on each other (e.g. parsing different data files) run
+ * concurrently.
+ *
+ * The calling thread waits for all jobs and passes their combined
+ * progress to its own #OperationEnvironment, which therefore needs
+ * not be thread-safe.
+ */
+class JobGraph {
+  class Node;
+  class Worker;
+
+  std::vector<std::unique_ptr<Node>> nodes;
+
+  /**
+   * Protects the attributes below and the state of all nodes.
+   */
+  Mutex mutex;
+  Cond cond;
+
+  unsigned n_running = 0, n_finished = 0;
+
+  /**
+   * The first exception thrown by a #Job.  After that, no more jobs
+   * are started.
+   */
+  std::exception_ptr error;
+
+  StaticString<128> text;
+  bool text_modified = false;
+
+public:
+  using Handle = unsigned;
+
+  JobGraph() noexcept;
+  ~JobGraph() noexcept;
+
+  JobGraph(const JobGraph &) = delete;
+  JobGraph &operator=(const JobGraph &) = delete;
+
+  /**
+   * Add a job.  It will not be started before all the jobs in
+   * #depends have finished.
+   *
+   * @param job the job; it must be valid until Run() returns
+   * @param weight the share of this job in the total progress
+   * @param depends jobs which have been added before
+   */
+  Handle Add(Job &job, unsigned weight,
+             std::initializer_list<Handle> depends={}) noexcept;
+
+  /**
+   * Run all jobs and wait for their completion.
+   *
+   * Throws the first exception thrown by a job; jobs which have
+   * not been started at that time are skipped.
+   *
+   * @param n_threads the maximum number of worker threads
+   */
+  void Run(OperationEnvironment &env, unsigned n_threads);
+
+private:
+  bool IsDone() const noexcept {
+    return n_running == 0 && (error || n_finished == nodes.size());
+  }
+
+  /**
+   * Find a job whose dependencies have all finished.  Caller must
+   * lock the mutex.
+   */
+  [[gnu::pure]]
+  Node *FindReady() const noexcept;
+
+  /**
+   * Calculate the combined progress of all jobs.  Caller must lock
+   * the mutex.
+   */
+  [[gnu::pure]]
+  unsigned GetProgress() const noexcept;
+
+  void SetText(const TCHAR *_text) noexcept;
+
+  /**
+   * The main loop of a worker thread.
+   */
+  void RunWorker() noexcept;
+};
+
+#endif
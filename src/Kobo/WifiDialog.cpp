@@ -101,7 +101,8 @@ public:
                row_renderer.CalculateLayout(look.text_font,
                                             look.small_font));
     UpdateList();
-    update_timer.Schedule(std::chrono::seconds(1));
+    update_timer.Schedule(std::chrono::seconds(1),
+                          std::chrono::milliseconds(250));
   }
 
   /* virtual methods from class ListItemRenderer */
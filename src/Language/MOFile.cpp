@@ -26,8 +26,41 @@ Copyright_License {
 #include <cassert>
 #include <string.h>
 
+/**
+ * The hash function used by GNU gettext ("hashpjw").  It is
+ * evaluated with 64 bit, like msgfmt on the hosts the catalogues are
+ * built on.
+ */
+static constexpr uint32_t
+HashString(const char *p) noexcept
+{
+  uint64_t hval = 0;
+  while (*p != 0) {
+    hval <<= 4;
+    hval += (uint8_t)*p++;
+    const uint64_t g = hval & (~uint64_t(0) << 28);
+    if (g != 0) {
+      hval ^= g >> 24;
+      hval ^= g;
+    }
+  }
+
+  return hval;
+}
+
+/**
+ * Is the table of #n entries at #offset completely inside the file?
+ */
+static constexpr bool
+CheckTable(size_t size, uint32_t offset, size_t n, size_t entry_size) noexcept
+{
+  return offset < size && n <= (size - offset) / entry_size &&
+    offset % 4 == 0;
+}
+
 MOFile::MOFile(const void *_data, size_t _size)
-  :data((const uint8_t *)_data), size(_size), count(0) {
+  :data((const uint8_t *)_data), size(_size), count(0),
+   hash_table(nullptr), hash_table_size(0) {
   const struct mo_header *header = (const struct mo_header *)_data;
   if (size < sizeof(*header))
     return;
@@ -44,22 +77,28 @@ MOFile::MOFile(const void *_data, size_t _size)
   if (n >= 0x100000)
     return;
 
-  strings.ResizeDiscard(n);
+  const uint32_t original_table_offset =
+    import_uint32(header->original_table_offset);
+  const uint32_t translation_table_offset =
+    import_uint32(header->translation_table_offset);
+  if (!CheckTable(size, original_table_offset, n, sizeof(mo_table_entry)) ||
+      !CheckTable(size, translation_table_offset, n, sizeof(mo_table_entry)))
+    return;
+
+  originals = (const struct mo_table_entry *)(const void *)
+    (data + original_table_offset);
+  translations = (const struct mo_table_entry *)(const void *)
+    (data + translation_table_offset);
 
-  const struct mo_table_entry *entry = (const struct mo_table_entry *)
-    (const void *)(data + import_uint32(header->original_table_offset));
-  for (unsigned i = 0; i < n; ++i) {
-    strings[i].original = get_string(entry++);
-    if (strings[i].original == NULL)
-      return;
-  }
+  /* the strings themselves are checked by get_string() when they
+     are looked up */
 
-  entry = (const struct mo_table_entry *)(const void *)
-    (data + import_uint32(header->translation_table_offset));
-  for (unsigned i = 0; i < n; ++i) {
-    strings[i].translation = get_string(entry++);
-    if (strings[i].translation == NULL)
-      return;
+  const unsigned n_hash = import_uint32(header->hash_table_size);
+  const uint32_t hash_table_offset = import_uint32(header->hash_table_offset);
+  if (n_hash > 2 &&
+      CheckTable(size, hash_table_offset, n_hash, sizeof(uint32_t))) {
+    hash_table = (const uint32_t *)(const void *)(data + hash_table_offset);
+    hash_table_size = n_hash;
   }
 
   count = n;
@@ -70,9 +109,67 @@ MOFile::lookup(const char *p) const
 {
   assert(p != NULL);
 
-  for (unsigned i = 0; i < count; ++i)
-    if (strcmp(strings[i].original, p) == 0)
-      return strings[i].translation;
+  return hash_table != nullptr
+    ? lookup_hash(p)
+    : lookup_sorted(p);
+}
+
+bool
+MOFile::original_equals(unsigned i, const char *p, size_t length) const
+{
+  if (import_uint32(originals[i].length) != length)
+    return false;
+
+  const char *original = get_string(&originals[i]);
+  return original != nullptr && memcmp(original, p, length) == 0;
+}
+
+const char *
+MOFile::lookup_hash(const char *p) const
+{
+  const size_t length = strlen(p);
+  const uint32_t hash = HashString(p);
+  unsigned i = hash % hash_table_size;
+  const unsigned increment = 1 + hash % (hash_table_size - 2);
+
+  /* open addressing with double hashing, as in GNU gettext; the
+     number of probes is limited in case the table is corrupt */
+  for (unsigned n_probes = 0; n_probes < hash_table_size; ++n_probes) {
+    const unsigned nstr = import_uint32(hash_table[i]);
+    if (nstr == 0)
+      /* empty slot */
+      return NULL;
+
+    if (nstr <= count && original_equals(nstr - 1, p, length))
+      return get_string(&translations[nstr - 1]);
+
+    i = i >= hash_table_size - increment
+      ? i - (hash_table_size - increment)
+      : i + increment;
+  }
+
+  return NULL;
+}
+
+const char *
+MOFile::lookup_sorted(const char *p) const
+{
+  /* msgfmt sorts the original strings */
+  unsigned left = 0, right = count;
+  while (left < right) {
+    const unsigned middle = (left + right) / 2;
+    const char *original = get_string(&originals[middle]);
+    if (original == NULL)
+      return NULL;
+
+    const int cmp = strcmp(p, original);
+    if (cmp == 0)
+      return get_string(&translations[middle]);
+    else if (cmp < 0)
+      right = middle;
+    else
+      left = middle + 1;
+  }
 
   return NULL;
 }
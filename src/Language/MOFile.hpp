@@ -24,12 +24,14 @@ Copyright_License {
 #ifndef XCSOAR_MO_FILE_HPP
 #define XCSOAR_MO_FILE_HPP
 
-#include "util/AllocatedArray.hxx"
-
+#include <cstddef>
 #include <cstdint>
 
 /**
- * Loader for GNU gettext *.mo files.
+ * Loader for GNU gettext *.mo files.  The strings are not copied;
+ * lookups use the hash table generated by msgfmt (or a binary search
+ * if the file has none) directly on the (usually memory-mapped)
+ * file.
  */
 class MOFile {
   struct mo_header {
@@ -45,17 +47,17 @@ class MOFile {
     uint32_t offset;
   };
 
-  struct string_pair {
-    const char *original, *translation;
-  };
-
   const uint8_t *data;
   size_t size;
 
   bool native_byte_order;
 
   unsigned count;
-  AllocatedArray<string_pair> strings;
+
+  const mo_table_entry *originals, *translations;
+
+  const uint32_t *hash_table;
+  unsigned hash_table_size;
 
 public:
   MOFile(const void *data, size_t size);
@@ -75,6 +77,14 @@ private:
   }
 
   const char *get_string(const struct mo_table_entry *entry) const;
+
+  /**
+   * Does the original string #i equal the given string?
+   */
+  bool original_equals(unsigned i, const char *p, size_t length) const;
+
+  const char *lookup_hash(const char *p) const;
+  const char *lookup_sorted(const char *p) const;
 };
 
 #endif
@@ -90,7 +90,7 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (!simulator)
     writer->Sign();
 
-  writer->Flush();
+  writer->Sync();
 
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
@@ -23,18 +23,26 @@ Copyright_License {
 
 #include "Logger/NMEALogger.hpp"
 #include "io/FileOutputStream.hxx"
+#include "io/ThreadedOutputStream.hpp"
 #include "LocalPath.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "system/Path.hpp"
 #include "util/StaticString.hxx"
 
+/**
+ * The maximum time between receiving a NMEA line and writing it to
+ * the file.  This is longer than for IGC files, because the NMEA log
+ * is only a debugging aid and produces a lot more data.
+ */
+static constexpr auto NMEA_COMMIT_INTERVAL = std::chrono::seconds{5};
+
 NMEALogger::NMEALogger() noexcept {}
 NMEALogger::~NMEALogger() noexcept = default;
 
 inline void
 NMEALogger::Start()
 {
-  if (file != nullptr)
+  if (threaded != nullptr)
     return;
 
   BrokenDateTime dt = BrokenDateTime::NowUTC();
@@ -50,6 +58,8 @@ NMEALogger::Start()
   const auto path = AllocatedPath::Build(logs_path, name);
   file = std::make_unique<FileOutputStream>(path,
                                             FileOutputStream::Mode::APPEND_OR_CREATE);
+  threaded = std::make_unique<ThreadedOutputStream>(*file,
+                                                    NMEA_COMMIT_INTERVAL);
 }
 
 static void
@@ -71,7 +81,7 @@ NMEALogger::Log(const char *text) noexcept
 
   try {
     Start();
-    WriteLine(*file, text);
+    WriteLine(*threaded, text);
   } catch (...) {
   }
 }
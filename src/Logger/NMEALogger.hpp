@@ -29,11 +29,18 @@ Copyright_License {
 #include <memory>
 
 class FileOutputStream;
+class ThreadedOutputStream;
 
 class NMEALogger {
   Mutex mutex;
   std::unique_ptr<FileOutputStream> file;
 
+  /**
+   * Writes to #file in a separate thread, so the device threads
+   * never block on slow SD cards.
+   */
+  std::unique_ptr<ThreadedOutputStream> threaded;
+
   bool enabled = false;
 
 public:
@@ -464,7 +464,9 @@ MainWindow::Destroy() noexcept
 void
 MainWindow::FinishStartup() noexcept
 {
-  timer.Schedule(std::chrono::milliseconds(500)); // 2 times per second
+  // 2 times per second; the slack lets it share wakeups
+  timer.Schedule(std::chrono::milliseconds(500),
+                 std::chrono::milliseconds(100));
 
   ResumeThreads();
 }
@@ -101,6 +101,8 @@ private:
 
   std::unique_ptr<PluggableOperationEnvironment> terrain_loader_env;
 
+  UI::Notify airspace_terrain_notify{[this]{ OnAirspaceTerrainLoaded(); }};
+
   /**
    * Called by the #MergeThread when new GPS data is available.
    */
@@ -259,6 +261,12 @@ public:
    */
   void LoadTerrain() noexcept;
 
+  /**
+   * Start calculating the terrain envelopes of the airspaces
+   * (asynchronously).
+   */
+  void LoadAirspaceTerrain() noexcept;
+
   /**
    * Set the keyboard focus on the default element (i.e. the
    * MapWindow).
@@ -393,6 +401,7 @@ private:
   void OnRestorePageNotify() noexcept;
 
   void OnTerrainLoaded() noexcept;
+  void OnAirspaceTerrainLoaded() noexcept;
 
 protected:
   /* virtual methods from class Window */
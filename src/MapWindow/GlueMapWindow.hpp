@@ -199,6 +199,9 @@ public:
 protected:
   /* virtual methods from class MapWindow */
   virtual void Render(Canvas &canvas, const PixelRect &rc) override;
+  void OnRaspLoaded() noexcept override {
+    PartialRedraw();
+  }
   virtual void DrawThermalEstimate(Canvas &canvas) const override;
   virtual void RenderTrail(Canvas &canvas,
                            const PixelPoint aircraft_pos) override;
@@ -87,8 +87,36 @@ MapCanvas::PreparePolygon(const SearchPointVector &points) noexcept
 
   /* project all GeoPoints to screen coordinates */
   raster_points.GrowDiscard(num_raster_points);
-  for (unsigned i = 0; i < num_raster_points; ++i)
-    raster_points[i] = projection.GeoToScreen(geo_points[i]);
+  projection.GeoToScreen(geo_points.begin(), raster_points.begin(),
+                         num_raster_points);
+
+  return true;
+}
+
+bool
+MapCanvas::PreparePolygon(std::span<const GeoPoint> points,
+                          const GeoBounds &bounds) noexcept
+{
+  unsigned num_points = points.size();
+  if (num_points < 3 || !clip.Overlaps(bounds))
+    return false;
+
+  const GeoPoint *src = points.data();
+  if (!clip.IsInside(bounds)) {
+    /* clip them */
+    geo_points.GrowDiscard(num_points * 3);
+    num_points = clip.ClipPolygon(geo_points.begin(), src, num_points);
+    if (num_points < 3)
+      /* it's completely outside the screen */
+      return false;
+
+    src = geo_points.begin();
+  }
+
+  /* project all GeoPoints to screen coordinates */
+  num_raster_points = num_points;
+  raster_points.GrowDiscard(num_raster_points);
+  projection.GeoToScreen(src, raster_points.begin(), num_raster_points);
 
   return true;
 }
@@ -28,6 +28,8 @@ Copyright_License {
 #include "Geo/GeoClip.hpp"
 #include "util/AllocatedArray.hxx"
 
+#include <span>
+
 class Canvas;
 class Projection;
 struct GeoPoint;
@@ -90,6 +92,16 @@ public:
    * DrawPrepared())
    */
   bool PreparePolygon(const SearchPointVector &points) noexcept;
+
+  /**
+   * Like PreparePolygon(const SearchPointVector &), but skips
+   * clipping if the bounds of the polygon are completely inside the
+   * clip rectangle.
+   *
+   * @param bounds the bounds of all points
+   */
+  bool PreparePolygon(std::span<const GeoPoint> points,
+                      const GeoBounds &bounds) noexcept;
   void DrawPrepared() noexcept;
 };
 
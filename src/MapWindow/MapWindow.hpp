@@ -27,6 +27,7 @@ Copyright_License {
 #include "Projection/MapWindowProjection.hpp"
 #include "Renderer/AirspaceRenderer.hpp"
 #include "ui/window/DoubleBufferWindow.hpp"
+#include "ui/event/Notify.hpp"
 #ifndef ENABLE_OPENGL
 #include "ui/canvas/BufferCanvas.hpp"
 #endif
@@ -127,6 +128,11 @@ protected:
 
   std::shared_ptr<RaspStore> rasp_store;
 
+  /**
+   * Receives notifications from the #RaspRenderer's loader thread.
+   */
+  UI::Notify rasp_notify{[this]{ OnRaspLoaded(); }};
+
   /**
    * The current RASP renderer.  Modifications to this pointer (but
    * not to the #RaspRenderer instance) are protected by
@@ -340,6 +346,14 @@ protected:
     UpdateTerrain();
   }
 
+  /**
+   * A RASP map has been loaded in the background and the map shall
+   * be redrawn.
+   */
+  virtual void OnRaspLoaded() noexcept {
+    Invalidate();
+  }
+
 protected:
   /* virtual methods from class Window */
   virtual void OnCreate() override;
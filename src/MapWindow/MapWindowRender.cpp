@@ -29,7 +29,6 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
-#include "Operation/Operation.hpp"
 #include "Tracking/SkyLines/Data.hpp"
 
 #ifdef HAVE_NOAA
@@ -73,15 +72,14 @@ MapWindow::RenderRasp(Canvas &canvas)
 #ifndef ENABLE_OPENGL
     const std::lock_guard<Mutex> lock(mutex);
 #endif
-    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map));
+    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map,
+                                         [this](){
+                                           rasp_notify.SendNotification();
+                                         }));
   }
 
   rasp_renderer->SetTime(state.time);
-
-  {
-    QuietOperationEnvironment operation;
-    rasp_renderer->Update(Calculated().date_time_local, operation);
-  }
+  rasp_renderer->Update(Calculated().date_time_local);
 
   const auto &terrain_settings = GetMapSettings().terrain;
   if (rasp_renderer->Generate(render_projection, terrain_settings))
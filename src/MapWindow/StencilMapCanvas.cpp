@@ -73,8 +73,34 @@ StencilMapCanvas::DrawSearchPointVector(const SearchPointVector &points)
 
   /* draw it all */
   BulkPixelPoint *screen = pixel_points_buffer.get(size);
-  for (unsigned i = 0; i < size; ++i)
-    screen[i] = proj.GeoToScreen(geo_points[i]);
+  proj.GeoToScreen(geo_points, screen, size);
+
+  buffer.DrawPolygon(&screen[0], size);
+  if (use_stencil)
+    stencil.DrawPolygon(&screen[0], size);
+}
+
+void
+StencilMapCanvas::DrawPolygon(std::span<const GeoPoint> points,
+                              const GeoBounds &bounds)
+{
+  size_t size = points.size();
+  if (size < 3 || !clip.Overlaps(bounds))
+    return;
+
+  const GeoPoint *src = points.data();
+  if (!clip.IsInside(bounds)) {
+    GeoPoint *geo_points = geo_points_buffer.get(size * 3);
+    size = clip.ClipPolygon(geo_points, src, size);
+    if (size < 3)
+      /* it's completely outside the screen */
+      return;
+
+    src = geo_points;
+  }
+
+  BulkPixelPoint *screen = pixel_points_buffer.get(size);
+  proj.GeoToScreen(src, screen, size);
 
   buffer.DrawPolygon(&screen[0], size);
   if (use_stencil)
@@ -29,6 +29,8 @@ Copyright_License {
 #include "Geo/GeoClip.hpp"
 #include "util/ReusableArray.hpp"
 
+#include <span>
+
 struct PixelPoint;
 struct BulkPixelPoint;
 class Canvas;
@@ -70,6 +72,12 @@ public:
 
   void DrawSearchPointVector(const SearchPointVector &points);
 
+  /**
+   * Draw a polygon whose bounds are known; clipping is skipped if
+   * they are completely inside the clip rectangle.
+   */
+  void DrawPolygon(std::span<const GeoPoint> points, const GeoBounds &bounds);
+
   void DrawCircle(const PixelPoint &center, unsigned radius);
 
   void Begin();
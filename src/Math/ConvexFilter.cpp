@@ -34,12 +34,13 @@ ConvexFilter::UpdateConvex(double x, double y, int csign) noexcept
 
   // check pruning of previous points
 
-  while (GetCount() > 2) {
-    const unsigned n = GetCount();
-    const auto &next = GetSlots()[n - 1];
-    const auto &prev = GetSlots()[n - 3];
+  while (GetSlots().size > 2) {
+    const auto slots = GetSlots();
+    const unsigned n = slots.size;
+    const auto &next = slots[n - 1];
+    const auto &prev = slots[n - 3];
     const double m = (next.y-prev.y)/(next.x-prev.x);
-    const auto &cur = GetSlots()[n - 2];
+    const auto &cur = slots[n - 2];
     const double y_est = (cur.x - prev.x)*m + prev.y;
 
     // if this point doesn't need pruning, neither will predecessors
@@ -86,6 +86,20 @@ public:
   FastIntegerRotation(Angle angle) noexcept
     :cost(angle.ifastcosine()), sint(angle.ifastsine()) {}
 
+  /**
+   * Returns the cosine, scaled by #ONE.
+   */
+  constexpr int GetCos() const noexcept {
+    return cost;
+  }
+
+  /**
+   * Returns the sine, scaled by #ONE.
+   */
+  constexpr int GetSin() const noexcept {
+    return sint;
+  }
+
   void Scale(int multiply, int divide=1) noexcept {
     cost = cost * multiply / divide;
     sint = sint * multiply / divide;
@@ -168,7 +168,7 @@ LeastSquares::Add(double x, double y, double weight) noexcept
 void
 LeastSquares::Remove(const unsigned i) noexcept
 {
-  assert(i < GetCount());
+  assert(i < GetSlots().size);
 
   const auto &pt = GetSlots()[i];
   // Remove weighted point
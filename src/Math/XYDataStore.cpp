@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "XYDataStore.hpp"
 
+#include <algorithm>
+
 void
 XYDataStore::StoreReset() noexcept
 {
@@ -50,9 +52,10 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
     x_min = x;
 
   // Add point
-  // TODO code: really should have a circular buffer here
-  if (!slots.full())
-    slots.append() = Slot(x, y, weight);
+  if (slots.full())
+    Downsample();
+
+  slots.append() = Slot(x, y, weight);
 
   ++sum_n;
 
@@ -63,10 +66,46 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
   sum_yw += y * weight;
 }
 
+void
+XYDataStore::Downsample() noexcept
+{
+  static constexpr unsigned GROUP = 4;
+
+  const unsigned older = slots.size() / 2 / GROUP * GROUP;
+
+  unsigned dest = 0;
+  for (unsigned i = 0; i < older; i += GROUP) {
+    unsigned lowest = i, highest = i;
+    for (unsigned j = i + 1; j < i + GROUP; ++j) {
+      if (slots[j].y < slots[lowest].y)
+        lowest = j;
+      if (slots[j].y > slots[highest].y)
+        highest = j;
+    }
+
+    if (lowest == highest) {
+      /* flat: keep both ends */
+      lowest = i;
+      highest = i + GROUP - 1;
+    }
+
+    /* keep them in chronological order */
+    const Slot a = slots[std::min(lowest, highest)];
+    const Slot b = slots[std::max(lowest, highest)];
+    slots[dest++] = a;
+    slots[dest++] = b;
+  }
+
+  for (unsigned i = older; i < slots.size(); ++i)
+    slots[dest++] = slots[i];
+
+  slots.shrink(dest);
+}
+
 void
 XYDataStore::StoreRemove(const unsigned i) noexcept
 {
-  assert(i< sum_n);
+  assert(i < slots.size());
   const auto &pt = slots[i];
 
   // Remove weighted point
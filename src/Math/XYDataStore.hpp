@@ -23,6 +23,11 @@ Copyright_License {
 
 /**
  * Basic container class for storage of X-Y data pairs
+ *
+ * The number of stored samples is bounded.  When the buffer is full,
+ * the older half is decimated (see Downsample()), so a long series
+ * keeps full resolution for recent data and a coarser envelope of
+ * older data, while the running sums always cover all samples.
  */
 
 #ifndef _XYDATASTORE_H
@@ -75,6 +80,10 @@ public:
     return sum_n >= 2;
   }
 
+  /**
+   * Returns the number of samples which have been added.  This may
+   * be larger than the number of slots returned by GetSlots().
+   */
   constexpr unsigned GetCount() const noexcept {
     return sum_n;
   }
@@ -125,6 +134,14 @@ protected:
    */
   void StoreRemove(const unsigned i) noexcept;
 
+private:
+  /**
+   * Make room in a full buffer by decimating its older half: of each
+   * group of four slots, only the lowest and the highest one are
+   * kept, which preserves the envelope of the graph.  The running
+   * sums are not modified, they still include the dropped samples.
+   */
+  void Downsample() noexcept;
 };
 
 static_assert(std::is_trivial<XYDataStore>::value, "type is not trivial");
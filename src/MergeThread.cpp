@@ -29,6 +29,8 @@ Copyright_License {
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
 
+#include <utility>
+
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread",
 #ifdef KOBO
@@ -74,6 +76,7 @@ MergeThread::Tick() noexcept
 #ifdef HAVE_PCM_PLAYER
   bool vario_available;
   double vario;
+  std::chrono::steady_clock::time_point received;
 #endif
 
   {
@@ -99,6 +102,14 @@ MergeThread::Tick() noexcept
 #ifdef HAVE_PCM_PLAYER
     vario_available = basic.brutto_vario_available;
     vario = vario_available ? basic.brutto_vario : 0;
+
+    /* consume the time stamp; if no new data has been received from
+       a physical device (e.g. simulator or replay), there is nothing
+       to measure */
+    received = std::exchange(device_blackboard.last_received,
+                             std::chrono::steady_clock::time_point{});
+    if (received == std::chrono::steady_clock::time_point{})
+      received = std::chrono::steady_clock::now();
 #endif
 
     /* update last_any in every iteration */
@@ -113,7 +124,7 @@ MergeThread::Tick() noexcept
 
 #ifdef HAVE_PCM_PLAYER
   if (vario_available)
-    AudioVarioGlue::SetValue(vario);
+    AudioVarioGlue::SetValue(vario, received);
   else
     AudioVarioGlue::NoValue();
 #endif
@@ -22,20 +22,93 @@ Copyright_License {
 */
 
 #include "Map.hpp"
+#include "util/NumberParser.hpp"
+
+#include <algorithm>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+void
+ProfileMap::Item::Assign(const char *_value)
+{
+  value.assign(_value);
+
+  char *endptr;
+  integer = ParseInt64(_value, &endptr, 0);
+  has_integer = endptr != _value;
+  exact_integer = has_integer && *endptr == 0;
+
+  real = ParseDouble(_value, &endptr);
+  has_real = endptr != _value;
+}
+
+static bool
+KeyLess(const ProfileMap::Item &item, std::string_view key) noexcept
+{
+  return item.key < key;
+}
+
+ProfileMap::ItemList::iterator
+ProfileMap::LowerBound(std::string_view key) noexcept
+{
+  return std::lower_bound(items.begin(), items.end(), key, KeyLess);
+}
+
+ProfileMap::ItemList::const_iterator
+ProfileMap::LowerBound(std::string_view key) const noexcept
+{
+  return std::lower_bound(items.begin(), items.end(), key, KeyLess);
+}
+
+const ProfileMap::Item *
+ProfileMap::Find(std::string_view key) const noexcept
+{
+  const auto i = LowerBound(key);
+  if (i == items.end() || i->key != key)
+    return nullptr;
+
+  return &*i;
+}
+
+void
+ProfileMap::Remove(const char *key) noexcept
+{
+  const auto i = LowerBound(key);
+  if (i == items.end() || i->key != key)
+    return;
+
+  items.erase(i);
+  SetModified();
+}
 
 void
 ProfileMap::Set(const char *key, const char *value)
 {
-  auto i = insert(std::make_pair(key, value));
-  if (!i.second) {
+  const auto i = LowerBound(key);
+  if (i != items.end() && i->key == key) {
     /* exists already */
 
-    if (i.first->second.compare(value) == 0)
+    if (i->value.compare(value) == 0)
       /* not modified, don't set the "modified" flag */
       return;
 
-    i.first->second.assign(value);
-  }
+    i->Assign(value);
+  } else
+    items.emplace(i, key, value);
 
   SetModified();
 }
+
+void
+ProfileMap::SetInteger(const char *key, int64_t value)
+{
+  const Item *item = Find(key);
+  if (item != nullptr && item->exact_integer && item->integer == value)
+    /* not modified, skip formatting */
+    return;
+
+  char tmp[32];
+  snprintf(tmp, sizeof(tmp), "%" PRId64, value);
+  Set(key, tmp);
+}
@@ -28,8 +28,9 @@ Copyright_License {
 #include "util/StringBuffer.hxx"
 #include "util/Compiler.h"
 
-#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <cstdint>
 #include <tchar.h>
@@ -41,7 +42,48 @@ class AllocatedPath;
 template<typename T> class StringPointer;
 template<typename T> class BasicAllocatedString;
 
-class ProfileMap : public std::map<std::string, std::string> {
+/**
+ * The key/value store of a profile.  Entries are kept in a flat
+ * array sorted by key, and numbers are parsed once when a value is
+ * stored, so lookups neither allocate nor parse.
+ */
+class ProfileMap {
+public:
+  struct Item {
+    std::string key, value;
+
+    /**
+     * The value parsed as integer (with ParseInt64(), base 0) and as
+     * floating point number; only valid if the according flag is
+     * set.
+     */
+    int64_t integer;
+    double real;
+
+    bool has_integer, has_real;
+
+    /**
+     * Was the whole value consumed by the integer parser, i.e. is
+     * #integer an exact representation of #value?
+     */
+    bool exact_integer;
+
+    Item(std::string_view _key, const char *_value)
+      :key(_key) {
+      Assign(_value);
+    }
+
+    void Assign(const char *_value);
+  };
+
+private:
+  using ItemList = std::vector<Item>;
+
+  /**
+   * All entries, sorted by key.
+   */
+  ItemList items;
+
   bool modified;
 
 public:
@@ -62,11 +104,32 @@ public:
     modified = _modified;
   }
 
+  ItemList::const_iterator begin() const noexcept {
+    return items.begin();
+  }
+
+  ItemList::const_iterator end() const noexcept {
+    return items.end();
+  }
+
+  bool IsEmpty() const noexcept {
+    return items.empty();
+  }
+
+  void Clear() noexcept {
+    items.clear();
+  }
+
   gcc_pure
   bool Exists(const char *key) const {
-    return find(key) != end();
+    return Find(key) != nullptr;
   }
 
+  /**
+   * Remove a value from the profile.
+   */
+  void Remove(const char *key) noexcept;
+
   // basic string values
 
   /**
@@ -79,11 +142,11 @@ public:
    */
   gcc_pure
   const char *Get(const char *key, const char *default_value=nullptr) const {
-    const auto i = find(key);
-    if (i == end())
+    const Item *item = Find(key);
+    if (item == nullptr)
       return default_value;
 
-    return i->second.c_str();
+    return item->value.c_str();
   }
 
   void Set(const char *key, const char *value);
@@ -138,9 +201,18 @@ public:
     Set(key, value ? "1" : "0");
   }
 
-  void Set(const char *key, int value);
-  void Set(const char *key, long value);
-  void Set(const char *key, unsigned value);
+  void Set(const char *key, int value) {
+    SetInteger(key, value);
+  }
+
+  void Set(const char *key, long value) {
+    SetInteger(key, value);
+  }
+
+  void Set(const char *key, unsigned value) {
+    SetInteger(key, value);
+  }
+
   void Set(const char *key, double value);
 
   void Set(const char *key, FloatDuration value) noexcept {
@@ -212,6 +284,22 @@ public:
    * e.g. #123456
    */
   void SetColor(const char *key, const RGB8Color value);
+
+private:
+  gcc_pure
+  ItemList::iterator LowerBound(std::string_view key) noexcept;
+
+  gcc_pure
+  ItemList::const_iterator LowerBound(std::string_view key) const noexcept;
+
+  gcc_pure
+  const Item *Find(std::string_view key) const noexcept;
+
+  /**
+   * Store an integer value.  Its string representation is only
+   * generated if the value differs from the current one.
+   */
+  void SetInteger(const char *key, int64_t value);
 };
 
 #endif
@@ -22,43 +22,26 @@ Copyright_License {
 */
 
 #include "Map.hpp"
-#include "util/NumberParser.hpp"
 
 bool
 ProfileMap::Get(const char *key, int &value) const
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a number
-  char *endptr;
-  int tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
+  const Item *item = Find(key);
+  if (item == nullptr || !item->has_integer)
     return false;
 
-  // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = (int)item->integer;
   return true;
 }
 
 bool
 ProfileMap::Get(const char *key, short &value) const
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a number
-  char *endptr;
-  short tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
+  const Item *item = Find(key);
+  if (item == nullptr || !item->has_integer)
     return false;
 
-  // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = (short)item->integer;
   return true;
 }
 
@@ -78,19 +61,11 @@ ProfileMap::Get(const char *key, bool &value) const
 bool
 ProfileMap::Get(const char *key, unsigned &value) const
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a unsigned number
-  char *endptr;
-  unsigned tmp = ParseUnsigned(str, &endptr, 0);
-  if (endptr == str)
+  const Item *item = Find(key);
+  if (item == nullptr || !item->has_integer)
     return false;
 
-  // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = (unsigned)item->integer;
   return true;
 }
 
@@ -119,46 +94,14 @@ ProfileMap::Get(const char *key, uint8_t &value) const
 bool
 ProfileMap::Get(const char *key, double &value) const
 {
-  // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a floating point number
-  char *endptr;
-  double tmp = ParseDouble(str, &endptr);
-  if (endptr == str)
+  const Item *item = Find(key);
+  if (item == nullptr || !item->has_real)
     return false;
 
-  // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = item->real;
   return true;
 }
 
-void
-ProfileMap::Set(const char *key, int value)
-{
-  char tmp[50];
-  sprintf(tmp, "%d", value);
-  Set(key, tmp);
-}
-
-void
-ProfileMap::Set(const char *key, long value)
-{
-  char tmp[50];
-  sprintf(tmp, "%ld", value);
-  Set(key, tmp);
-}
-
-void
-ProfileMap::Set(const char *key, unsigned value)
-{
-  char tmp[50];
-  sprintf(tmp, "%u", value);
-  Set(key, tmp);
-}
-
 void
 ProfileMap::Set(const char *key, double value)
 {
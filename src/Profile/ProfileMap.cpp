@@ -140,5 +140,5 @@ Profile::Exists(const char *key)
 void
 Profile::Clear()
 {
-  map.clear();
+  map.Clear();
 }
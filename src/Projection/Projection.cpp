@@ -27,6 +27,10 @@ Copyright_License {
 
 #include <algorithm>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 Projection::Projection() noexcept
 {
   SetScale(1);
@@ -73,6 +77,96 @@ Projection::GeoToScreen(const GeoPoint &g) const noexcept
   return sc;
 }
 
+void
+Projection::GeoToScreen(const GeoPoint *src, PixelPoint *dest,
+                        std::size_t n) const noexcept
+{
+  assert(IsValid());
+
+  std::size_t i = 0;
+
+#ifdef __SSE2__
+  /* two points per iteration: only the cosine table lookups are
+     scalar, the rest is done in SSE2 registers; the rotation is
+     calculated with doubles, which is exact for all realistic screen
+     coordinates and therefore yields the same result as
+     FastIntegerRotation */
+
+  static_assert(sizeof(GeoPoint) == 2 * sizeof(double),
+                "Unexpected GeoPoint layout");
+  static_assert(sizeof(PixelPoint) == 2 * sizeof(int32_t),
+                "Unexpected PixelPoint layout");
+
+  const __m128d v_draw_scale = _mm_set1_pd(draw_scale);
+  const __m128d v_cos = _mm_set1_pd(screen_rotation.GetCos());
+  const __m128d v_sin = _mm_set1_pd(screen_rotation.GetSin());
+  const __m128i v_half = _mm_set1_epi32(FastIntegerRotation::HALF);
+  const __m128i v_origin_x = _mm_set1_epi32(screen_origin.x);
+  const __m128i v_origin_y = _mm_set1_epi32(screen_origin.y);
+  const __m128d v_location_lon = _mm_set1_pd(geo_location.longitude.Native());
+  const __m128d v_location_lat = _mm_set1_pd(geo_location.latitude.Native());
+  const __m128d v_half_circle = _mm_set1_pd(Angle::HalfCircle().Native());
+  const __m128d v_quarter_circle =
+    _mm_set1_pd(Angle::QuarterCircle().Native());
+  const __m128d v_abs_mask =
+    _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+
+  for (; i + 2 <= n; i += 2) {
+    const __m128d a = _mm_loadu_pd((const double *)(src + i));
+    const __m128d b = _mm_loadu_pd((const double *)(src + i + 1));
+    const __m128d lon = _mm_unpacklo_pd(a, b);
+    const __m128d lat = _mm_unpackhi_pd(a, b);
+
+    __m128d d_lon = _mm_sub_pd(v_location_lon, lon);
+    __m128d d_lat = _mm_sub_pd(v_location_lat, lat);
+
+    /* GeoPoint::Normalize() would modify this difference (date
+       line, poles): let the scalar code handle this rare case */
+    const __m128d unusual =
+      _mm_or_pd(_mm_or_pd(_mm_cmple_pd(d_lon, _mm_sub_pd(_mm_setzero_pd(),
+                                                         v_half_circle)),
+                          _mm_cmpgt_pd(d_lon, v_half_circle)),
+                _mm_cmpgt_pd(_mm_and_pd(d_lat, v_abs_mask),
+                             v_quarter_circle));
+    if (_mm_movemask_pd(unusual) != 0) {
+      const GeoPoint d0 = geo_location - src[i];
+      const GeoPoint d1 = geo_location - src[i + 1];
+      d_lon = _mm_set_pd(d1.longitude.Native(), d0.longitude.Native());
+      d_lat = _mm_set_pd(d1.latitude.Native(), d0.latitude.Native());
+    }
+
+    const __m128d lat_cos = _mm_set_pd(src[i + 1].latitude.fastcosine(),
+                                       src[i].latitude.fastcosine());
+
+    /* truncate to integer, just like the int() casts in the scalar
+       version */
+    const __m128d x =
+      _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_mul_pd(lat_cos,
+                                                  _mm_mul_pd(d_lon, v_draw_scale))));
+    const __m128d y =
+      _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_mul_pd(d_lat, v_draw_scale)));
+
+    const __m128i raw_x =
+      _mm_cvtpd_epi32(_mm_sub_pd(_mm_mul_pd(x, v_cos), _mm_mul_pd(y, v_sin)));
+    const __m128i raw_y =
+      _mm_cvtpd_epi32(_mm_add_pd(_mm_mul_pd(y, v_cos), _mm_mul_pd(x, v_sin)));
+
+    const __m128i rx =
+      _mm_srai_epi32(_mm_add_epi32(raw_x, v_half), FastIntegerRotation::SHIFT);
+    const __m128i ry =
+      _mm_srai_epi32(_mm_add_epi32(raw_y, v_half), FastIntegerRotation::SHIFT);
+
+    const __m128i sx = _mm_sub_epi32(v_origin_x, rx);
+    const __m128i sy = _mm_add_epi32(v_origin_y, ry);
+
+    _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi32(sx, sy));
+  }
+#endif
+
+  for (; i < n; ++i)
+    dest[i] = GeoToScreen(src[i]);
+}
+
 void
 Projection::SetScale(const double _scale) noexcept
 {
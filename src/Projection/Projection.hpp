@@ -29,7 +29,10 @@ Copyright_License {
 #include "Math/Util.hpp"
 #include "ui/dim/Point.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 /**
  * This is a class that can be used for converting geographical into screen
@@ -140,6 +143,34 @@ public:
   [[gnu::pure]]
   PixelPoint GeoToScreen(const GeoPoint &g) const noexcept;
 
+  /**
+   * Converts an array of GeoPoints to screen coordinates.  The
+   * result is the same as calling GeoToScreen() for each element,
+   * but the arithmetic is vectorised where the CPU supports it.
+   */
+  void GeoToScreen(const GeoPoint *src, PixelPoint *dest,
+                   std::size_t n) const noexcept;
+
+  /**
+   * Same as above, but for other point types, e.g. #BulkPixelPoint.
+   */
+  template<typename P>
+  void GeoToScreen(const GeoPoint *src, P *dest,
+                   std::size_t n) const noexcept {
+    constexpr std::size_t CHUNK = 64;
+    PixelPoint buffer[CHUNK];
+
+    while (n > 0) {
+      const std::size_t chunk = std::min(n, CHUNK);
+      GeoToScreen(src, buffer, chunk);
+      std::copy_n(buffer, chunk, dest);
+
+      src += chunk;
+      dest += chunk;
+      n -= chunk;
+    }
+  }
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
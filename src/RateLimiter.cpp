@@ -27,7 +27,7 @@ Copyright_License {
 
 RateLimiter::RateLimiter(std::chrono::steady_clock::duration _period,
                          std::chrono::steady_clock::duration _delay) noexcept
-  :period(_period - _delay), delay(_delay)
+  :period(_period - _delay), delay(_delay), slack(_period / 4)
 {
   assert(_period >= _delay);
 }
@@ -43,7 +43,9 @@ RateLimiter::Trigger()
   if (elapsed.count() >= 0 && elapsed < period)
     schedule += period - elapsed;
 
-  timer.Schedule(schedule);
+  /* this is not punctual work; allow it to share a wakeup with
+     other timers */
+  timer.Schedule(schedule, slack);
 }
 
 void
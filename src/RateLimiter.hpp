@@ -45,6 +45,12 @@ class RateLimiter {
 
   std::chrono::steady_clock::duration period, delay;
 
+  /**
+   * How much may the timer be postponed to share a wakeup with other
+   * timers?
+   */
+  std::chrono::steady_clock::duration slack;
+
 public:
   /**
    * Constructor.
@@ -76,6 +76,8 @@ AirspaceRenderer::Draw(Canvas &canvas,
   if (airspaces == nullptr || airspaces->IsEmpty())
     return;
 
+  shapes.Update(*airspaces, projection);
+
   DrawInternal(canvas,
 #ifndef ENABLE_OPENGL
                stencil_canvas,
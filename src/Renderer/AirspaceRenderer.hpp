@@ -24,6 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_RENDERER_HPP
 #define XCSOAR_AIRSPACE_RENDERER_HPP
 
+#include "AirspaceShapeCache.hpp"
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
 #include "util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
@@ -53,6 +54,11 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
+  /**
+   * Polygons simplified for the current map scale.
+   */
+  AirspaceShapeCache shapes;
+
 #ifndef ENABLE_OPENGL
   /**
    * This object caches the airspace fill.  This avoids drawing it
@@ -81,6 +87,7 @@ public:
 
   void SetAirspaces(const Airspaces *_airspaces) {
     airspaces = _airspaces;
+    shapes.Clear();
   }
 
   void SetAirspaceWarnings(const ProtectedAirspaceWarningManager *_warning_manager) {
@@ -89,6 +96,7 @@ public:
 
   void Clear() {
     airspaces = nullptr;
+    shapes.Clear();
     warning_manager = nullptr;
   }
 
@@ -116,7 +124,7 @@ private:
   void DrawOutline(Canvas &canvas,
                    const WindowProjection &projection,
                    const AirspaceRendererSettings &settings,
-                   const AirspacePredicate &visible) const;
+                   const AirspacePredicate &visible);
 #endif
 
   void DrawInternal(Canvas &canvas,
@@ -42,15 +42,18 @@ class AirspaceVisitorRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspaceShapeCache &shapes;
 
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceShapeCache &_shapes)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     shapes(_shapes)
   {
     glStencilMask(0xff);
     glClear(GL_STENCIL_BUFFER_BIT);
@@ -100,7 +103,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    const auto &shape = shapes.Get(airspace);
+    if (!PreparePolygon(shape.points, shape.bounds))
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -220,15 +224,18 @@ class AirspaceFillRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  AirspaceShapeCache &shapes;
 
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
-                       const AirspaceRendererSettings &_settings)
+                       const AirspaceRendererSettings &_settings,
+                       AirspaceShapeCache &_shapes)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     shapes(_shapes)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   }
@@ -249,7 +256,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    const auto &shape = shapes.Get(airspace);
+    if (!PreparePolygon(shape.points, shape.bounds))
       return;
 
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
@@ -319,14 +327,16 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings,
+                                  shapes);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings,
+                                     shapes);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
@@ -50,14 +50,16 @@ class AirspaceVisitorMap final
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warnings;
+  AirspaceShapeCache &shapes;
 
 public:
   AirspaceVisitorMap(StencilMapCanvas &_helper,
                      const AirspaceWarningCopy &_warnings,
                      const AirspaceRendererSettings &_settings,
-                     const AirspaceLook &_airspace_look)
+                     const AirspaceLook &_airspace_look,
+                     AirspaceShapeCache &_shapes)
     :StencilMapCanvas(_helper),
-     look(_airspace_look), warnings(_warnings)
+     look(_airspace_look), warnings(_warnings), shapes(_shapes)
   {
     switch (settings.fill_mode) {
     case AirspaceRendererSettings::FillMode::DEFAULT:
@@ -80,7 +82,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawSearchPointVector(airspace.GetPoints());
+    const auto &shape = shapes.Get(airspace);
+    DrawPolygon(shape.points, shape.bounds);
   }
 
 public:
@@ -155,14 +158,16 @@ class AirspaceOutlineRenderer final
 {
   const AirspaceLook &look;
   const AirspaceRendererSettings &settings;
+  AirspaceShapeCache &shapes;
 
 public:
   AirspaceOutlineRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceShapeCache &_shapes)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), settings(_settings)
+     look(_look), settings(_settings), shapes(_shapes)
   {
     if (settings.black_outline)
       canvas.SelectBlackPen();
@@ -190,7 +195,9 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawPolygon(airspace.GetPoints());
+    const auto &shape = shapes.Get(airspace);
+    if (PreparePolygon(shape.points, shape.bounds))
+      DrawPrepared();
   }
 
 public:
@@ -220,7 +227,7 @@ AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
   StencilMapCanvas helper(buffer_canvas, stencil_canvas, projection,
                           settings);
   AirspaceVisitorMap v(helper, awc, settings,
-                       look);
+                       look, shapes);
 
   // JMW TODO wasteful to draw twice, can't it be drawn once?
   // we are using two draws so borders go on top of everything
@@ -274,13 +281,14 @@ inline void
 AirspaceRenderer::DrawOutline(Canvas &canvas,
                               const WindowProjection &projection,
                               const AirspaceRendererSettings &settings,
-                              const AirspacePredicate &visible) const
+                              const AirspacePredicate &visible)
 {
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
-  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings);
+  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings,
+                                           shapes);
   for (const auto &i : range) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
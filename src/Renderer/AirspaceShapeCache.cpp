@@ -0,0 +1,75 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceShapeCache.hpp"
+#include "Projection/Projection.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Geo/SimplifyPolygon.hpp"
+#include "Geo/FAISphere.hpp"
+
+#include <cmath>
+
+void
+AirspaceShapeCache::Update(const Airspaces &_airspaces,
+                           const Projection &projection) noexcept
+{
+  const double new_tolerance =
+    std::exp2(std::floor(std::log2(0.5 / projection.GetScale())));
+
+  if (&_airspaces == airspaces && _airspaces.GetSerial() == serial &&
+      new_tolerance == tolerance)
+    return;
+
+  shapes.clear();
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+  tolerance = new_tolerance;
+}
+
+const AirspaceShapeCache::Shape &
+AirspaceShapeCache::Get(const AbstractAirspace &airspace) noexcept
+{
+  auto [i, inserted] = shapes.try_emplace(&airspace);
+  Shape &shape = i->second;
+  if (!inserted)
+    return shape;
+
+  const auto &src = airspace.GetPoints();
+  if (src.empty())
+    return shape;
+
+  shape.bounds = src.CalculateGeoBounds();
+
+  shape.points.reserve(src.size());
+  for (const auto &p : src)
+    shape.points.push_back(p.GetLocation());
+
+  const unsigned n =
+    SimplifyPolygon(shape.points.data(), shape.points.size(),
+                    FAISphere::EarthDistanceToAngle(tolerance));
+  shape.points.resize(n);
+  shape.points.shrink_to_fit();
+
+  return shape;
+}
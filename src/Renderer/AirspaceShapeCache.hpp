@@ -0,0 +1,85 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_SHAPE_CACHE_HPP
+#define XCSOAR_AIRSPACE_SHAPE_CACHE_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "util/Serial.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+class AbstractAirspace;
+class Airspaces;
+class Projection;
+
+/**
+ * Caches airspace polygons simplified for the current map scale.
+ * Dense airspace files contain far more vertices than can be seen
+ * on the screen; removing those once instead of clipping and
+ * projecting them in every frame makes the airspace layer a lot
+ * cheaper.
+ *
+ * The cache is flushed when the #Airspaces object is modified or
+ * when the map scale changes by more than a factor of two.
+ */
+class AirspaceShapeCache {
+public:
+  struct Shape {
+    GeoBounds bounds;
+    std::vector<GeoPoint> points;
+  };
+
+private:
+  std::unordered_map<const AbstractAirspace *, Shape> shapes;
+
+  const Airspaces *airspaces = nullptr;
+  Serial serial;
+
+  /**
+   * The simplification tolerance [m] of all cached shapes.  It is
+   * half a pixel, rounded down to a power of two.
+   */
+  double tolerance = 0;
+
+public:
+  /**
+   * Flush the cache if the airspaces or the scale have changed.
+   */
+  void Update(const Airspaces &_airspaces,
+              const Projection &projection) noexcept;
+
+  void Clear() noexcept {
+    shapes.clear();
+    airspaces = nullptr;
+  }
+
+  /**
+   * Returns the simplified polygon of the given airspace, creating
+   * it if it is not yet cached.  Circles are not supported.
+   */
+  const Shape &Get(const AbstractAirspace &airspace) noexcept;
+};
+
+#endif
@@ -100,7 +100,7 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
       chart.GetCanvas().SelectWhiteBrush();
     else
       chart.GetCanvas().SelectBlackBrush();
-    const auto &s = fs.altitude.GetSlots()[fs.altitude.GetCount()-1];
+    const auto &s = fs.altitude.GetSlots().back();
     chart.DrawDot(s.x, s.y, Layout::Scale(2));
   }
 
@@ -42,9 +42,8 @@ RenderFAISector(Canvas &canvas, const WindowProjection &projection,
     GeoClip(projection.GetScreenBounds().Scale(1.1))
     .ClipPolygon(clipped, geo_points, geo_end - geo_points);
 
-  BulkPixelPoint points[FAI_TRIANGLE_SECTOR_MAX], *p = points;
-  for (GeoPoint *geo_i = clipped; geo_i != clipped_end;)
-    *p++ = projection.GeoToScreen(*geo_i++);
+  BulkPixelPoint points[FAI_TRIANGLE_SECTOR_MAX];
+  projection.GeoToScreen(clipped, points, clipped_end - clipped);
 
-  canvas.DrawPolygon(points, p - points);
+  canvas.DrawPolygon(points, clipped_end - clipped);
 }
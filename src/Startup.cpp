@@ -34,6 +34,7 @@ Copyright_License {
 #include "InfoBoxes/InfoBoxManager.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Terrain/AsyncLoader.hpp"
+#include "Airspace/AsyncTerrainLoader.hpp"
 #include "Weather/Rasp/RaspStore.hpp"
 #include "Input/InputEvents.hpp"
 #include "Input/InputQueue.hpp"
@@ -93,7 +94,8 @@ Copyright_License {
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Operation/VerboseOperationEnvironment.hpp"
 #include "Operation/PluggableOperationEnvironment.hpp"
-#include "Operation/SubOperationEnvironment.hpp"
+#include "Job/Job.hpp"
+#include "Job/Graph.hpp"
 #include "Widget/ProgressWidget.hpp"
 #include "PageActions.hpp"
 #include "Weather/Features.hpp"
@@ -103,6 +105,11 @@ Copyright_License {
 #include "UIState.hpp"
 #include "Tracking/TrackingGlue.hpp"
 #include "Units/Units.hpp"
+
+#if defined(USE_POLL_EVENT) || defined(ANDROID)
+#include "ui/event/Globals.hpp"
+#include "ui/event/Queue.hpp"
+#endif
 #include "Formatter/UserGeoPointFormatter.hpp"
 #include "thread/Debug.hpp"
 
@@ -123,6 +130,9 @@ Copyright_License {
 #include "Android/NativeView.hpp"
 #endif
 
+#include <algorithm>
+#include <thread>
+
 static TaskManager *task_manager;
 static GlideComputerEvents *glide_computer_events;
 static AllMonitors *all_monitors;
@@ -223,6 +233,113 @@ try {
   LogError(std::current_exception(), "LoadTerrain failed");
 }
 
+void
+MainWindow::LoadAirspaceTerrain() noexcept
+{
+  delete airspace_terrain_loader;
+  airspace_terrain_loader = nullptr;
+
+  if (terrain == nullptr || airspace_database.IsEmpty())
+    return;
+
+  LogFormat("LoadAirspaceTerrain");
+  airspace_terrain_loader = new AsyncAirspaceTerrainLoader();
+  airspace_terrain_loader->Start(airspace_database, *terrain, file_cache,
+                                 Profile::GetPath(ProfileKeys::MapFile),
+                                 airspace_terrain_notify);
+}
+
+void
+MainWindow::OnAirspaceTerrainLoaded() noexcept
+try {
+  assert(airspace_terrain_loader != nullptr);
+
+  std::unique_ptr<AsyncAirspaceTerrainLoader>
+    loader{std::exchange(airspace_terrain_loader, nullptr)};
+
+  const ScopeSuspendAllThreads suspend;
+  const unsigned n = loader->Apply();
+  LogFormat("Airspace terrain: %u airspaces updated", n);
+} catch (...) {
+  LogError(std::current_exception(), "LoadAirspaceTerrain failed");
+}
+
+/**
+ * Load the data files which do not depend on each other
+ * concurrently.  Parsing is mostly bound by slow flash storage, and
+ * even on single-core devices, one file can be parsed while another
+ * one is being read.
+ */
+static void
+LoadDataFiles(AtmosphericPressure pressure, RaspStore &rasp,
+              OperationEnvironment &operation)
+{
+  class TopographyJob final : public Job {
+  public:
+    void Run(OperationEnvironment &env) override {
+      LoadConfiguredTopography(*topography, env);
+    }
+  } topography_job;
+
+  class WaypointsJob final : public Job {
+  public:
+    void Run(OperationEnvironment &env) override {
+      WaypointGlue::LoadWaypoints(way_points, nullptr, env);
+    }
+  } waypoints_job;
+
+  class WaypointDetailsJob final : public Job {
+  public:
+    void Run(OperationEnvironment &env) override {
+      WaypointDetails::ReadFileFromProfile(way_points, env);
+    }
+  } details_job;
+
+  class AirspaceJob final : public Job {
+    const AtmosphericPressure pressure;
+
+  public:
+    explicit AirspaceJob(AtmosphericPressure _pressure) noexcept
+      :pressure(_pressure) {}
+
+    void Run(OperationEnvironment &env) override {
+      ReadAirspace(airspace_database, pressure, env);
+    }
+  } airspace_job(pressure);
+
+  class RaspJob final : public Job {
+    RaspStore &rasp;
+
+  public:
+    explicit RaspJob(RaspStore &_rasp) noexcept:rasp(_rasp) {}
+
+    void Run(OperationEnvironment &) override {
+      rasp.ScanAll();
+    }
+  } rasp_job(rasp);
+
+  /* none of these jobs uses the terrain: it is loaded asynchronously
+     by MainWindow::LoadTerrain() and installed by the main event
+     loop, which doesn't run while this function blocks; airspace
+     ground levels are calculated by MainWindow::LoadAirspaceTerrain()
+     and waypoint elevations are updated when it becomes available */
+  JobGraph graph;
+  graph.Add(topography_job, 1);
+  const auto waypoints = graph.Add(waypoints_job, 1);
+  graph.Add(details_job, 1, {waypoints});
+  graph.Add(airspace_job, 1);
+  graph.Add(rasp_job, 0);
+
+  const unsigned n_threads =
+    std::clamp(std::thread::hardware_concurrency(), 2U, 4U);
+
+  try {
+    graph.Run(operation, n_threads);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load data files");
+  }
+}
+
 /**
  * "Boots" up XCSoar
  * @param lpCmdLine Command line string
@@ -391,24 +508,18 @@ Startup(UI::Display &display)
                          CommonInterface::SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
   topography = new TopographyStore();
-  {
-    SubOperationEnvironment sub_env(operation, 0, 256);
-    LoadConfiguredTopography(*topography, sub_env);
-  }
 
-  // Read the waypoint files
-  {
-    SubOperationEnvironment sub_env(operation, 256, 512);
-    WaypointGlue::LoadWaypoints(way_points, terrain, sub_env);
-  }
+  // Scan for weather forecast
+  LogFormat("RASP load");
+  auto rasp = std::make_shared<RaspStore>(LocalPath(_T(RASP_FILENAME)));
 
-  // Read and parse the airfield info file
-  {
-    SubOperationEnvironment sub_env(operation, 512, 768);
-    WaypointDetails::ReadFileFromProfile(way_points, sub_env);
-  }
+  // Read the topography, waypoint, airfield info and airspace files
+  LoadDataFiles(computer_settings.pressure, *rasp, operation);
+
+  /* this is a no-op unless the terrain has already been loaded;
+     else it will be done by DataGlobals::SetTerrain() */
+  main_window->LoadAirspaceTerrain();
 
   // Set the home waypoint
   WaypointGlue::SetHome(way_points, terrain,
@@ -420,18 +531,6 @@ Startup(UI::Display &display)
   device_blackboard->Merge();
   CommonInterface::ReadBlackboardBasic(device_blackboard->Basic());
 
-  // Scan for weather forecast
-  LogFormat("RASP load");
-  auto rasp = std::make_shared<RaspStore>(LocalPath(_T(RASP_FILENAME)));
-  rasp->ScanAll();
-
-  // Reads the airspace files
-  {
-    SubOperationEnvironment sub_env(operation, 768, 1024);
-    ReadAirspace(airspace_database, terrain, computer_settings.pressure,
-                 sub_env);
-  }
-
   {
     const AircraftState aircraft_state =
       ToAircraftState(device_blackboard->Basic(),
@@ -556,6 +655,27 @@ Startup(UI::Display &display)
   return true;
 }
 
+#if defined(USE_POLL_EVENT) || defined(ANDROID)
+
+/**
+ * Log how often the #EventLoop has woken up, to find wasteful timers
+ * on battery powered devices.
+ */
+static void
+LogEventLoopStats(const char *name, const EventLoop::Stats &stats) noexcept
+{
+  using namespace std::chrono;
+
+  LogFormat("%s event loop: %llu wakeups (%llu timeouts), busy %lld ms, max %lld us",
+            name,
+            (unsigned long long)stats.wakeups,
+            (unsigned long long)stats.timer_wakeups,
+            (long long)duration_cast<milliseconds>(stats.busy_total).count(),
+            (long long)duration_cast<microseconds>(stats.busy_max).count());
+}
+
+#endif
+
 void
 Shutdown()
 {
@@ -671,6 +791,8 @@ Shutdown()
 
   delete terrain_loader;
   terrain_loader = nullptr;
+  delete airspace_terrain_loader;
+  airspace_terrain_loader = nullptr;
   delete terrain;
   terrain = nullptr;
   delete topography;
@@ -747,5 +869,11 @@ Shutdown()
 
   Display::RestoreOrientation();
 
+#ifdef USE_POLL_EVENT
+  LogEventLoopStats("UI", UI::event_queue->GetEventLoop().GetStats());
+#elif defined(ANDROID)
+  LogEventLoopStats("UI", UI::event_queue->GetStats());
+#endif
+
   LogFormat("Finished shutdown");
 }
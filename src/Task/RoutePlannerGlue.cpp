@@ -26,9 +26,13 @@
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
 #include "Engine/Route/ReachResult.hpp"
 
+#include <functional>
+
 void
 RoutePlannerGlue::SetTerrain(const RasterTerrain *_terrain)
 {
+  InvalidateArrivalCache();
+
   terrain = _terrain;
   if (terrain) {
     RasterTerrain::Lease lease(*terrain);
@@ -59,6 +63,8 @@ RoutePlannerGlue::Solve(const AGeoPoint &origin,
                         const RoutePlannerConfig &config,
                         const int h_ceiling)
 {
+  InvalidateArrivalCache();
+
   RasterTerrain::Lease lease(*terrain);
   return planner.Solve(origin, destination, config, h_ceiling);
 }
@@ -68,6 +74,8 @@ RoutePlannerGlue::SolveReach(const AGeoPoint &origin,
                               const RoutePlannerConfig &config,
                               const int h_ceiling, const bool do_solve)
 {
+  InvalidateArrivalCache();
+
   if (terrain) {
     RasterTerrain::Lease lease(*terrain);
     planner.SolveReachTerrain(origin, config, h_ceiling, do_solve);
@@ -78,10 +86,35 @@ RoutePlannerGlue::SolveReach(const AGeoPoint &origin,
   }
 }
 
+std::size_t
+RoutePlannerGlue::ArrivalKeyHash::operator()(const AGeoPoint &p) const noexcept
+{
+  const std::hash<double> h;
+  std::size_t result = h(p.longitude.Native());
+  result = result * 31 + h(p.latitude.Native());
+  result = result * 31 + h(p.altitude);
+  return result;
+}
+
 std::optional<ReachResult>
 RoutePlannerGlue::FindPositiveArrival(const AGeoPoint &dest) const noexcept
 {
-  return planner.FindPositiveArrival(dest);
+  {
+    const std::lock_guard<Mutex> lock(arrival_cache_mutex);
+    auto i = arrival_cache.find(dest);
+    if (i != arrival_cache.end())
+      return i->second;
+  }
+
+  /* calculate outside of the lock; the planner is protected by the
+     caller's shared lease */
+  const auto result = planner.FindPositiveArrival(dest);
+
+  const std::lock_guard<Mutex> lock(arrival_cache_mutex);
+  if (arrival_cache.size() >= MAX_ARRIVAL_CACHE)
+    arrival_cache.clear();
+  arrival_cache.emplace(dest, result);
+  return result;
 }
 
 GeoPoint
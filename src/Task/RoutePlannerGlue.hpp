@@ -24,6 +24,11 @@
 #define ROUTE_PLANNER_GLUE_HPP
 
 #include "Route/AirspaceRoute.hpp"
+#include "Route/ReachResult.hpp"
+#include "thread/Mutex.hxx"
+
+#include <optional>
+#include <unordered_map>
 
 struct GlideSettings;
 class RasterTerrain;
@@ -33,6 +38,42 @@ class RoutePlannerGlue {
   const RasterTerrain *terrain;
   AirspaceRoute planner;
 
+  struct ArrivalKeyHash {
+    [[gnu::pure]]
+    std::size_t operator()(const AGeoPoint &p) const noexcept;
+  };
+
+  struct ArrivalKeyEqual {
+    [[gnu::pure]]
+    bool operator()(const AGeoPoint &a, const AGeoPoint &b) const noexcept {
+      return a.longitude == b.longitude && a.latitude == b.latitude &&
+        a.altitude == b.altitude;
+    }
+  };
+
+  /**
+   * The maximum number of entries in #arrival_cache; when it is
+   * full, it is flushed.
+   */
+  static constexpr std::size_t MAX_ARRIVAL_CACHE = 1024;
+
+  /**
+   * Protects #arrival_cache, because FindPositiveArrival() is called
+   * by several threads holding a shared lease.
+   */
+  mutable Mutex arrival_cache_mutex;
+
+  /**
+   * Results of FindPositiveArrival() for the current reach.  The
+   * map renderer, the map item list and the abort task all ask for
+   * the same landables, and the renderer repeats this for every
+   * frame; all of them are answered by one query per landable and
+   * calculation cycle.  Every modification of the planner clears
+   * this cache.
+   */
+  mutable std::unordered_map<AGeoPoint, std::optional<ReachResult>,
+                             ArrivalKeyHash, ArrivalKeyEqual> arrival_cache;
+
 public:
   RoutePlannerGlue():terrain(nullptr) {}
 
@@ -44,6 +85,7 @@ public:
                    const GlidePolar &safety_polar,
                    const SpeedVector &wind,
                    const int height_min_working) {
+    InvalidateArrivalCache();
     planner.UpdatePolar(settings, config, polar, safety_polar,
                         wind, height_min_working);
   }
@@ -58,10 +100,12 @@ public:
   }
 
   void ClearReach() {
+    InvalidateArrivalCache();
     planner.ClearReach();
   }
 
   void Reset() {
+    InvalidateArrivalCache();
     planner.Reset();
   }
 
@@ -76,7 +120,10 @@ public:
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   int h_ceiling, bool do_solve);
 
-  [[gnu::pure]]
+  /**
+   * Find the arrival height at the given destination.  Results are
+   * cached until the reach is solved again.
+   */
   std::optional<ReachResult> FindPositiveArrival(const AGeoPoint &dest) const noexcept;
 
   const FlatProjection &GetTerrainReachProjection() const {
@@ -94,6 +141,15 @@ public:
                         const AGeoPoint &destination) const;
 
   int GetTerrainBase() const;
+
+private:
+  /**
+   * Called by all methods which modify the planner.  No locking is
+   * needed, because those run with an exclusive lease.
+   */
+  void InvalidateArrivalCache() noexcept {
+    arrival_cache.clear();
+  }
 };
 
 #endif
@@ -26,6 +26,7 @@ Copyright_License {
 #include "RasterProjection.hpp"
 #include "ZzipStream.hpp"
 #include "WorldFile.hpp"
+#include "io/ZipArchive.hpp"
 #include "Operation/Operation.hpp"
 #include "system/ConvertPathName.hpp"
 #include "util/ScopeExit.hxx"
@@ -248,9 +249,9 @@ LoadJPG2000(jas_stream_t *in, void *loader)
 }
 
 inline void
-TerrainLoader::LoadJPG2000(struct zzip_dir *dir, const char *path)
+TerrainLoader::LoadJPG2000(ZipArchive &archive, const char *path)
 {
-  const auto in = OpenJasperZzipStream(dir, path);
+  const auto in = OpenJasperZipStream(archive, path);
   AtScopeExit(in) { jas_stream_close(in); };
   env.SetProgressRange(jas_stream_length(in) / 65536);
   ::LoadJPG2000(in, this);
@@ -258,12 +259,12 @@ TerrainLoader::LoadJPG2000(struct zzip_dir *dir, const char *path)
 
 static bool
 LoadWorldFile(RasterTileCache &tile_cache,
-              struct zzip_dir *dir, const char *path)
+              ZipArchive &archive, const char *path)
 {
   if (path == nullptr)
     return false;
 
-  const auto new_bounds = LoadWorldFile(dir, path, tile_cache.GetSize().x,
+  const auto new_bounds = LoadWorldFile(archive.get(), path, tile_cache.GetSize().x,
                                         tile_cache.GetSize().y);
   bool success = new_bounds.IsValid();
   if (success)
@@ -272,7 +273,7 @@ LoadWorldFile(RasterTileCache &tile_cache,
 }
 
 inline void
-TerrainLoader::LoadOverview(struct zzip_dir *dir,
+TerrainLoader::LoadOverview(ZipArchive &archive,
                             const char *path, const char *world_file)
 {
   assert(scan_overview);
@@ -280,12 +281,12 @@ TerrainLoader::LoadOverview(struct zzip_dir *dir,
   raster_tile_cache.Reset();
 
   try {
-    LoadJPG2000(dir, path);
+    LoadJPG2000(archive, path);
 
     /* if we loaded the JPG2000 file successfully, but no bounds were
        obtained from there, try to load the world file "terrain.j2w" */
     if (!raster_tile_cache.bounds.IsValid() &&
-        !LoadWorldFile(raster_tile_cache, dir, world_file))
+        !LoadWorldFile(raster_tile_cache, archive, world_file))
       /* that failed: without bounds, we can't do anything; give up,
          discard the whole file */
       throw std::runtime_error("No bounds found");
@@ -296,7 +297,7 @@ TerrainLoader::LoadOverview(struct zzip_dir *dir,
 }
 
 void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     const char *path, const char *world_file,
                     RasterTileCache &raster_tile_cache,
                     bool all,
@@ -306,11 +307,11 @@ LoadTerrainOverview(struct zzip_dir *dir,
   SharedMutex mutex;
 
   TerrainLoader loader(mutex, raster_tile_cache, true, all, env);
-  loader.LoadOverview(dir, path, world_file);
+  loader.LoadOverview(archive, path, world_file);
 }
 
 inline void
-TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
+TerrainLoader::UpdateTiles(ZipArchive &archive, const char *path,
                            SignedRasterLocation p, unsigned radius)
 {
   assert(!scan_overview);
@@ -326,11 +327,11 @@ TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
   }
 
   AtScopeExit(this) { raster_tile_cache.FinishTileUpdate(); };
-  LoadJPG2000(dir, path);
+  LoadJPG2000(archive, path);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    SignedRasterLocation p, unsigned radius)
 {
@@ -339,18 +340,18 @@ UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
 
   NullOperationEnvironment env;
   TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
-  loader.UpdateTiles(dir, path, p, radius);
+  loader.UpdateTiles(archive, path, p, radius);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
                    const GeoPoint &location, double radius)
 {
   const auto raster_location = projection.ProjectCoarse(location);
 
-  UpdateTerrainTiles(dir, path, raster_tile_cache, mutex,
+  UpdateTerrainTiles(archive, path, raster_tile_cache, mutex,
                      raster_location,
                      projection.DistancePixelsCoarse(radius));
 }
@@ -29,7 +29,7 @@ Copyright_License {
 
 #include <cstdint>
 
-struct zzip_dir;
+class ZipArchive;
 struct GeoPoint;
 class RasterTileCache;
 class RasterProjection;
@@ -61,13 +61,13 @@ public:
   /**
    * Throws on error.
    */
-  void LoadOverview(struct zzip_dir *dir,
+  void LoadOverview(ZipArchive &archive,
                     const char *path, const char *world_file);
 
   /**
    * Throws on error.
    */
-  void UpdateTiles(struct zzip_dir *dir, const char *path,
+  void UpdateTiles(ZipArchive &archive, const char *path,
                    SignedRasterLocation p, unsigned radius);
 
   /* callback methods for libjasper (via jas_rtc.cpp) */
@@ -91,7 +91,7 @@ private:
   /**
    * Throws on error.
    */
-  void LoadJPG2000(struct zzip_dir *dir, const char *path);
+  void LoadJPG2000(ZipArchive &archive, const char *path);
 
   void ParseBounds(const char *data);
 };
@@ -104,18 +104,18 @@ private:
  * small RASP files only.
  */
 void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     const char *path, const char *world_file,
                     RasterTileCache &raster_tile_cache,
                     bool all,
                     OperationEnvironment &env);
 
 static inline void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     RasterTileCache &tile_cache,
                     OperationEnvironment &env)
 {
-  LoadTerrainOverview(dir, "terrain.jp2", "terrain.j2w",
+  LoadTerrainOverview(archive, "terrain.jp2", "terrain.j2w",
                       tile_cache, false, env);
 }
 
@@ -123,31 +123,31 @@ LoadTerrainOverview(struct zzip_dir *dir,
  * Throws on error.
  */
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    SignedRasterLocation p, unsigned radius);
 
 static inline void
-UpdateTerrainTiles(struct zzip_dir *dir,
+UpdateTerrainTiles(ZipArchive &archive,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
                    SignedRasterLocation p, unsigned radius)
 {
-  UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex, p, radius);
+  UpdateTerrainTiles(archive, "terrain.jp2", tile_cache, mutex, p, radius);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
                    const GeoPoint &location, double radius);
 
 static inline void
-UpdateTerrainTiles(struct zzip_dir *dir,
+UpdateTerrainTiles(ZipArchive &archive,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
                    const GeoPoint &location, double radius)
 {
-  UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
+  UpdateTerrainTiles(archive, "terrain.jp2", tile_cache, mutex,
                      projection, location, radius);
 }
 
@@ -76,7 +76,7 @@ RasterTerrain::Load(Path path, FileCache *cache,
     LogError(std::current_exception(), "Failed to load terrain cache");
   }
 
-  LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  LoadTerrainOverview(archive, map.GetTileCache(), operation);
 
   map.UpdateProjection();
 
@@ -119,7 +119,7 @@ RasterTerrain::UpdateTiles(const GeoPoint &location, double radius) noexcept
     return false;
 
   try {
-    UpdateTerrainTiles(archive.get(), tile_cache, mutex,
+    UpdateTerrainTiles(archive, tile_cache, mutex,
                        map.GetProjection(), location, radius);
   } catch (...) {
     LogError(std::current_exception(), "Failed to update terrain tiles");
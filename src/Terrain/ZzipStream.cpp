@@ -22,10 +22,17 @@ Copyright_License {
 */
 
 #include "ZzipStream.hpp"
+#include "io/ZipArchive.hpp"
 #include "util/RuntimeError.hxx"
 
 #include <zzip/util.h>
 
+#include <algorithm>
+#include <memory>
+
+#include <stdio.h>
+#include <string.h>
+
 static int
 jas_zzip_read(jas_stream_obj_t *obj, char *buf, unsigned cnt)
 {
@@ -85,3 +92,109 @@ OpenJasperZzipStream(struct zzip_dir *dir, const char *path)
 
   return stream;
 }
+
+/**
+ * Deflated members up to this size are inflated into memory; larger
+ * ones are streamed by zzip.
+ */
+static constexpr uint64_t MAX_INFLATE_SIZE = 4 * 1024 * 1024;
+
+struct JasperMemoryObject {
+  std::span<const std::byte> data;
+  std::size_t position = 0;
+
+  /**
+   * The inflated member; empty if #data points into the mapping.
+   */
+  AllocatedArray<std::byte> buffer;
+};
+
+static int
+jas_memory_read(jas_stream_obj_t *obj, char *buf, unsigned cnt)
+{
+  auto &m = *(JasperMemoryObject *)obj;
+
+  const std::size_t n = std::min<std::size_t>(cnt,
+                                              m.data.size() - m.position);
+  memcpy(buf, m.data.data() + m.position, n);
+  m.position += n;
+  return n;
+}
+
+static long
+jas_memory_seek(jas_stream_obj_t *obj, long offset, int origin)
+{
+  auto &m = *(JasperMemoryObject *)obj;
+
+  long base;
+  switch (origin) {
+  case SEEK_SET:
+    base = 0;
+    break;
+
+  case SEEK_CUR:
+    base = m.position;
+    break;
+
+  case SEEK_END:
+    base = m.data.size();
+    break;
+
+  default:
+    return -1;
+  }
+
+  const long position = base + offset;
+  if (position < 0 || (std::size_t)position > m.data.size())
+    return -1;
+
+  m.position = position;
+  return position;
+}
+
+static int
+jas_memory_close(jas_stream_obj_t *obj)
+{
+  delete (JasperMemoryObject *)obj;
+  return 0;
+}
+
+static constexpr jas_stream_ops_t memory_stream_ops = {
+  jas_memory_read,
+  jas_zzip_write,
+  jas_memory_seek,
+  jas_memory_close
+};
+
+jas_stream_t *
+OpenJasperZipStream(ZipArchive &archive, const char *path)
+{
+  const auto *entry = archive.FindEntry(path);
+  if (entry == nullptr ||
+      (!entry->IsStored() &&
+       (entry->method != ZipArchive::Entry::DEFLATED ||
+        entry->size > MAX_INFLATE_SIZE)))
+    return OpenJasperZzipStream(archive.get(), path);
+
+  auto obj = std::make_unique<JasperMemoryObject>();
+  if (entry->IsStored()) {
+    obj->data = archive.GetRawData(*entry);
+  } else {
+    obj->buffer = archive.Inflate(*entry);
+    obj->data = {obj->buffer.data(), obj->buffer.size()};
+  }
+
+  jas_stream_t *stream = jas_stream_create();
+  if (stream == nullptr)
+    throw std::runtime_error("jas_stream_create() failed");
+
+  stream->openmode_ = JAS_STREAM_READ|JAS_STREAM_BINARY;
+  stream->obj_ = obj.release();
+  stream->ops_ = const_cast<jas_stream_ops_t *>(&memory_stream_ops);
+
+  /* the data is in memory already, but JasPer reads byte by byte
+     through its buffer */
+  jas_stream_initbuf(stream, JAS_STREAM_FULLBUF, 0, 0);
+
+  return stream;
+}
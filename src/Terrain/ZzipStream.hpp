@@ -27,6 +27,7 @@ Copyright_License {
 #include "jasper/jas_stream.h"
 
 struct zzip_dir;
+class ZipArchive;
 
 /**
  * Throws on error.
@@ -34,4 +35,14 @@ struct zzip_dir;
 jas_stream_t *
 OpenJasperZzipStream(struct zzip_dir *dir, const char *path);
 
+/**
+ * Open a member of the archive as JasPer stream.  Stored members are
+ * read directly from the memory mapping, small deflated members are
+ * inflated into memory in one step; all others are read with zzip.
+ *
+ * Throws on error.
+ */
+jas_stream_t *
+OpenJasperZipStream(ZipArchive &archive, const char *path);
+
 #endif
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Batch.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "util/ByteOrder.hxx"
+#include "util/CRC.hpp"
+
+#include <cassert>
+#include <limits>
+
+namespace SkyLinesTracking {
+
+static constexpr int32_t
+ToMicroDegrees(Angle a) noexcept
+{
+  return int32_t(a.Degrees() * 1000000);
+}
+
+template<typename T>
+static constexpr bool
+FitsInto(int64_t value) noexcept
+{
+  return value >= std::numeric_limits<T>::min() &&
+    value <= std::numeric_limits<T>::max();
+}
+
+bool
+FixBatch::Append(uint32_t time, ::GeoPoint location,
+                 bool has_altitude, int altitude) noexcept
+{
+  assert(location.IsValid());
+
+  location.Normalize();
+  const int32_t latitude = ToMicroDegrees(location.latitude);
+  const int32_t longitude = ToMicroDegrees(location.longitude);
+
+  auto &packet = buffer.packet;
+
+  if (n_fixes == 0) {
+    packet.flags = has_altitude
+      ? ToBE32(FixBatchPacket::FLAG_ALTITUDE)
+      : 0;
+    packet.time = ToBE32(time);
+    packet.location.latitude = ToBE32(latitude);
+    packet.location.longitude = ToBE32(longitude);
+    packet.altitude = ToBE16(has_altitude ? altitude : 0);
+  } else {
+    if (IsFull() ||
+        has_altitude != ((packet.flags & ToBE32(FixBatchPacket::FLAG_ALTITUDE)) != 0) ||
+        time < last_time)
+      return false;
+
+    /* round the time to 1/10 seconds; the receiver reconstructs the
+       time stamp by adding up the deltas, and so do we */
+    const int64_t delta_time = (int64_t(time - last_time) + 50) / 100;
+    const int64_t delta_latitude = int64_t(latitude) - last_latitude;
+    const int64_t delta_longitude = int64_t(longitude) - last_longitude;
+    const int64_t delta_altitude = has_altitude
+      ? int64_t(altitude) - last_altitude
+      : 0;
+
+    if (!FitsInto<uint16_t>(delta_time) ||
+        !FitsInto<int16_t>(delta_latitude) ||
+        !FitsInto<int16_t>(delta_longitude) ||
+        !FitsInto<int16_t>(delta_altitude))
+      return false;
+
+    auto &delta = buffer.deltas[n_fixes - 1];
+    delta.time = ToBE16(delta_time);
+    delta.latitude = ToBE16(delta_latitude);
+    delta.longitude = ToBE16(delta_longitude);
+    delta.altitude = ToBE16(delta_altitude);
+
+    time = last_time + delta_time * 100;
+  }
+
+  last_time = time;
+  last_latitude = latitude;
+  last_longitude = longitude;
+  last_altitude = has_altitude ? altitude : 0;
+  ++n_fixes;
+  return true;
+}
+
+ConstBuffer<void>
+FixBatch::Finish(uint64_t key) noexcept
+{
+  assert(key != 0);
+  assert(!IsEmpty());
+
+  auto &packet = buffer.packet;
+  packet.header.magic = ToBE32(MAGIC);
+  packet.header.crc = 0;
+  packet.header.type = ToBE16(Type::FIX_BATCH);
+  packet.header.key = ToBE64(key);
+  packet.reserved = 0;
+  packet.fix_count = n_fixes;
+  packet.reserved2 = 0;
+
+  const std::size_t size = sizeof(packet) + (n_fixes - 1) * sizeof(FixDelta);
+  packet.header.crc = ToBE16(UpdateCRC16CCITT(&buffer, size, 0));
+  return {&buffer, size};
+}
+
+} /* namespace SkyLinesTracking */
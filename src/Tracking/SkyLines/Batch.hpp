@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRACKING_SKYLINES_BATCH_HPP
+#define XCSOAR_TRACKING_SKYLINES_BATCH_HPP
+
+#include "Protocol.hpp"
+#include "util/ConstBuffer.hxx"
+
+#include <cstdint>
+
+struct GeoPoint;
+
+namespace SkyLinesTracking {
+
+/**
+ * Collects GPS fixes and assembles a #FixBatchPacket from them.  Each
+ * fix after the first one is stored as a #FixDelta to the previous
+ * one, as the receiver will reconstruct it, so rounding errors do not
+ * accumulate.
+ */
+class FixBatch {
+  struct {
+    FixBatchPacket packet;
+    FixDelta deltas[FixBatchPacket::MAX_FIXES - 1];
+  } buffer;
+
+  unsigned n_fixes = 0;
+
+  /**
+   * The most recent fix (host byte order).
+   */
+  uint32_t last_time;
+  int32_t last_latitude, last_longitude;
+  int last_altitude;
+
+public:
+  bool IsEmpty() const noexcept {
+    return n_fixes == 0;
+  }
+
+  bool IsFull() const noexcept {
+    return n_fixes >= FixBatchPacket::MAX_FIXES;
+  }
+
+  unsigned size() const noexcept {
+    return n_fixes;
+  }
+
+  void Clear() noexcept {
+    n_fixes = 0;
+  }
+
+  /**
+   * Append a fix to this batch.
+   *
+   * @param time millisecond of day (UTC)
+   * @param altitude the altitude in m above MSL; ignored if
+   * #has_altitude is false
+   * @return false if the fix cannot be appended (because the batch
+   * is full, or because the difference to the previous fix does not
+   * fit into a #FixDelta); the caller shall send and clear this batch
+   * and try again
+   */
+  bool Append(uint32_t time, ::GeoPoint location,
+              bool has_altitude, int altitude) noexcept;
+
+  /**
+   * Fill in the header and return the datagram.  The batch remains
+   * unmodified; call Clear() after it has been sent.
+   *
+   * @return the datagram payload which remains valid until this
+   * object is modified
+   */
+  ConstBuffer<void> Finish(uint64_t key) noexcept;
+};
+
+} /* namespace SkyLinesTracking */
+
+#endif
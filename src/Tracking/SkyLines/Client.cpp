@@ -58,6 +58,7 @@ SkyLinesTracking::Client::Open(SocketAddress _address)
   Close();
 
   address = _address;
+  fix_batch_supported.store(false, std::memory_order_relaxed);
 
   {
     const std::lock_guard<Mutex> lock(mutex);
@@ -252,6 +253,7 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
   switch ((Type)FromBE16(header.type)) {
   case PING:
   case FIX:
+  case FIX_BATCH:
   case TRAFFIC_REQUEST:
   case USER_NAME_REQUEST:
   case WAVE_SUBMIT:
@@ -261,8 +263,12 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
     break;
 
   case ACK:
-    if (length >= sizeof(ack))
+    if (length >= sizeof(ack)) {
+      if (ack.flags & ToBE32(ACKPacket::FLAG_FIX_BATCH))
+        fix_batch_supported.store(true, std::memory_order_relaxed);
+
       handler->OnAck(FromBE16(ack.id));
+    }
     break;
 
   case TRAFFIC_RESPONSE:
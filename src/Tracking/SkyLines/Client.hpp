@@ -30,8 +30,10 @@ Copyright_License {
 #include "event/net/cares/SimpleResolver.hxx"
 #include "thread/Mutex.hxx"
 #include "util/Cancellable.hxx"
+#include "util/ConstBuffer.hxx"
 #include "util/Compiler.h"
 
+#include <atomic>
 #include <cstdint>
 #include <optional>
 
@@ -64,6 +66,13 @@ class Client final : Cares::SimpleHandler {
   UniqueSocketDescriptor socket;
   SocketEvent socket_event;
 
+  /**
+   * Has the server announced support for #FIX_BATCH?  This is set by
+   * the #ACK response to a #PING, and is reset when a new connection
+   * is opened.
+   */
+  std::atomic_bool fix_batch_supported{false};
+
 public:
   explicit Client(EventLoop &event_loop,
                   Handler *_handler=nullptr)
@@ -98,6 +107,15 @@ public:
     return socket.IsDefined();
   }
 
+  /**
+   * May FixBatch packets be sent to this server?  This is only ever
+   * true if a #Handler was passed to the constructor, because the
+   * #ACK would not be received otherwise.
+   */
+  bool IsFixBatchSupported() const noexcept {
+    return fix_batch_supported.load(std::memory_order_relaxed);
+  }
+
   uint64_t GetKey() const {
     return key;
   }
@@ -116,6 +134,11 @@ public:
     return socket.Write(&packet, sizeof(packet), address) == sizeof(packet);
   }
 
+  bool SendBuffer(ConstBuffer<void> buffer) {
+    const std::lock_guard<Mutex> lock(mutex);
+    return socket.Write(buffer.data, buffer.size, address) == ssize_t(buffer.size);
+  }
+
   void SendFix(const NMEAInfo &basic);
   void SendPing(uint16_t id);
 
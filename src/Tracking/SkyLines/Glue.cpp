@@ -31,15 +31,34 @@ Copyright_License {
 #include "io/async/GlobalAsioThread.hpp"
 #include "util/ByteOrder.hxx"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std::chrono;
 
 static constexpr auto CLOUD_INTERVAL = minutes(1);
 
+/**
+ * Don't sample fixes more often than this while on the ground.
+ */
+static constexpr auto GROUND_INTERVAL = minutes(1);
+
+/**
+ * Fixes are held back in a #FixBatch for at most this duration while
+ * flying with a working connection.
+ */
+static constexpr auto MIN_BATCH_DELAY = seconds(20);
+
+/**
+ * The upper limit for holding back fixes, used on the ground and
+ * after repeated send failures.
+ */
+static constexpr auto MAX_BATCH_DELAY = minutes(5);
+
 SkyLinesTracking::Glue::Glue(EventLoop &event_loop,
                              Handler *_handler)
   :client(event_loop, _handler),
+   batch_delay(MIN_BATCH_DELAY),
    cloud_client(event_loop, _handler)
 {
 }
@@ -72,8 +91,88 @@ SkyLinesTracking::Glue::IsConnected() const
   gcc_unreachable();
 }
 
+inline steady_clock::duration
+SkyLinesTracking::Glue::GetFixInterval(const DerivedInfo &calculated) const noexcept
+{
+  if (!calculated.flight.flying)
+    /* nobody watches a glider on the ground closely */
+    return std::max<steady_clock::duration>(interval, GROUND_INTERVAL);
+
+  return interval;
+}
+
+inline steady_clock::duration
+SkyLinesTracking::Glue::GetBatchDelay(const DerivedInfo &calculated) const noexcept
+{
+  if (!calculated.flight.flying)
+    return MAX_BATCH_DELAY;
+
+  if (GetNetState() == NetState::ROAMING)
+    /* each datagram is expensive while roaming */
+    return std::min<steady_clock::duration>(batch_delay * 2,
+                                            MAX_BATCH_DELAY);
+
+  return batch_delay;
+}
+
+void
+SkyLinesTracking::Glue::FlushBatch() noexcept
+{
+  if (batch.IsEmpty())
+    return;
+
+  if (client.SendBuffer(batch.Finish(client.GetKey()))) {
+    batch_delay = MIN_BATCH_DELAY;
+  } else {
+    /* the link is bad; back off, and keep the fixes for another
+       attempt unless there is no room for more */
+    batch_delay = std::min<steady_clock::duration>(batch_delay * 2,
+                                                   MAX_BATCH_DELAY);
+    if (!batch.IsFull())
+      return;
+  }
+
+  batch.Clear();
+}
+
+inline void
+SkyLinesTracking::Glue::BatchFix(const NMEAInfo &basic,
+                                 const DerivedInfo &calculated)
+{
+  assert(basic.time_available);
+  assert(basic.location_available);
+
+  const uint32_t time =
+    basic.time.Cast<::duration<uint32_t, milliseconds::period>>().count();
+
+  bool has_altitude = true;
+  int altitude = 0;
+  if (basic.baro_altitude_available)
+    altitude = int(basic.baro_altitude);
+  else if (basic.gps_altitude_available)
+    altitude = int(basic.gps_altitude);
+  else
+    has_altitude = false;
+
+  if (!batch.Append(time, basic.location, has_altitude, altitude)) {
+    /* doesn't fit; submit what we have and start a new batch (even
+       if submitting has failed) */
+    FlushBatch();
+    batch.Clear();
+    batch.Append(time, basic.location, has_altitude, altitude);
+  }
+
+  if (batch.size() == 1)
+    batch_start = basic.time;
+
+  if (batch.IsFull() ||
+      basic.time - batch_start >= GetBatchDelay(calculated))
+    FlushBatch();
+}
+
 inline void
-SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
+SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic,
+                                  const DerivedInfo &calculated)
 {
   assert(client.IsConnected());
 
@@ -82,8 +181,10 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
     return;
   }
 
+  const auto fix_interval = GetFixInterval(calculated);
+
   if (!IsConnected()) {
-    if (clock.CheckAdvance(basic.time, interval)) {
+    if (clock.CheckAdvance(basic.time, fix_interval)) {
       /* queue the packet, send it later */
       if (queue == nullptr)
         queue = new Queue();
@@ -94,6 +195,10 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
   }
 
   if (queue != nullptr) {
+    /* the pending batch is older than the queue; send it first */
+    FlushBatch();
+    batch.Clear();
+
     /* send queued fix packets, 8 at a time */
     unsigned n = 8;
     while (n-- > 0) {
@@ -109,8 +214,18 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
     }
 
     return;
-  } else if (clock.CheckAdvance(basic.time, interval))
+  }
+
+  if (!clock.CheckAdvance(basic.time, fix_interval))
+    return;
+
+  if (client.IsFixBatchSupported() && basic.location_available) {
+    BatchFix(basic, calculated);
+  } else {
+    FlushBatch();
+    batch.Clear();
     client.SendFix(basic);
+  }
 }
 
 void
@@ -172,7 +287,13 @@ SkyLinesTracking::Glue::Tick(const NMEAInfo &basic,
     return;
 
   if (client.IsConnected()) {
-    SendFixes(basic);
+    SendFixes(basic, calculated);
+
+    if (!client.IsFixBatchSupported() &&
+        ping_clock.CheckAdvance(basic.clock, minutes(5)))
+      /* ask the server whether it understands FIX_BATCH; the ACK
+         will tell */
+      client.SendPing(0);
 
     if (traffic_enabled &&
         traffic_clock.CheckAdvance(basic.clock, minutes(1)))
@@ -204,6 +325,7 @@ SkyLinesTracking::Glue::SetSettings(const Settings &settings)
   if (!settings.enabled || settings.key == 0) {
     delete queue;
     queue = nullptr;
+    batch.Clear();
     client.Close();
     return;
   }
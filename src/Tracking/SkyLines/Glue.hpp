@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_TRACKING_SKYLINES_GLUE_HPP
 
 #include "Client.hpp"
+#include "Batch.hpp"
 #include "time/GPSClock.hpp"
 #include "time/Stamp.hpp"
 
@@ -52,6 +53,29 @@ class Glue {
 
   Queue *queue = nullptr;
 
+  /**
+   * Fixes which have not been sent yet.  This is only used if the
+   * server supports #FIX_BATCH.
+   */
+  FixBatch batch;
+
+  /**
+   * The GPS time of the first fix in #batch.
+   */
+  TimeStamp batch_start = TimeStamp::Undefined();
+
+  /**
+   * How long may fixes be held back in #batch?  This doubles after
+   * each failure to send and is reset after a successful
+   * submission.
+   */
+  std::chrono::steady_clock::duration batch_delay;
+
+  /**
+   * Ask the server periodically whether it supports #FIX_BATCH.
+   */
+  GPSClock ping_clock;
+
   Client cloud_client;
   GPSClock cloud_clock;
 
@@ -73,7 +97,18 @@ private:
   gcc_pure
   bool IsConnected() const;
 
-  void SendFixes(const NMEAInfo &basic);
+  gcc_pure
+  std::chrono::steady_clock::duration
+  GetFixInterval(const DerivedInfo &calculated) const noexcept;
+
+  gcc_pure
+  std::chrono::steady_clock::duration
+  GetBatchDelay(const DerivedInfo &calculated) const noexcept;
+
+  void FlushBatch() noexcept;
+  void BatchFix(const NMEAInfo &basic, const DerivedInfo &calculated);
+
+  void SendFixes(const NMEAInfo &basic, const DerivedInfo &calculated);
   void SendCloudFix(const NMEAInfo &basic, const DerivedInfo &calculated);
 };
 
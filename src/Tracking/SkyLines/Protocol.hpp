@@ -101,6 +101,11 @@ enum Type {
    * @see #ThermalResponsePacket
    */
   THERMAL_RESPONSE = 13,
+
+  /**
+   * @see #FixBatchPacket
+   */
+  FIX_BATCH = 14,
 };
 
 /**
@@ -176,6 +181,13 @@ struct ACKPacket {
    */
   static const uint32_t FLAG_BAD_KEY = 0x1;
 
+  /**
+   * The server understands #FIX_BATCH.  Clients must not send
+   * #FixBatchPacket unless they have seen this flag in the response
+   * to a #PING.
+   */
+  static const uint32_t FLAG_FIX_BATCH = 0x2;
+
   Header header;
 
   /**
@@ -271,6 +283,92 @@ struct FixPacket {
 static_assert(sizeof(FixPacket) == 48, "Wrong struct size");
 #endif
 
+/**
+ * Several GPS fixes in one datagram (#FIX_BATCH).  Only time,
+ * location and altitude are transmitted.  The first fix is stored in
+ * this struct, and each following fix is a #FixDelta relative to its
+ * predecessor.
+ *
+ * This packet is only sent to servers which have announced support
+ * with ACKPacket::FLAG_FIX_BATCH.
+ */
+struct FixBatchPacket {
+  /**
+   * All fixes in this batch have an altitude.  This is the same bit
+   * as FixPacket::FLAG_ALTITUDE.
+   */
+  static const uint32_t FLAG_ALTITUDE = 0x10;
+
+  /**
+   * The maximum value of #fix_count.
+   */
+  static constexpr unsigned MAX_FIXES = 64;
+
+  Header header;
+
+  uint32_t flags;
+
+  /**
+   * Millisecond of day (UTC) of the first fix.  May be bigger than
+   * 24*60*60*1000 if the flight has wrapped midnight.
+   */
+  uint32_t time;
+
+  /**
+   * Location of the first fix.
+   */
+  GeoPoint location;
+
+  /**
+   * Altitude of the first fix in m above MSL.
+   */
+  int16_t altitude;
+
+  /**
+   * Reserved for future use.  Set to zero.
+   */
+  uint8_t reserved;
+
+  /**
+   * The total number of fixes in this batch, including the first
+   * one.  It is followed by (fix_count - 1) #FixDelta instances.
+   */
+  uint8_t fix_count;
+
+  /**
+   * Reserved for future use.  Set to zero.
+   */
+  uint32_t reserved2;
+
+  /* followed by a number of #FixDelta instances */
+};
+
+/**
+ * The difference between a fix in a #FixBatchPacket and its
+ * predecessor.
+ */
+struct FixDelta {
+  /**
+   * Time since the previous fix in 1/10 seconds.
+   */
+  uint16_t time;
+
+  /**
+   * Location change in micro degrees.
+   */
+  int16_t latitude, longitude;
+
+  /**
+   * Altitude change in m.
+   */
+  int16_t altitude;
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(FixBatchPacket) == 40, "Wrong struct size");
+static_assert(sizeof(FixDelta) == 8, "Wrong struct size");
+#endif
+
 /**
  * The client requests traffic information.
  */
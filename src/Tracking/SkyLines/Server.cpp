@@ -29,6 +29,7 @@ Copyright_License {
 #include "net/SocketError.hxx"
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC.hpp"
+#include "Geo/GeoPoint.hpp"
 
 static UniqueSocketDescriptor
 CreateBindUDP(SocketAddress address)
@@ -62,7 +63,8 @@ void
 Server::SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept
 {
   try {
-    ssize_t nbytes = socket.GetSocket().Write(buffer.data, buffer.size);
+    ssize_t nbytes = socket.GetSocket().Write(buffer.data, buffer.size,
+                                              address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
   } catch (...) {
@@ -73,7 +75,48 @@ Server::SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept
 void
 Server::OnPing(const Client &client, unsigned id)
 {
-  SendPacket(client.address, MakeAck(client.key, id, 0));
+  SendPacket(client.address,
+             MakeAck(client.key, id, ACKPacket::FLAG_FIX_BATCH));
+}
+
+inline void
+Server::OnFixBatch(const Client &client,
+                   const FixBatchPacket &packet, size_t length)
+{
+  if (length < sizeof(packet))
+    return;
+
+  const unsigned n = packet.fix_count;
+  if (n == 0 || n > FixBatchPacket::MAX_FIXES)
+    return;
+
+  const ConstBuffer<FixDelta> deltas((const FixDelta *)(&packet + 1), n - 1);
+  if (length != sizeof(packet) + deltas.size * sizeof(FixDelta))
+    return;
+
+  const bool has_altitude =
+    packet.flags & ToBE32(FixBatchPacket::FLAG_ALTITUDE);
+
+  uint32_t time = FromBE32(packet.time);
+  int32_t latitude = FromBE32(packet.location.latitude);
+  int32_t longitude = FromBE32(packet.location.longitude);
+  int altitude = (int16_t)FromBE16(packet.altitude);
+
+  for (unsigned i = 0;; ++i) {
+    OnFix(client, std::chrono::milliseconds(time),
+          ::GeoPoint(Angle::Degrees(longitude / 1000000.),
+                     Angle::Degrees(latitude / 1000000.)),
+          has_altitude ? altitude : -1);
+
+    if (i == deltas.size)
+      break;
+
+    const FixDelta &delta = deltas[i];
+    time += FromBE16(delta.time) * 100u;
+    latitude += (int16_t)FromBE16(delta.latitude);
+    longitude += (int16_t)FromBE16(delta.longitude);
+    altitude += (int16_t)FromBE16(delta.altitude);
+  }
 }
 
 inline void
@@ -95,6 +138,7 @@ Server::OnDatagramReceived(Client &&client,
 
   const auto &ping = *(const PingPacket *)data;
   const auto &fix = *(const FixPacket *)data;
+  const auto &fix_batch = *(const FixBatchPacket *)data;
   const auto &traffic = *(const TrafficRequestPacket *)data;
   const auto &user_name = *(const UserNameRequestPacket *)data;
   const auto &wave = ((const WaveSubmitPacket *)data)->wave;
@@ -122,6 +166,10 @@ Server::OnDatagramReceived(Client &&client,
           : -1);
     break;
 
+  case FIX_BATCH:
+    OnFixBatch(client, fix_batch, length);
+    break;
+
   case TRAFFIC_REQUEST:
     if (length < sizeof(traffic))
       return;
@@ -37,6 +37,8 @@ struct GeoPoint;
 
 namespace SkyLinesTracking {
 
+struct FixBatchPacket;
+
 /**
  * A server for the SkyLines live tracking protocol.
  *
@@ -71,6 +73,14 @@ public:
     return socket.GetEventLoop();
   }
 
+  /**
+   * Returns the address the socket is bound to.  This is useful to
+   * find out the port number after binding to port 0.
+   */
+  StaticSocketAddress GetLocalAddress() const noexcept {
+    return socket.GetSocket().GetLocalAddress();
+  }
+
   void SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept;
 
   template<typename P>
@@ -79,12 +89,22 @@ public:
   }
 
 private:
+  void OnFixBatch(const Client &client,
+                  const FixBatchPacket &packet, size_t length);
   void OnDatagramReceived(Client &&client, void *data, size_t length);
   void OnSocketReady(unsigned events) noexcept;
 
 protected:
+  /**
+   * The default implementation responds with #ACK, announcing
+   * support for #FIX_BATCH.
+   */
   virtual void OnPing(const Client &client, unsigned id);
 
+  /**
+   * A fix was received.  The fixes of a #FixBatchPacket are passed
+   * to this method one by one, in chronological order.
+   */
   virtual void OnFix(const Client &client,
                      std::chrono::milliseconds time_of_day,
                      const ::GeoPoint &location, int altitude) {}
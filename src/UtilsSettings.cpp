@@ -159,9 +159,13 @@ SettingsLeave(const UISettings &old_ui_settings)
       glide_computer->ClearAirspaces();
 
     airspace_database.Clear();
-    ReadAirspace(airspace_database, terrain,
+
+    /* ground levels are calculated by LoadAirspaceTerrain() in
+       background */
+    ReadAirspace(airspace_database,
                  CommonInterface::GetComputerSettings().pressure,
                  operation);
+    main_window.LoadAirspaceTerrain();
   }
 
   if (DevicePortChanged)
@@ -24,17 +24,14 @@ Copyright_License {
 #include "RaspCache.hpp"
 #include "RaspStore.hpp"
 #include "Terrain/RasterMap.hpp"
-#include "Terrain/Loader.hpp"
 #include "Language/Language.hpp"
-#include "system/Path.hpp"
-#include "io/ZipArchive.hpp"
-#include "LogFile.hpp"
 
 #include <cassert>
-#include <windef.h> // for MAX_PATH
 
-RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter) noexcept
-  :store(_store), parameter(_parameter) {}
+RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter,
+                     std::function<void()> &&callback) noexcept
+  :store(_store), parameter(_parameter),
+   loader(_store, _parameter, std::move(callback)) {}
 
 RaspCache::~RaspCache() noexcept = default;
 
@@ -81,7 +78,7 @@ RaspCache::IsInside(GeoPoint p) const
 }
 
 void
-RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
+RaspCache::Reload(BrokenTime time_local) noexcept
 {
   unsigned effective_time = time;
   if (effective_time == 0) {
@@ -99,33 +96,20 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
     // no change, quick exit.
     return;
 
-  last_time = effective_time;
-
-  effective_time = store.GetNearestTime(parameter, effective_time);
-  if (effective_time == RaspStore::MAX_WEATHER_TIMES)
-    return;
-
-  map.reset();
-
-  auto archive = store.OpenArchive();
-  if (!archive)
-    return;
-
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
-
-  auto new_map = std::make_unique<RasterMap>();
-  try {
-    LoadTerrainOverview(archive->get(), new_name, nullptr,
-                        new_map->GetTileCache(),
-                        true, operation);
-  } catch (...) {
-    LogError(std::current_exception(), "Failed to load RASP file");
+  const unsigned nearest_time =
+    store.GetNearestTime(parameter, effective_time);
+  if (nearest_time == RaspStore::MAX_WEATHER_TIMES) {
+    last_time = effective_time;
+    map.reset();
+    ++serial;
     return;
   }
 
-  new_map->UpdateProjection();
+  if (!loader.Get(nearest_time, map))
+    /* not loaded yet; try again when the loader thread has
+       finished */
+    return;
 
-  map = std::move(new_map);
+  last_time = effective_time;
+  ++serial;
 }
@@ -24,6 +24,10 @@ Copyright_License {
 #ifndef XCSOAR_WEATHER_RASP_CACHE_HPP
 #define XCSOAR_WEATHER_RASP_CACHE_HPP
 
+#include "RaspLoader.hpp"
+#include "util/Serial.hpp"
+
+#include <functional>
 #include <memory>
 
 #include <tchar.h>
@@ -32,11 +36,11 @@ struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
 class RasterMap;
-class OperationEnvironment;
 
 /**
  * Class to manage the raster weather map, to be loaded/selected from
- * a #RaspStore instance.
+ * a #RaspStore instance.  The maps are decoded by a #RaspLoader
+ * thread.
  */
 class RaspCache {
   const RaspStore &store;
@@ -46,10 +50,26 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  std::unique_ptr<RasterMap> map;
+  RaspLoader loader;
+
+  /**
+   * The map being displayed.  While the map for a new time is being
+   * loaded, the previous one remains here.
+   */
+  std::shared_ptr<const RasterMap> map;
+
+  /**
+   * Incremented each time #map is replaced.
+   */
+  Serial serial;
 
 public:
-  RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
+  /**
+   * @param callback invoked in the loader thread when a map has been
+   * loaded and Reload() should be called again
+   */
+  RaspCache(const RaspStore &_store, unsigned _parameter,
+            std::function<void()> &&callback) noexcept;
   ~RaspCache() noexcept;
 
   const RaspStore &GetStore() const {
@@ -61,6 +81,10 @@ public:
     return map.get();
   }
 
+  const Serial &GetSerial() const {
+    return serial;
+  }
+
   /**
    * Returns the current map's name.
    */
@@ -86,9 +110,13 @@ public:
   bool IsInside(GeoPoint p) const;
 
   /**
-   * @param day_time the local time, in seconds since midnight
+   * Select the map for the current time.  This does not block; if
+   * the map has not been loaded yet, the loader thread is asked to
+   * load it, and the previous map remains until it is finished.
+   *
+   * @param time_local the current local time
    */
-  void Reload(BrokenTime time_local, OperationEnvironment &operation);
+  void Reload(BrokenTime time_local) noexcept;
 
   /**
    * Returns the current time index.
@@ -0,0 +1,152 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RaspLoader.hpp"
+#include "RaspStore.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Path.hpp"
+#include "io/ZipArchive.hpp"
+#include "LogFile.hpp"
+
+#include <windef.h> // for MAX_PATH
+
+RaspLoader::RaspLoader(const RaspStore &_store, unsigned _parameter,
+                       std::function<void()> &&_callback) noexcept
+  :StandbyThread("RASP"),
+   store(_store), parameter(_parameter),
+   callback(std::move(_callback)) {}
+
+RaspLoader::~RaspLoader() noexcept
+{
+  LockStop();
+}
+
+bool
+RaspLoader::Get(unsigned time_index,
+                std::shared_ptr<const RasterMap> &map_r) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  Schedule(time_index);
+
+  const auto *map = cache.Get(time_index);
+  if (map == nullptr)
+    return false;
+
+  map_r = *map;
+  return true;
+}
+
+void
+RaspLoader::Schedule(unsigned time_index) noexcept
+{
+  StaticArray<unsigned, PREFETCH> prefetch;
+  unsigned n = 0;
+  for (unsigned i = time_index + 1;
+       i < RaspStore::MAX_WEATHER_TIMES && n < PREFETCH; ++i) {
+    if (!store.IsTimeAvailable(parameter, i))
+      continue;
+
+    ++n;
+    if (cache.Get(i) == nullptr)
+      prefetch.append(i);
+  }
+
+  /* look up the requested map last, so it becomes the most recently
+     used one and the prefetched ones are evicted first */
+  queue.clear();
+  if (cache.Get(time_index) == nullptr)
+    queue.append(time_index);
+
+  for (const unsigned i : prefetch)
+    queue.append(i);
+
+  if (!queue.empty())
+    Trigger();
+}
+
+std::shared_ptr<const RasterMap>
+RaspLoader::Load(unsigned time_index) const noexcept
+{
+  auto archive = store.OpenArchive();
+  if (!archive)
+    return nullptr;
+
+  char name[MAX_PATH];
+  store.NarrowWeatherFilename(name, Path(store.GetItemInfo(parameter).name),
+                              time_index);
+
+  auto map = std::make_shared<RasterMap>();
+  try {
+    NullOperationEnvironment operation;
+    LoadTerrainOverview(*archive, name, nullptr,
+                        map->GetTileCache(),
+                        true, operation);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load RASP file");
+    return nullptr;
+  }
+
+  map->UpdateProjection();
+  return map;
+}
+
+void
+RaspLoader::Tick() noexcept
+{
+  if (!idle_priority) {
+    /* the thread keeps running until this object is destructed, so
+       this needs to be done only once */
+    SetIdlePriority();
+    idle_priority = true;
+  }
+
+  bool loaded = false;
+
+  while (!queue.empty() && !IsStopped()) {
+    const unsigned time_index = queue.front();
+    queue.remove(0);
+
+    if (cache.Get(time_index) != nullptr)
+      continue;
+
+    std::shared_ptr<const RasterMap> map;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      map = Load(time_index);
+    }
+
+    /* only this thread inserts, so the key is still missing */
+    cache.Put(time_index, std::move(map));
+    loaded = true;
+  }
+
+  /* notify the client */
+  if (loaded && callback) {
+    const ScopeUnlock unlock(mutex);
+    callback();
+  }
+}
@@ -0,0 +1,114 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WEATHER_RASP_LOADER_HPP
+#define XCSOAR_WEATHER_RASP_LOADER_HPP
+
+#include "thread/StandbyThread.hpp"
+#include "util/Cache.hxx"
+#include "util/StaticArray.hxx"
+
+#include <functional>
+#include <memory>
+
+class RaspStore;
+class RasterMap;
+
+/**
+ * A thread which decodes the RASP maps of one parameter in the
+ * background and keeps the most recently used ones in memory.  After
+ * a map has been requested, the following forecast times are loaded
+ * as well, so stepping through them does not have to wait for the
+ * decoder.
+ */
+class RaspLoader final : private StandbyThread {
+  /**
+   * The number of decoded maps kept in memory.
+   */
+  static constexpr unsigned CACHE_SIZE = 8;
+
+  /**
+   * The number of forecast times after the requested one which are
+   * loaded in advance.
+   */
+  static constexpr unsigned PREFETCH = 3;
+
+  const RaspStore &store;
+  const unsigned parameter;
+
+  /**
+   * Called by the thread after new maps have been loaded.
+   */
+  const std::function<void()> callback;
+
+  /**
+   * The decoded maps, indexed by time index.  A failed load is
+   * stored as nullptr, to avoid retrying it again and again.
+   */
+  Cache<unsigned, std::shared_ptr<const RasterMap>, CACHE_SIZE, 17> cache;
+
+  /**
+   * The time indexes which shall be loaded, the most urgent one
+   * first.
+   */
+  StaticArray<unsigned, PREFETCH + 1> queue;
+
+  /**
+   * Has the thread lowered its priority already?  Only accessed by
+   * the thread.
+   */
+  bool idle_priority = false;
+
+public:
+  RaspLoader(const RaspStore &_store, unsigned _parameter,
+             std::function<void()> &&_callback) noexcept;
+  ~RaspLoader() noexcept;
+
+  /**
+   * Look up the map for the given time index.  If it has not been
+   * loaded yet, ask the thread to load it and return false
+   * immediately.  In any case, the following forecast times are
+   * scheduled for loading.
+   *
+   * @param map_r receives the map if it is ready (may be nullptr if
+   * it failed to load)
+   * @return true if the map is ready
+   */
+  bool Get(unsigned time_index, std::shared_ptr<const RasterMap> &map_r) noexcept;
+
+private:
+  /**
+   * Fill the #queue.  Caller must lock the mutex.
+   */
+  void Schedule(unsigned time_index) noexcept;
+
+  /**
+   * Decode one map.  Does not need the mutex.
+   */
+  std::shared_ptr<const RasterMap> Load(unsigned time_index) const noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
+
+#endif
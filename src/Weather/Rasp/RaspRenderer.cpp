@@ -30,6 +30,23 @@ Copyright_License {
 #include "Projection/WindowProjection.hpp"
 #include "util/StringAPI.hxx"
 
+#ifdef ENABLE_OPENGL
+/**
+ * Is the given #GeoBounds object "much larger" than the other one?
+ * Then the image should be regenerated, because its resolution
+ * would be too low.
+ */
+static bool
+IsLargeSizeDifference(const GeoBounds &a, const GeoBounds &b)
+{
+  assert(a.IsValid());
+  assert(b.IsValid());
+
+  return a.GetWidth().Native() > 2 * b.GetWidth().Native() ||
+    a.GetHeight().Native() > 2 * b.GetHeight().Native();
+}
+#endif
+
 gcc_pure
 static const RaspStyle &
 LookupWeatherTerrainStyle(const TCHAR *name)
@@ -55,10 +72,37 @@ RaspRenderer::Generate(const WindowProjection &projection,
   if (map == nullptr)
     return false;
 
+#ifdef ENABLE_OPENGL
+  const GeoBounds &old_bounds = raster_renderer.GetBounds();
+  GeoBounds new_bounds = projection.GetScreenBounds();
+  if (!new_bounds.IntersectWith(map->GetBounds()))
+    /* not visible */
+    return false;
+
+  const bool unchanged = old_bounds.IsValid() &&
+    old_bounds.IsInside(new_bounds) &&
+    !IsLargeSizeDifference(old_bounds, new_bounds) &&
+    !raster_renderer.UpdateQuantisation();
+#else
   if (!map->GetBounds().Overlaps(projection.GetScreenBounds()))
     /* not visible */
     return false;
 
+  const bool unchanged = compare_projection.Compare(projection);
+  compare_projection = CompareProjection(projection);
+#endif
+
+  if (unchanged && last_serial == cache.GetSerial() &&
+      color_ramp == last_color_ramp &&
+      settings.contrast == last_contrast &&
+      settings.brightness == last_brightness)
+    /* reuse the image which was generated for the previous frame */
+    return true;
+
+  last_serial = cache.GetSerial();
+  last_contrast = settings.contrast;
+  last_brightness = settings.brightness;
+
   if (color_ramp != last_color_ramp) {
     raster_renderer.PrepareColorTable(color_ramp, do_water,
                                       height_scale, interp_levels);
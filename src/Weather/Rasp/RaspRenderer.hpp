@@ -45,9 +45,21 @@ class RaspRenderer {
 
   const ColorRamp *last_color_ramp = nullptr;
 
+  /**
+   * The RaspCache::GetSerial() value of the last rendered image.
+   */
+  Serial last_serial;
+
+  short last_contrast, last_brightness;
+
 public:
-  RaspRenderer(const RaspStore &_store, unsigned parameter)
-    :cache(_store, parameter) {}
+  /**
+   * @param callback invoked in a background thread when a map has
+   * been loaded; the caller should schedule a redraw
+   */
+  RaspRenderer(const RaspStore &_store, unsigned parameter,
+               std::function<void()> &&callback)
+    :cache(_store, parameter, std::move(callback)) {}
 
   /**
    * Flush the cache.
@@ -82,8 +94,8 @@ public:
     cache.SetTime(t);
   }
 
-  void Update(BrokenTime time_local, OperationEnvironment &operation) {
-    cache.Reload(time_local, operation);
+  void Update(BrokenTime time_local) noexcept {
+    cache.Reload(time_local);
   }
 
   /**
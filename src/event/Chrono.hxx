@@ -32,6 +32,34 @@ using Clock = std::chrono::steady_clock;
 using Duration = Clock::duration;
 using TimePoint = Clock::time_point;
 
+/**
+ * Postpone a due time by at most #slack so that it falls onto a
+ * shared grid.  Timers which tolerate similar delays then expire at
+ * the same instant and are handled in one wakeup.  The grid is the
+ * largest power of two milliseconds not exceeding #slack, which means
+ * grids of different timers are multiples of each other.
+ */
+constexpr TimePoint
+AlignDue(TimePoint due, Duration slack) noexcept
+{
+	using std::chrono::milliseconds;
+
+	const auto slack_ms =
+		std::chrono::duration_cast<milliseconds>(slack).count();
+	if (slack_ms <= 0)
+		return due;
+
+	milliseconds::rep grid_ms = 1;
+	while (grid_ms <= slack_ms / 2)
+		grid_ms *= 2;
+
+	const Duration grid = milliseconds(grid_ms);
+	const Duration remainder = due.time_since_epoch() % grid;
+	return remainder == Duration::zero()
+		? due
+		: due + (grid - remainder);
+}
+
 } // namespace Event
 
 #endif /* MAIN_NOTIFY_H */
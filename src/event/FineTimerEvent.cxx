@@ -42,6 +42,15 @@ FineTimerEvent::Schedule(Event::Duration d) noexcept
 	loop.Insert(*this);
 }
 
+void
+FineTimerEvent::Schedule(Event::Duration d, Event::Duration slack) noexcept
+{
+	Cancel();
+
+	due = Event::AlignDue(loop.SteadyNow() + d, slack);
+	loop.Insert(*this);
+}
+
 void
 FineTimerEvent::ScheduleEarlier(Event::Duration d) noexcept
 {
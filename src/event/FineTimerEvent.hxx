@@ -96,6 +96,13 @@ public:
 
 	void Schedule(Event::Duration d) noexcept;
 
+	/**
+	 * Like Schedule(), but allow the timer to be postponed by up
+	 * to #slack, so it can share a wakeup with other timers (see
+	 * Event::AlignDue()).
+	 */
+	void Schedule(Event::Duration d, Event::Duration slack) noexcept;
+
 	/**
 	 * Like Schedule(), but is a no-op if there is a due time
 	 * earlier than the given one.
@@ -299,6 +299,8 @@ EventLoop::Run() noexcept
 
 	steady_clock_cache.flush();
 
+	Event::TimePoint wake_time = Event::Clock::now();
+
 	do {
 		again = false;
 
@@ -340,9 +342,19 @@ EventLoop::Run() noexcept
 
 		/* wait for new event */
 
-		Wait(finish ? Event::Duration{} : timeout);
+		const auto busy_time = Event::Clock::now() - wake_time;
+		stats.busy_total += busy_time;
+		if (busy_time > stats.busy_max)
+			stats.busy_max = busy_time;
+
+		const bool ready = Wait(finish ? Event::Duration{} : timeout);
 
 		steady_clock_cache.flush();
+		wake_time = SteadyNow();
+
+		++stats.wakeups;
+		if (!ready)
+			++stats.timer_wakeups;
 
 #ifdef HAVE_THREADED_EVENT_LOOP
 		{
@@ -39,6 +39,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 
 #include "io/uring/Features.h"
 #ifdef HAVE_URING
@@ -60,6 +61,34 @@ class InjectEvent;
  */
 class EventLoop final
 {
+public:
+	/**
+	 * Counters which describe how often the loop woke up and how
+	 * long it was busy handling events.  They help finding
+	 * wasteful timers on battery powered devices.
+	 */
+	struct Stats {
+		/**
+		 * How often has the loop returned from the poll
+		 * backend?
+		 */
+		uint64_t wakeups = 0;
+
+		/**
+		 * How many of #wakeups were caused by a timeout, i.e.
+		 * without a ready socket?
+		 */
+		uint64_t timer_wakeups = 0;
+
+		/**
+		 * The total and the maximum duration between waking
+		 * up and going back to sleep, i.e. the time spent in
+		 * handlers.
+		 */
+		Event::Duration busy_total{}, busy_max{};
+	};
+
+private:
 #ifdef HAVE_THREADED_EVENT_LOOP
 	WakeFD wake_fd;
 	SocketEvent wake_event{*this, BIND_THIS_METHOD(OnSocketReady), wake_fd.GetSocket()};
@@ -152,6 +181,8 @@ class EventLoop final
 
 	ClockCache<std::chrono::steady_clock> steady_clock_cache;
 
+	Stats stats;
+
 public:
 	/**
 	 * Throws on error.
@@ -173,6 +204,14 @@ public:
 		return steady_clock_cache;
 	}
 
+	/**
+	 * Obtain a snapshot of the statistics.  Must be called from
+	 * within the loop's thread (or after the loop has finished).
+	 */
+	const Stats &GetStats() const noexcept {
+		return stats;
+	}
+
 	/**
 	 * Caching wrapper for std::chrono::steady_clock::now().  The
 	 * real clock is queried at most once per event loop
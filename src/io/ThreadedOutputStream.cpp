@@ -0,0 +1,215 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ThreadedOutputStream.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+static constexpr std::size_t
+RoundUpPowerOfTwo(std::size_t size) noexcept
+{
+  std::size_t result = 1;
+  while (result < size)
+    result <<= 1;
+  return result;
+}
+
+/**
+ * Has position #a reached position #b?  This works across integer
+ * overflow, as long as both are less than half the range apart.
+ */
+static constexpr bool
+Reached(std::size_t a, std::size_t b) noexcept
+{
+  return std::ptrdiff_t(a - b) >= 0;
+}
+
+ThreadedOutputStream::ThreadedOutputStream(OutputStream &_next,
+                                           std::chrono::steady_clock::duration _commit_interval,
+                                           std::size_t buffer_size)
+  :Thread("OutputStream"),
+   next(_next), commit_interval(_commit_interval),
+   buffer(new std::byte[RoundUpPowerOfTwo(buffer_size)]),
+   capacity(RoundUpPowerOfTwo(buffer_size))
+{
+  Start();
+}
+
+ThreadedOutputStream::~ThreadedOutputStream() noexcept
+{
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop = true;
+    cond.notify_all();
+  }
+
+  Join();
+}
+
+inline std::size_t
+ThreadedOutputStream::Push(const std::byte *data, std::size_t size) noexcept
+{
+  const std::size_t h = head.load(std::memory_order_relaxed);
+  const std::size_t t = tail.load(std::memory_order_acquire);
+  const std::size_t n = std::min(size, capacity - (h - t));
+  if (n == 0)
+    return 0;
+
+  const std::size_t offset = h & (capacity - 1);
+  const std::size_t first = std::min(n, capacity - offset);
+  std::memcpy(buffer.get() + offset, data, first);
+  std::memcpy(buffer.get(), data + first, n - first);
+
+  head.store(h + n, std::memory_order_release);
+  return n;
+}
+
+void
+ThreadedOutputStream::WaitForSpace()
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  /* ask the thread to commit right now */
+  const std::size_t h = head.load(std::memory_order_relaxed);
+  if (!Reached(flush_requested, h))
+    flush_requested = h;
+  cond.notify_all();
+
+  cond.wait(lock, [this, h]{
+    return error || h - tail.load(std::memory_order_acquire) < capacity;
+  });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+ThreadedOutputStream::Write(const void *_data, std::size_t size)
+{
+  if (failed.load(std::memory_order_relaxed)) {
+    const std::lock_guard<Mutex> lock(mutex);
+    std::rethrow_exception(error);
+  }
+
+  const auto *data = (const std::byte *)_data;
+  while (true) {
+    const std::size_t n = Push(data, size);
+    data += n;
+    size -= n;
+
+    if (size == 0)
+      break;
+
+    WaitForSpace();
+  }
+
+  /* wake up the thread early if the buffer gets crowded; this is
+     the only place where the producer touches the condition, and a
+     lost wakeup is harmless because the thread wakes up after the
+     commit interval anyway */
+  if (head.load(std::memory_order_relaxed) -
+      tail.load(std::memory_order_relaxed) >= capacity / 2)
+    cond.notify_one();
+}
+
+void
+ThreadedOutputStream::Flush()
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  const std::size_t h = head.load(std::memory_order_relaxed);
+  if (!Reached(flush_requested, h))
+    flush_requested = h;
+  cond.notify_all();
+
+  cond.wait(lock, [this, h]{
+    return error || Reached(tail.load(std::memory_order_acquire), h);
+  });
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+ThreadedOutputStream::Commit()
+{
+  const std::size_t h = head.load(std::memory_order_acquire);
+  std::size_t t = tail.load(std::memory_order_relaxed);
+
+  while (t != h) {
+    const std::size_t offset = t & (capacity - 1);
+    const std::size_t n = std::min(h - t, capacity - offset);
+
+    /* after an error, discard everything */
+    if (!failed.load(std::memory_order_relaxed))
+      next.Write(buffer.get() + offset, n);
+
+    t += n;
+    tail.store(t, std::memory_order_release);
+  }
+}
+
+void
+ThreadedOutputStream::Run() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  while (true) {
+    cond.wait_for(lock, commit_interval, [this]{
+      const std::size_t h = head.load(std::memory_order_acquire);
+      const std::size_t t = tail.load(std::memory_order_relaxed);
+      return stop || (flush_requested != t && Reached(flush_requested, t)) ||
+        h - t >= capacity / 2;
+    });
+
+    const bool stopping = stop;
+
+    std::exception_ptr e;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      try {
+        Commit();
+      } catch (...) {
+        e = std::current_exception();
+      }
+    }
+
+    if (e && !error) {
+      error = std::move(e);
+      failed.store(true, std::memory_order_relaxed);
+
+      /* discard the rest */
+      const ScopeUnlock unlock(mutex);
+      Commit();
+    }
+
+    cond.notify_all();
+
+    if (stopping)
+      break;
+  }
+}
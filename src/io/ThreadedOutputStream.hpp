@@ -0,0 +1,157 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_THREADED_OUTPUT_STREAM_HPP
+#define XCSOAR_IO_THREADED_OUTPUT_STREAM_HPP
+
+#include "OutputStream.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+
+/**
+ * An #OutputStream which copies all data into a lock-free ring
+ * buffer and leaves writing it to the next #OutputStream to a
+ * separate thread.  The thread collects data for a configurable
+ * interval and then submits it with as few system calls as possible
+ * ("group commit"), so the caller never blocks on slow flash
+ * storage, unless the ring buffer overflows.
+ *
+ * Write() must not be called from more than one thread at a time.
+ */
+class ThreadedOutputStream final : public OutputStream, private Thread {
+  OutputStream &next;
+
+  /**
+   * How long shall the thread collect data before writing it?
+   */
+  const std::chrono::steady_clock::duration commit_interval;
+
+  const std::unique_ptr<std::byte[]> buffer;
+
+  /**
+   * The size of #buffer; a power of two.
+   */
+  const std::size_t capacity;
+
+  /**
+   * The total number of bytes submitted by Write().  Only the
+   * producer modifies this.
+   */
+  std::atomic_size_t head{0};
+
+  /**
+   * The total number of bytes written to #next.  Only the thread
+   * modifies this.
+   */
+  std::atomic_size_t tail{0};
+
+  /**
+   * Has the thread failed to write?  This is a lock-free shortcut
+   * for checking #error.
+   */
+  std::atomic_bool failed{false};
+
+  /**
+   * Protects #cond and the attributes below.
+   */
+  Mutex mutex;
+  Cond cond;
+
+  /**
+   * The position (in #head units) up to which Flush() waits for
+   * data to be written.
+   */
+  std::size_t flush_requested = 0;
+
+  bool stop = false;
+
+  /**
+   * The first error which occurred in the thread.  After that, all
+   * data is discarded.
+   */
+  std::exception_ptr error;
+
+public:
+  /**
+   * Throws on error.
+   *
+   * @param _next the stream which receives the data in the thread;
+   * it must outlive this object
+   * @param _commit_interval the maximum time between receiving data
+   * in Write() and passing it to #_next
+   * @param buffer_size the size of the ring buffer; will be rounded
+   * up to the next power of two
+   */
+  ThreadedOutputStream(OutputStream &_next,
+                       std::chrono::steady_clock::duration _commit_interval,
+                       std::size_t buffer_size=64 * 1024);
+
+  /**
+   * Writes all pending data and stops the thread.  Errors are
+   * ignored; call Flush() before to catch them.
+   */
+  ~ThreadedOutputStream() noexcept;
+
+  /**
+   * Wait until all data submitted so far has been passed to the
+   * next #OutputStream.
+   *
+   * Throws on error (if the thread has failed to write).
+   */
+  void Flush();
+
+  /* virtual methods from class OutputStream */
+  void Write(const void *data, std::size_t size) override;
+
+private:
+  /**
+   * Copy as much data as possible into the ring buffer.
+   *
+   * @return the number of bytes copied
+   */
+  std::size_t Push(const std::byte *data, std::size_t size) noexcept;
+
+  /**
+   * Block until the thread has made room in the ring buffer.
+   */
+  void WaitForSpace();
+
+  /**
+   * Submit all data from the ring buffer to #next.
+   *
+   * Throws on error.
+   */
+  void Commit();
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
@@ -22,10 +22,62 @@ Copyright_License {
 */
 
 #include "ZipArchive.hpp"
+#include "ZlibError.hxx"
 #include "system/ConvertPathName.hpp"
+#include "system/FileMapping.hpp"
+#include "util/ByteOrder.hxx"
 #include "util/RuntimeError.hxx"
 
 #include <zzip/zzip.h>
+#include <zlib.h>
+
+#include <cassert>
+#include <stdexcept>
+
+#include <string.h>
+
+/* the ZIP structures, see PKWARE's APPNOTE.TXT */
+
+struct ZipEndOfCentralDirectory {
+  static constexpr uint32_t SIGNATURE = 0x06054b50;
+
+  PackedLE32 signature;
+  PackedLE16 disk, directory_disk;
+  PackedLE16 disk_entries, total_entries;
+  PackedLE32 directory_size, directory_offset;
+  PackedLE16 comment_length;
+};
+
+static_assert(sizeof(ZipEndOfCentralDirectory) == 22);
+
+struct ZipCentralDirectoryEntry {
+  static constexpr uint32_t SIGNATURE = 0x02014b50;
+
+  PackedLE32 signature;
+  PackedLE16 version_made_by, version_needed;
+  PackedLE16 flags, method;
+  PackedLE16 time, date;
+  PackedLE32 crc, compressed_size, size;
+  PackedLE16 name_length, extra_length, comment_length;
+  PackedLE16 disk, internal_attributes;
+  PackedLE32 external_attributes;
+  PackedLE32 local_header_offset;
+};
+
+static_assert(sizeof(ZipCentralDirectoryEntry) == 46);
+
+struct ZipLocalHeader {
+  static constexpr uint32_t SIGNATURE = 0x04034b50;
+
+  PackedLE32 signature;
+  PackedLE16 version_needed;
+  PackedLE16 flags, method;
+  PackedLE16 time, date;
+  PackedLE32 crc, compressed_size, size;
+  PackedLE16 name_length, extra_length;
+};
+
+static_assert(sizeof(ZipLocalHeader) == 30);
 
 ZipArchive::ZipArchive(Path path)
   :dir(zzip_dir_open(NarrowPathName(path), nullptr))
@@ -33,6 +85,15 @@ ZipArchive::ZipArchive(Path path)
   if (dir == nullptr)
     throw FormatRuntimeError("Failed to open ZIP archive %s",
                              (const char *)NarrowPathName(path));
+
+  try {
+    mapping = std::make_unique<FileMapping>(path);
+  } catch (...) {
+    /* not fatal: all members can still be read with zzip */
+    return;
+  }
+
+  ReadIndex();
 }
 
 ZipArchive::~ZipArchive() noexcept
@@ -41,9 +102,201 @@ ZipArchive::~ZipArchive() noexcept
     zzip_dir_close(dir);
 }
 
+ZipArchive::ZipArchive(ZipArchive &&src) noexcept
+  :dir(std::exchange(src.dir, nullptr)),
+   mapping(std::move(src.mapping)),
+   entries(std::move(src.entries)),
+   indexed(std::exchange(src.indexed, false)) {}
+
+ZipArchive &
+ZipArchive::operator=(ZipArchive &&src) noexcept
+{
+  std::swap(dir, src.dir);
+  std::swap(mapping, src.mapping);
+  std::swap(entries, src.entries);
+  std::swap(indexed, src.indexed);
+  return *this;
+}
+
+static const ZipEndOfCentralDirectory *
+FindEndOfCentralDirectory(const std::byte *data, size_t size) noexcept
+{
+  constexpr size_t header_size = sizeof(ZipEndOfCentralDirectory);
+  if (size < header_size)
+    return nullptr;
+
+  /* the record is followed by a comment of up to 64 kB */
+  const size_t last = size - header_size;
+  const size_t first = last > 0xffff ? last - 0xffff : 0;
+
+  for (size_t i = last + 1; i-- > first;) {
+    const auto *eocd = (const ZipEndOfCentralDirectory *)(data + i);
+    if (eocd->signature == ZipEndOfCentralDirectory::SIGNATURE &&
+        i + header_size + eocd->comment_length <= size)
+      return eocd;
+  }
+
+  return nullptr;
+}
+
+void
+ZipArchive::ReadIndex() noexcept
+try {
+  const auto *data = (const std::byte *)mapping->data();
+  const size_t size = mapping->size();
+
+  const auto *eocd = FindEndOfCentralDirectory(data, size);
+  if (eocd == nullptr ||
+      /* ZIP64 and multi-disk archives are left to zzip */
+      eocd->disk != 0 || eocd->directory_disk != 0 ||
+      eocd->total_entries == 0xffff ||
+      eocd->directory_offset == 0xffffffff)
+    return;
+
+  size_t position = eocd->directory_offset;
+  const size_t end = (const std::byte *)eocd - data;
+  if (position > end || eocd->directory_size > end - position)
+    return;
+
+  entries.reserve(eocd->total_entries);
+
+  for (unsigned i = 0; i < eocd->total_entries; ++i) {
+    if (end - position < sizeof(ZipCentralDirectoryEntry))
+      return;
+
+    const auto &c = *(const ZipCentralDirectoryEntry *)(data + position);
+    if (c.signature != ZipCentralDirectoryEntry::SIGNATURE)
+      return;
+
+    position += sizeof(c);
+    if (end - position < c.name_length)
+      return;
+
+    Entry entry;
+    entry.name.assign((const char *)(data + position), c.name_length);
+    entry.compressed_size = c.compressed_size;
+    entry.size = c.size;
+    entry.crc = c.crc;
+    entry.method = c.method;
+
+    /* encrypted members are not supported */
+    if (c.flags & 0x1)
+      entry.method = Entry::UNSUPPORTED;
+
+    position += c.name_length + c.extra_length + c.comment_length;
+    if (position > end)
+      return;
+
+    /* the local header may have a different "extra" field */
+    const size_t local = c.local_header_offset;
+    if (local > size || size - local < sizeof(ZipLocalHeader))
+      return;
+
+    const auto &l = *(const ZipLocalHeader *)(data + local);
+    if (l.signature != ZipLocalHeader::SIGNATURE)
+      return;
+
+    entry.offset = local + sizeof(l) + l.name_length + l.extra_length;
+    if (entry.offset > size || size - entry.offset < entry.compressed_size)
+      return;
+
+    entries.emplace_back(std::move(entry));
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b){
+              return a.name < b.name;
+            });
+
+  indexed = true;
+} catch (...) {
+  /* out of memory: fall back to zzip */
+  entries.clear();
+}
+
+const ZipArchive::Entry *
+ZipArchive::FindEntry(std::string_view name) const noexcept
+{
+  if (!indexed)
+    return nullptr;
+
+  const auto i = std::lower_bound(entries.begin(), entries.end(), name,
+                                  [](const Entry &entry, std::string_view n){
+                                    return entry.name < n;
+                                  });
+  if (i == entries.end() || i->name != name)
+    return nullptr;
+
+  return &*i;
+}
+
+std::span<const std::byte>
+ZipArchive::GetRawData(const Entry &entry) const noexcept
+{
+  assert(mapping != nullptr);
+
+  return {(const std::byte *)mapping->at(entry.offset),
+          (std::size_t)entry.compressed_size};
+}
+
+AllocatedArray<std::byte>
+ZipArchive::Inflate(const Entry &entry) const
+{
+  const auto raw = GetRawData(entry);
+
+  AllocatedArray<std::byte> result(entry.size);
+
+  switch (entry.method) {
+  case Entry::STORED:
+    if (raw.size() != entry.size)
+      throw std::runtime_error("Malformed ZIP member");
+
+    std::copy(raw.begin(), raw.end(), result.begin());
+    break;
+
+  case Entry::DEFLATED:
+    {
+      z_stream z{};
+      /* ZIP members have no zlib header */
+      int code = inflateInit2(&z, -MAX_WBITS);
+      if (code != Z_OK)
+        throw ZlibError(code);
+
+      z.next_in = const_cast<Bytef *>((const Bytef *)raw.data());
+      z.avail_in = raw.size();
+      z.next_out = (Bytef *)result.data();
+      z.avail_out = result.size();
+
+      code = inflate(&z, Z_FINISH);
+      const bool complete = z.avail_out == 0;
+      inflateEnd(&z);
+
+      if (code != Z_STREAM_END)
+        throw ZlibError(code == Z_OK || code == Z_BUF_ERROR
+                        ? Z_DATA_ERROR
+                        : code);
+
+      if (!complete)
+        throw std::runtime_error("Malformed ZIP member");
+    }
+    break;
+
+  default:
+    throw std::runtime_error("Unsupported ZIP compression method");
+  }
+
+  if (crc32(0, (const Bytef *)result.data(), result.size()) != entry.crc)
+    throw std::runtime_error("ZIP member checksum mismatch");
+
+  return result;
+}
+
 bool
 ZipArchive::Exists(const char *name) const noexcept
 {
+  if (indexed)
+    return FindEntry(name) != nullptr;
+
   ZZIP_STAT st;
   return zzip_dir_stat(dir, name, &st, 0) == 0;
 }
@@ -24,19 +24,75 @@ Copyright_License {
 #ifndef XCSOAR_IO_ZIP_ARCHIVE_HPP
 #define XCSOAR_IO_ZIP_ARCHIVE_HPP
 
+#include "util/AllocatedArray.hxx"
+
 #include <algorithm>
-#include <string>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 class Path;
+class FileMapping;
 
 /**
  * A handle to z ZIP archive file.  It is a OO wrapper for struct
  * zzip_dir.
+ *
+ * In addition, the file is memory-mapped and its central directory
+ * is indexed once, which allows zero-copy access to stored members
+ * and inflating deflated members without a zzip stream.
  */
 class ZipArchive {
+public:
+  /**
+   * A member of the archive, as described by the central directory.
+   */
+  struct Entry {
+    std::string name;
+
+    /**
+     * The position of the (possibly compressed) data in the file.
+     */
+    uint64_t offset;
+
+    uint64_t compressed_size, size;
+
+    uint32_t crc;
+
+    /**
+     * The compression method: 0 = stored, 8 = deflated.  Entries
+     * which can't be read directly (e.g. encrypted ones) have the
+     * value #UNSUPPORTED.
+     */
+    uint16_t method;
+
+    static constexpr uint16_t STORED = 0, DEFLATED = 8;
+    static constexpr uint16_t UNSUPPORTED = 0xffff;
+
+    bool IsStored() const noexcept {
+      return method == STORED;
+    }
+  };
+
+private:
   struct zzip_dir *dir = nullptr;
 
+  std::unique_ptr<FileMapping> mapping;
+
+  /**
+   * All entries, sorted by name.  Only valid if #indexed is set,
+   * which is not the case if the file could not be mapped or if the
+   * central directory uses features not supported here (ZIP64).
+   */
+  std::vector<Entry> entries;
+
+  bool indexed = false;
+
 public:
   /**
    * Open a ZIP archive.  Throws std::runtime_error on error.
@@ -44,14 +100,8 @@ public:
   explicit ZipArchive(Path path);
   ~ZipArchive() noexcept;
 
-  ZipArchive(ZipArchive &&src) noexcept:dir(src.dir) {
-    src.dir = nullptr;
-  }
-
-  ZipArchive &operator=(ZipArchive &&src) noexcept {
-    std::swap(dir, src.dir);
-    return *this;
-  }
+  ZipArchive(ZipArchive &&src) noexcept;
+  ZipArchive &operator=(ZipArchive &&src) noexcept;
 
   struct zzip_dir *get() noexcept {
     return dir;
@@ -66,6 +116,34 @@ public:
    * last entry.
    */
   std::string NextName() noexcept;
+
+  /**
+   * Look up a member in the index.
+   *
+   * @return nullptr if the member does not exist or if the archive
+   * is not indexed
+   */
+  [[gnu::pure]]
+  const Entry *FindEntry(std::string_view name) const noexcept;
+
+  /**
+   * Returns the data of the member as it is stored in the file,
+   * i.e. the contents of stored members, without copying it.
+   */
+  [[gnu::pure]]
+  std::span<const std::byte> GetRawData(const Entry &entry) const noexcept;
+
+  /**
+   * Decompress a member into a new buffer (stored members are
+   * copied).  This method does not modify the object, so several
+   * members can be inflated in parallel by different threads.
+   *
+   * Throws on error.
+   */
+  AllocatedArray<std::byte> Inflate(const Entry &entry) const;
+
+private:
+  void ReadIndex() noexcept;
 };
 
 #endif
@@ -42,6 +42,12 @@ class PeriodicTimer final {
 
   std::chrono::steady_clock::duration interval{-1};
 
+  /**
+   * How much may each period be stretched to share wakeups with
+   * other timers?  See Timer::Schedule().
+   */
+  std::chrono::steady_clock::duration slack{};
+
   using Callback = std::function<void()>;
   const Callback callback;
 
@@ -63,10 +69,15 @@ public:
   /**
    * Schedule the timer.  Cancels the previous setting if there was
    * one.
+   *
+   * @param _slack each period may be postponed by up to this
+   * duration, to share wakeups with other timers
    */
-  void Schedule(std::chrono::steady_clock::duration d) noexcept {
+  void Schedule(std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration _slack={}) noexcept {
     interval = d;
-    timer.Schedule(d);
+    slack = _slack;
+    timer.Schedule(d, slack);
   }
 
   /**
@@ -83,7 +94,7 @@ public:
     callback();
 
     if (IsActive() && !timer.IsPending())
-      timer.Schedule(interval);
+      timer.Schedule(interval, slack);
   }
 };
 
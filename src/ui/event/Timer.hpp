@@ -85,6 +85,14 @@ public:
    */
   void Schedule(std::chrono::steady_clock::duration d) noexcept;
 
+  /**
+   * Schedule the timer, but allow it to be postponed by up to
+   * #slack, so it can share a wakeup with other timers.  Use this
+   * for periodic work which does not need to be punctual.
+   */
+  void Schedule(std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack) noexcept;
+
   /**
    * Schedule the timer.  Preserves the previous setting if there was
    * one.
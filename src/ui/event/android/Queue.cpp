@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Queue.hpp"
+#include "event/Chrono.hxx"
 
 namespace UI {
 
@@ -75,13 +76,26 @@ EventQueue::Wait(Event &event) noexcept
     if (Generate(event))
       return true;
 
+    if (wake_time != std::chrono::steady_clock::time_point{}) {
+      const auto busy_time = SteadyNow() - wake_time;
+      stats.busy_total += busy_time;
+      if (busy_time > stats.busy_max)
+        stats.busy_max = busy_time;
+    }
+
     const auto timeout = timers.GetTimeout(SteadyNow());
+    bool timed_out = false;
     if (timeout < std::chrono::steady_clock::duration::zero())
       cond.wait(lock);
     else
-      cond.wait_for(lock, timeout);
+      timed_out = cond.wait_for(lock, timeout) == std::cv_status::timeout;
 
     FlushClockCaches();
+    wake_time = SteadyNow();
+
+    ++stats.wakeups;
+    if (timed_out)
+      ++stats.timer_wakeups;
   }
 
   event = events.front();
@@ -131,11 +145,12 @@ EventQueue::Purge(Event::Callback callback, void *ctx) noexcept
 }
 
 void
-EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept
+EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                     std::chrono::steady_clock::duration slack) noexcept
 {
   std::lock_guard<Mutex> lock(mutex);
 
-  timers.Add(timer, SteadyNow() + d);
+  timers.Add(timer, Event::AlignDue(SteadyNow() + d, slack));
 
   cond.notify_one();
 }
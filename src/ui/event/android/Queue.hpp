@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "../shared/TimerQueue.hpp"
 #include "../shared/Event.hpp"
+#include "event/Loop.hxx"
 #include "thread/Mutex.hxx"
 #include "thread/Cond.hxx"
 #include "time/ClockCache.hxx"
@@ -47,6 +48,14 @@ class EventQueue {
 
   bool quit = false;
 
+  EventLoop::Stats stats;
+
+  /**
+   * When did Wait() return last?  Used to measure the time spent in
+   * event handlers.
+   */
+  std::chrono::steady_clock::time_point wake_time;
+
 public:
   EventQueue() = default;
 
@@ -74,6 +83,14 @@ public:
     quit = true;
   }
 
+  /**
+   * Obtain the wakeup statistics.  Must be called from the main
+   * thread.
+   */
+  const EventLoop::Stats &GetStats() const noexcept {
+    return stats;
+  }
+
   void Inject(const Event &event) noexcept;
 
   void InjectCall(Event::Callback callback, void *ctx) noexcept {
@@ -90,7 +107,12 @@ public:
   void Purge(Event::Type type) noexcept;
   void Purge(Event::Callback callback, void *ctx) noexcept;
 
-  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept;
+  /**
+   * @param slack the timer may be postponed by up to this duration
+   * to share a wakeup with other timers
+   */
+  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack={}) noexcept;
   void CancelTimer(Timer &timer) noexcept;
 
 private:
@@ -37,6 +37,13 @@ Timer::Schedule(std::chrono::steady_clock::duration d) noexcept
   timer_event.Schedule(d);
 }
 
+void
+Timer::Schedule(std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack) noexcept
+{
+  timer_event.Schedule(d, slack);
+}
+
 void
 Timer::SchedulePreserve(std::chrono::steady_clock::duration d) noexcept
 {
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Queue.hpp"
+#include "event/Chrono.hxx"
 #include "Event.hpp"
 #include "../Timer.hpp"
 #include "system/Sleep.h"
@@ -131,11 +132,12 @@ EventQueue::Purge(EventLoop::Callback callback, void *ctx) noexcept
 }
 
 void
-EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept
+EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                     std::chrono::steady_clock::duration slack) noexcept
 {
   std::lock_guard<Mutex> lock(mutex);
 
-  timers.Add(timer, SteadyNow() + d);
+  timers.Add(timer, Event::AlignDue(SteadyNow() + d, slack));
 }
 
 void
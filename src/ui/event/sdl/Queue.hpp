@@ -89,7 +89,12 @@ public:
    */
   void Purge(EventLoop::Callback callback, void *ctx) noexcept;
 
-  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept;
+  /**
+   * @param slack the timer may be postponed by up to this duration
+   * to share a wakeup with other timers
+   */
+  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack={}) noexcept;
   void CancelTimer(Timer &timer) noexcept;
 
 private:
@@ -38,6 +38,16 @@ Timer::Schedule(std::chrono::steady_clock::duration d) noexcept
   event_queue->AddTimer(*this, d);
 }
 
+void
+Timer::Schedule(std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack) noexcept
+{
+  Cancel();
+
+  pending = true;
+  event_queue->AddTimer(*this, d, slack);
+}
+
 void
 Timer::SchedulePreserve(std::chrono::steady_clock::duration d) noexcept
 {
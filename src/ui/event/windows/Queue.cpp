@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Queue.hpp"
+#include "event/Chrono.hxx"
 #include "Event.hpp"
 #include "../Timer.hpp"
 #include "thread/Debug.hpp"
@@ -98,11 +99,12 @@ EventQueue::HandlePaintMessages()
 }
 
 void
-EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept
+EventQueue::AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                     std::chrono::steady_clock::duration slack) noexcept
 {
   std::lock_guard<Mutex> lock(mutex);
 
-  const auto due = SteadyNow() + d;
+  const auto due = Event::AlignDue(SteadyNow() + d, slack);
   timers.Add(timer, due);
 
   if (timers.IsBefore(due))
@@ -73,7 +73,12 @@ private:
   }
 
 public:
-  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d) noexcept;
+  /**
+   * @param slack the timer may be postponed by up to this duration
+   * to share a wakeup with other timers
+   */
+  void AddTimer(Timer &timer, std::chrono::steady_clock::duration d,
+                std::chrono::steady_clock::duration slack={}) noexcept;
   void CancelTimer(Timer &timer);
 
   /**
@@ -0,0 +1,354 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef XCSOAR_PACKED_POINT_INDEX_HPP
+#define XCSOAR_PACKED_POINT_INDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * A read-only spatial index on a two dimensional integer plane,
+ * built in one pass from an existing set of values (a "packed
+ * Hilbert R-tree").
+ *
+ * The values are sorted along a Hilbert curve, so values which are
+ * close to each other on the plane are close to each other in
+ * memory.  Groups of #NODE_SIZE values get a bounding box, and these
+ * are grouped again until only the root box is left.  All positions
+ * and boxes are stored in flat arrays, which makes queries much
+ * friendlier to the CPU cache than the linked buckets of a
+ * #QuadTree.
+ *
+ * The #Accessor class has the same interface as the one of
+ * #QuadTree.  The index must be rebuilt after the positions have
+ * been modified.
+ */
+template<typename T, typename Accessor>
+class PackedPointIndex {
+public:
+  typedef int position_type;
+  typedef unsigned distance_type;
+
+  static constexpr distance_type Square(position_type x) noexcept {
+    return x * x;
+  }
+
+  static constexpr distance_type Square(distance_type x) noexcept {
+    return x * x;
+  }
+
+  struct Point {
+    position_type x, y;
+
+    constexpr distance_type SquareDistanceTo(Point other) const noexcept {
+      return Square(other.x - x) + Square(other.y - y);
+    }
+  };
+
+private:
+  /**
+   * The number of children of each box.
+   */
+  static constexpr unsigned NODE_SIZE = 16;
+
+  struct Box {
+    position_type left, top, right, bottom;
+
+    constexpr explicit Box(Point p) noexcept
+      :left(p.x), top(p.y), right(p.x), bottom(p.y) {}
+
+    void Extend(const Box &other) noexcept {
+      left = std::min(left, other.left);
+      top = std::min(top, other.top);
+      right = std::max(right, other.right);
+      bottom = std::max(bottom, other.bottom);
+    }
+
+    /**
+     * Calculate the square distance from the nearest point of this
+     * box; zero if the point is inside.
+     */
+    constexpr distance_type SquareDistanceTo(Point p) const noexcept {
+      const position_type dx = p.x < left
+        ? left - p.x
+        : (p.x > right ? p.x - right : 0);
+      const position_type dy = p.y < top
+        ? top - p.y
+        : (p.y > bottom ? p.y - bottom : 0);
+      return Square(dx) + Square(dy);
+    }
+  };
+
+  /**
+   * The positions of all values, in Hilbert curve order.
+   */
+  std::vector<Point> positions;
+
+  /**
+   * The values, in the same order as #positions.
+   */
+  std::vector<T> values;
+
+  /**
+   * The bounding boxes of all levels, the lowest level (covering
+   * #positions) first; the last one is the root box.
+   */
+  std::vector<Box> boxes;
+
+  /**
+   * The end index of each level in #boxes.
+   */
+  std::vector<std::size_t> level_ends;
+
+public:
+  bool IsEmpty() const noexcept {
+    return values.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return values.size();
+  }
+
+  void Clear() noexcept {
+    positions.clear();
+    values.clear();
+    boxes.clear();
+    level_ends.clear();
+  }
+
+  /**
+   * Build the index from the given range of values, replacing the
+   * previous contents.
+   */
+  template<typename I>
+  void Build(I first, I last) {
+    std::vector<T> unsorted(first, last);
+    Clear();
+
+    if (unsorted.empty())
+      return;
+
+    Box bounds(GetPosition(unsorted.front()));
+    for (const auto &i : unsorted)
+      bounds.Extend(Box(GetPosition(i)));
+
+    std::vector<std::pair<uint32_t, uint32_t>> order;
+    order.reserve(unsorted.size());
+    for (std::size_t i = 0; i < unsorted.size(); ++i) {
+      const Point p = GetPosition(unsorted[i]);
+      order.emplace_back(HilbertIndex(Scale(p.x - bounds.left,
+                                            bounds.right - bounds.left),
+                                      Scale(p.y - bounds.top,
+                                            bounds.bottom - bounds.top)),
+                         i);
+    }
+
+    std::sort(order.begin(), order.end());
+
+    positions.reserve(unsorted.size());
+    values.reserve(unsorted.size());
+    for (const auto &i : order) {
+      positions.push_back(GetPosition(unsorted[i.second]));
+      values.push_back(std::move(unsorted[i.second]));
+    }
+
+    /* build the boxes bottom-up */
+    std::size_t level_begin = 0, n = positions.size();
+    bool leaves = true;
+    do {
+      const std::size_t begin = boxes.size();
+
+      for (std::size_t i = 0; i < n; i += NODE_SIZE) {
+        const std::size_t end = std::min(i + NODE_SIZE, n);
+        Box box = leaves ? Box(positions[i]) : boxes[level_begin + i];
+        for (std::size_t j = i + 1; j < end; ++j)
+          box.Extend(leaves ? Box(positions[j]) : boxes[level_begin + j]);
+        boxes.push_back(box);
+      }
+
+      level_ends.push_back(boxes.size());
+      level_begin = begin;
+      n = boxes.size() - begin;
+      leaves = false;
+    } while (n > 1);
+  }
+
+  /**
+   * Find the nearest value which matches the predicate.
+   *
+   * @return the value (or nullptr if there is none within the
+   * range) and its square distance
+   */
+  template<class P>
+  [[gnu::pure]]
+  std::pair<const T *, distance_type>
+  FindNearestIf(const Point location, distance_type range,
+                const P &predicate) const noexcept {
+    std::pair<const T *, distance_type> result(nullptr, Square(range));
+    if (!IsEmpty() && boxes.back().SquareDistanceTo(location) <= result.second)
+      FindNearestIf(GetRootLevel(), 0, location, predicate, result);
+    return result;
+  }
+
+  /**
+   * Invoke the visitor for each value within the given range.  The
+   * order is undefined.
+   */
+  template<class V>
+  void VisitWithinRange(const Point location, distance_type range,
+                        V &visitor) const {
+    const distance_type square_range = Square(range);
+    if (!IsEmpty() && boxes.back().SquareDistanceTo(location) <= square_range)
+      VisitWithinRange(GetRootLevel(), 0, location, square_range, visitor);
+  }
+
+private:
+  static Point GetPosition(const T &value) noexcept {
+    return {Accessor().GetX(value), Accessor().GetY(value)};
+  }
+
+  /**
+   * Map a coordinate relative to the bounds to the 16 bit grid of
+   * the Hilbert curve.
+   */
+  static constexpr uint32_t Scale(position_type value,
+                                  position_type size) noexcept {
+    return size > 0
+      ? uint32_t(uint64_t(uint32_t(value)) * 0xffff / uint32_t(size))
+      : 0;
+  }
+
+  /**
+   * Calculate the position of a point on a Hilbert curve filling a
+   * 65536x65536 grid.
+   */
+  static constexpr uint32_t HilbertIndex(uint32_t x, uint32_t y) noexcept {
+    constexpr uint32_t n = 0x10000;
+
+    uint32_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+      const uint32_t rx = (x & s) != 0;
+      const uint32_t ry = (y & s) != 0;
+      d += s * s * ((3 * rx) ^ ry);
+
+      if (ry == 0) {
+        if (rx == 1) {
+          x = n - 1 - x;
+          y = n - 1 - y;
+        }
+
+        std::swap(x, y);
+      }
+    }
+
+    return d;
+  }
+
+  unsigned GetRootLevel() const noexcept {
+    assert(!level_ends.empty());
+    return level_ends.size() - 1;
+  }
+
+  std::size_t GetLevelBegin(unsigned level) const noexcept {
+    return level > 0 ? level_ends[level - 1] : 0;
+  }
+
+  /**
+   * Determine the children of a box: indexes into #positions if
+   * the box is on the lowest level, or into the box level below.
+   */
+  std::pair<std::size_t, std::size_t>
+  GetChildren(unsigned level, std::size_t node) const noexcept {
+    const std::size_t n = level > 0
+      ? level_ends[level - 1] - GetLevelBegin(level - 1)
+      : positions.size();
+    const std::size_t begin = node * NODE_SIZE;
+    return {begin, std::min(begin + NODE_SIZE, n)};
+  }
+
+  template<class P>
+  void FindNearestIf(unsigned level, std::size_t node, const Point location,
+                     const P &predicate,
+                     std::pair<const T *, distance_type> &result) const noexcept {
+    const auto children = GetChildren(level, node);
+
+    if (level == 0) {
+      for (std::size_t i = children.first; i < children.second; ++i) {
+        const distance_type d = positions[i].SquareDistanceTo(location);
+        if (d <= result.second && predicate(values[i])) {
+          result.first = &values[i];
+          result.second = d;
+        }
+      }
+
+      return;
+    }
+
+    /* visit the nearest children first, to shrink the search
+       radius as quickly as possible */
+    const std::size_t base = GetLevelBegin(level - 1);
+    std::array<std::pair<distance_type, std::size_t>, NODE_SIZE> candidates;
+    unsigned n = 0;
+    for (std::size_t i = children.first; i < children.second; ++i) {
+      const distance_type d = boxes[base + i].SquareDistanceTo(location);
+      if (d <= result.second)
+        candidates[n++] = {d, i};
+    }
+
+    std::sort(candidates.begin(), std::next(candidates.begin(), n));
+
+    for (unsigned i = 0; i < n; ++i) {
+      if (candidates[i].first > result.second)
+        break;
+
+      FindNearestIf(level - 1, candidates[i].second, location,
+                    predicate, result);
+    }
+  }
+
+  template<class V>
+  void VisitWithinRange(unsigned level, std::size_t node, const Point location,
+                        distance_type square_range, V &visitor) const {
+    const auto children = GetChildren(level, node);
+
+    if (level == 0) {
+      for (std::size_t i = children.first; i < children.second; ++i)
+        if (positions[i].SquareDistanceTo(location) <= square_range)
+          visitor((const T &)values[i]);
+
+      return;
+    }
+
+    const std::size_t base = GetLevelBegin(level - 1);
+    for (std::size_t i = children.first; i < children.second; ++i)
+      if (boxes[base + i].SquareDistanceTo(location) <= square_range)
+        VisitWithinRange(level - 1, i, location, square_range, visitor);
+  }
+};
+
+#endif
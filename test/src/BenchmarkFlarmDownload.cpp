@@ -0,0 +1,195 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Downloads a simulated season of flights from the FLARM emulator
+ * over a simulated serial link and prints the (virtual) transfer
+ * time.  Each configuration is compared with the plain sequential
+ * download at the link's baud rate.
+ */
+
+#include "FLARMEmulator.hpp"
+#include "SimulatedLinkPort.hpp"
+#include "Device/Driver/FLARM/Device.hpp"
+#include "Device/RecordedFlight.hpp"
+#include "Operation/Operation.hpp"
+#include "io/NullDataHandler.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct BenchmarkConfig {
+  unsigned n_flights = 20;
+
+  /**
+   * The number of B records per flight (one per second).
+   */
+  unsigned n_fixes = 4 * 3600;
+
+  unsigned baud_rate = 19200;
+  unsigned bulk_baud_rate = 115200;
+  unsigned window = 4;
+
+  /**
+   * The one-way latency of the link [ms]; Bluetooth adds a lot.
+   */
+  unsigned latency = 20;
+
+  /**
+   * Lose 100 bytes at this position of every flight (0 = never).
+   */
+  std::size_t drop = 0;
+};
+
+static std::string
+MakeIGC(unsigned seed, unsigned n_fixes)
+{
+  std::string igc = "AFLA01234\r\nHFDTE120811\r\n";
+
+  char line[64];
+  for (unsigned i = 0; i < n_fixes; ++i) {
+    snprintf(line, sizeof(line), "B%06u%07uN%08uEA%05u%05u\r\n",
+             i % 240000, (seed * 7919 + i) % 10000000,
+             (seed * 104729 + i * 3) % 100000000, i % 3000, i % 3100);
+    igc += line;
+  }
+
+  return igc;
+}
+
+struct BenchmarkResult {
+  unsigned n_ok = 0;
+  std::size_t bytes = 0;
+  double time = 0;
+};
+
+static BenchmarkResult
+Run(const BenchmarkConfig &config, unsigned bulk_baud_rate, unsigned window,
+    Path path)
+{
+  NullDataHandler handler;
+  FLARMEmulator emulator;
+  SimulatedLink link(handler, *emulator.handler, config.baud_rate,
+                     config.latency / 1000.);
+  NullOperationEnvironment env;
+
+  emulator.port = &link.GetDevicePort();
+  emulator.env = &env;
+  emulator.echo = false;
+
+  for (unsigned i = 0; i < config.n_flights; ++i)
+    emulator.flights.push_back({"2011-08-12|12:23:48|04:00:00|PILOT|ID|Club",
+                                MakeIGC(i, config.n_fixes)});
+
+  FlarmDevice device(link.GetHostPort(), bulk_baud_rate);
+  device.SetDownloadWindow(window);
+
+  BenchmarkResult result;
+
+  for (unsigned i = 0; i < config.n_flights; ++i) {
+    if (config.drop > 0)
+      link.InjectDrop(link.bytes_to_host + config.drop, 100);
+
+    RecordedFlightInfo flight;
+    flight.internal.flarm = i;
+    if (device.DownloadFlight(flight, path, env))
+      ++result.n_ok;
+
+    result.bytes += emulator.flights[i].igc.length();
+  }
+
+  device.EnableNMEA(env);
+
+  result.time = link.GetTime();
+  return result;
+}
+
+static void
+Print(const char *name, const BenchmarkResult &result,
+      const BenchmarkResult &baseline)
+{
+  printf("%-12s %3u flights %8zu kB %8.1f s %7.1f kB/s %5.2fx\n",
+         name, result.n_ok, result.bytes / 1024, result.time,
+         result.bytes / 1024. / result.time, baseline.time / result.time);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--flights=N] [--fixes=N] [--baud=N] [--bulk=N] [--window=N]\n"
+            "    [--latency=MS] [--drop=BYTES] OUTPUT.igc");
+
+  BenchmarkConfig config;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--flights=")) != nullptr)
+      config.n_flights = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--fixes=")) != nullptr)
+      config.n_fixes = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--baud=")) != nullptr)
+      config.baud_rate = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--bulk=")) != nullptr)
+      config.bulk_baud_rate = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--window=")) != nullptr)
+      config.window = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--latency=")) != nullptr)
+      config.latency = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--drop=")) != nullptr)
+      config.drop = strtoul(value, nullptr, 10);
+    else
+      args.UsageError();
+  }
+
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  if (config.n_flights == 0 || config.n_flights > 255 ||
+      config.baud_rate == 0 || config.window == 0)
+    args.UsageError();
+
+  const auto baseline = Run(config, 0, 1, path);
+  Print("sequential", baseline, baseline);
+  Print("pipelined", Run(config, 0, config.window, path), baseline);
+
+  if (config.bulk_baud_rate != 0) {
+    Print("bulk", Run(config, config.bulk_baud_rate, 1, path), baseline);
+    Print("bulk+pipe",
+          Run(config, config.bulk_baud_rate, config.window, path), baseline);
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
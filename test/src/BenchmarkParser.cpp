@@ -0,0 +1,299 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Runs the LLVMFuzzerTestOneInput() entry point of one of the
+ * fuzzers (see fuzzer/src) over input files and reports throughput
+ * and heap allocations.  Each file is benchmarked as it is, repeated
+ * to make a large input ("--scale") and with CR LF line endings, as
+ * sent by most devices, which the line readers have to strip.
+ *
+ * With "--baseline", the results are compared with a baseline file
+ * and the program fails if the throughput has dropped by more than
+ * the threshold or if there are more allocations than before.  If
+ * the baseline file does not exist (or with "--update"), it is
+ * created instead.
+ */
+
+#include "system/Args.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static uint64_t n_allocations, allocated_bytes;
+
+void *
+operator new(std::size_t size)
+{
+  ++n_allocations;
+  allocated_bytes += size;
+
+  void *p = malloc(size > 0 ? size : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+
+  return p;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  free(p);
+}
+
+struct BenchmarkResult {
+  double mb_per_second, lines_per_second;
+  uint64_t allocations, bytes;
+};
+
+/**
+ * Maps the case name to throughput (MB/s) and allocations.
+ */
+using Baseline = std::map<std::string, std::pair<double, uint64_t>, std::less<>>;
+
+static std::string
+LoadFile(const char *path)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    throw std::runtime_error(std::string("Failed to open ") + path);
+
+  std::string result;
+  char buffer[65536];
+  size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    result.append(buffer, nbytes);
+
+  fclose(file);
+  return result;
+}
+
+static Baseline
+LoadBaseline(const char *path)
+{
+  Baseline baseline;
+
+  FILE *file = fopen(path, "r");
+  if (file == nullptr)
+    return baseline;
+
+  char name[1024];
+  double mb_per_second;
+  unsigned long long allocations;
+  while (fscanf(file, "%1023s %lf %llu", name, &mb_per_second,
+                &allocations) == 3)
+    baseline[name] = {mb_per_second, allocations};
+
+  fclose(file);
+  return baseline;
+}
+
+static BenchmarkResult
+Benchmark(const std::string &input, duration<double> min_time) noexcept
+{
+  const auto *data = (const uint8_t *)input.data();
+
+  /* the first run warms up the caches and counts the allocations,
+     which are the same in every run */
+  const uint64_t allocations_before = n_allocations;
+  const uint64_t bytes_before = allocated_bytes;
+  LLVMFuzzerTestOneInput(data, input.size());
+
+  BenchmarkResult result;
+  result.allocations = n_allocations - allocations_before;
+  result.bytes = allocated_bytes - bytes_before;
+
+  unsigned iterations = 0;
+  const auto start = steady_clock::now();
+  duration<double> elapsed;
+  do {
+    LLVMFuzzerTestOneInput(data, input.size());
+    ++iterations;
+    elapsed = steady_clock::now() - start;
+  } while (elapsed < min_time);
+
+  const double lines = std::count(input.begin(), input.end(), '\n') + 1;
+
+  result.mb_per_second = input.size() * iterations / elapsed.count() / 1e6;
+  result.lines_per_second = lines * iterations / elapsed.count();
+  return result;
+}
+
+/**
+ * @return false if a regression was detected
+ */
+static bool
+Check(const std::string &name, const BenchmarkResult &result,
+      const Baseline &baseline, double threshold) noexcept
+{
+  printf("%-40s %9.2f MB/s %12.0f lines/s %9llu allocs %11llu bytes",
+         name.c_str(), result.mb_per_second, result.lines_per_second,
+         (unsigned long long)result.allocations,
+         (unsigned long long)result.bytes);
+
+  bool success = true;
+
+  const auto i = baseline.find(name);
+  if (i != baseline.end()) {
+    const auto [mb_per_second, allocations] = i->second;
+
+    if (result.mb_per_second < mb_per_second * (1 - threshold)) {
+      printf("  REGRESSION: was %.2f MB/s", mb_per_second);
+      success = false;
+    }
+
+    if (result.allocations > allocations) {
+      printf("  REGRESSION: was %llu allocs",
+             (unsigned long long)allocations);
+      success = false;
+    }
+  }
+
+  printf("\n");
+  return success;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--baseline=PATH] [--update] [--threshold=PERCENT]\n"
+            "    [--scale=N] [--min-time=MS] FILE...\n\n"
+            "Runs the parser over the files and reports throughput and\n"
+            "heap allocations; compares them with the baseline file.");
+
+  const char *baseline_path = nullptr;
+  bool update = false;
+  double threshold = 0.2;
+  unsigned scale = 64;
+  duration<double> min_time = milliseconds{200};
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--baseline=")) != nullptr)
+      baseline_path = value;
+    else if (StringIsEqual(arg, "--update"))
+      update = true;
+    else if ((value = StringAfterPrefix(arg, "--threshold=")) != nullptr)
+      threshold = strtod(value, nullptr) / 100;
+    else if ((value = StringAfterPrefix(arg, "--scale=")) != nullptr)
+      scale = std::max(strtoul(value, nullptr, 10), 1UL);
+    else if ((value = StringAfterPrefix(arg, "--min-time=")) != nullptr)
+      min_time = milliseconds{strtoul(value, nullptr, 10)};
+    else
+      args.UsageError();
+  }
+
+  if (args.IsEmpty())
+    args.UsageError();
+
+  Baseline baseline;
+  if (baseline_path != nullptr && !update)
+    baseline = LoadBaseline(baseline_path);
+
+  /* without a baseline, record one */
+  if (baseline_path != nullptr && baseline.empty())
+    update = true;
+
+  std::vector<std::pair<std::string, BenchmarkResult>> results;
+  bool success = true;
+
+  while (!args.IsEmpty()) {
+    const char *path = args.ExpectNext();
+    const std::string input = LoadFile(path);
+
+    std::string name = path;
+    if (const auto slash = name.rfind('/'); slash != name.npos)
+      name.erase(0, slash + 1);
+
+    std::string scaled;
+    scaled.reserve(input.size() * scale);
+    for (unsigned i = 0; i < scale; ++i)
+      scaled += input;
+
+    std::string crlf;
+    crlf.reserve(input.size() + input.size() / 16);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      if (input[i] == '\n' && (i == 0 || input[i - 1] != '\r'))
+        crlf.push_back('\r');
+      crlf.push_back(input[i]);
+    }
+
+    const std::pair<std::string, const std::string &> cases[] = {
+      {name, input},
+      {name + "*" + std::to_string(scale), scaled},
+      {name + ":crlf", crlf},
+    };
+
+    for (const auto &[case_name, case_input] : cases) {
+      const auto result = Benchmark(case_input, min_time);
+      if (!Check(case_name, result, baseline, threshold))
+        success = false;
+
+      results.emplace_back(case_name, result);
+    }
+  }
+
+  if (update && baseline_path != nullptr) {
+    FILE *file = fopen(baseline_path, "w");
+    if (file == nullptr)
+      throw std::runtime_error(std::string("Failed to create ") +
+                               baseline_path);
+
+    for (const auto &[name, result] : results)
+      fprintf(file, "%s %.2f %llu\n", name.c_str(), result.mb_per_second,
+              (unsigned long long)result.allocations);
+
+    fclose(file);
+    printf("baseline written to %s\n", baseline_path);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
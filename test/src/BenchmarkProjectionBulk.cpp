@@ -0,0 +1,114 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares the speed of the single-point and the array version of
+ * Projection::GeoToScreen() and verifies that both return the same
+ * coordinates.
+ */
+
+#include "Projection/Projection.hpp"
+#include "Screen/Layout.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+unsigned Layout::scale_1024 = 1024;
+
+using std::chrono::steady_clock;
+
+class TestProjection : public Projection {
+public:
+  TestProjection() {
+    SetScreenOrigin(320, 240);
+    SetScale(640. / (100000 * 2));
+    SetScreenAngle(Angle::Degrees(37));
+    SetGeoLocation(GeoPoint(Angle::Degrees(7.7061111111111114),
+                            Angle::Degrees(51.051944444444445)));
+  }
+};
+
+/**
+ * Generates a polygon similar to an airspace or a topography shape
+ * around the projection's location.
+ */
+static std::vector<GeoPoint>
+MakePoints(const GeoPoint &center, unsigned n)
+{
+  std::vector<GeoPoint> points;
+  points.reserve(n);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const Angle bearing = Angle::FullCircle() * i / n;
+    const Angle radius = Angle::Degrees(0.2 + (i * 7919 % 600) * 0.001);
+    points.emplace_back(center.longitude + radius * bearing.sin() * 1.6,
+                        center.latitude + radius * bearing.cos());
+  }
+
+  return points;
+}
+
+template<typename F>
+static double
+Measure(unsigned iterations, unsigned n, F &&f)
+{
+  const auto start = steady_clock::now();
+  for (unsigned i = 0; i < iterations; ++i)
+    f();
+  const std::chrono::duration<double, std::nano> elapsed =
+    steady_clock::now() - start;
+  return elapsed.count() / (double(iterations) * n);
+}
+
+int main(int argc, char **argv)
+{
+  const TestProjection projection;
+
+  constexpr unsigned N_POINTS = 4096;
+  const unsigned iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 4096;
+
+  const auto points = MakePoints(projection.GetGeoLocation(), N_POINTS);
+  std::vector<PixelPoint> single(N_POINTS), bulk(N_POINTS);
+
+  const double single_ns = Measure(iterations, N_POINTS, [&]{
+    for (unsigned i = 0; i < N_POINTS; ++i)
+      single[i] = projection.GeoToScreen(points[i]);
+  });
+
+  const double bulk_ns = Measure(iterations, N_POINTS, [&]{
+    projection.GeoToScreen(points.data(), bulk.data(), N_POINTS);
+  });
+
+  printf("single: %.2f ns/point\n", single_ns);
+  printf("bulk:   %.2f ns/point\n", bulk_ns);
+
+  if (single != bulk) {
+    fprintf(stderr, "Results differ\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
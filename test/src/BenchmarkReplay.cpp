@@ -0,0 +1,382 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Headless replay of an IGC or NMEA file through the complete
+ * calculation pipeline (BasicComputer, GlideComputer with task,
+ * route, warning and contest computers), as fast as the CPU allows.
+ *
+ * Per-stage timing histograms are printed at the end, followed by
+ * an MD5 digest of the bit patterns of the most important results.
+ * Two runs with the same input and the same code produce the same
+ * digest; "--trace" prints the values of each fix in hexadecimal
+ * floating point notation, which allows locating the first
+ * difference with diff(1).
+ */
+
+#include "DebugReplay.hpp"
+#include "TimingHistogram.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/LoadFile.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "io/FileLineReader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/MD5.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <memory>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitors::Update(const NMEAInfo &basic, const DerivedInfo &calculated,
+                          const ComputerSettings &settings) noexcept
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+struct BenchmarkStages {
+  /**
+   * Parsing the input and BasicComputer (the work of the
+   * MergeThread).
+   */
+  TimingHistogram merge;
+
+  /**
+   * GlideComputer::ProcessGPS() (the fast part of the
+   * CalculationThread).
+   */
+  TimingHistogram gps;
+
+  /**
+   * GlideComputer::ProcessIdle() (contest, route, warnings,
+   * statistics).
+   */
+  TimingHistogram idle;
+
+  /**
+   * The final GlideComputer::ProcessExhaustive() call.
+   */
+  TimingHistogram exhaustive;
+
+  void Print() const noexcept {
+    merge.Print("merge");
+    gps.Print("gps");
+    idle.Print("idle");
+    exhaustive.Print("exhaustive");
+  }
+};
+
+/**
+ * Feeds the bit patterns of selected results into a #MD5 and
+ * optionally prints them.
+ */
+class ResultDigest {
+  MD5 md5;
+  FILE *trace;
+
+public:
+  explicit ResultDigest(FILE *_trace) noexcept
+    :trace(_trace) {
+    md5.Initialise();
+  }
+
+  void Append(double value) noexcept {
+    md5.Append(&value, sizeof(value));
+    if (trace != nullptr)
+      fprintf(trace, " %a", value);
+  }
+
+  void Append(bool value) noexcept {
+    md5.Append((uint8_t)value);
+    if (trace != nullptr)
+      fprintf(trace, " %u", (unsigned)value);
+  }
+
+  void Append(const DerivedInfo &calculated) noexcept {
+    Append(calculated.flight.flying);
+    Append(calculated.circling);
+    Append(calculated.average);
+    Append(calculated.netto_average);
+    Append(calculated.gr);
+    Append(calculated.estimated_wind.bearing.Degrees());
+    Append(calculated.estimated_wind.norm);
+    Append(calculated.terrain_altitude);
+    Append(calculated.V_stf);
+    Append(calculated.auto_mac_cready);
+
+    const ElementStat &total = calculated.task_stats.total;
+    Append(total.remaining.IsDefined());
+    if (total.remaining.IsDefined())
+      Append(total.remaining.GetDistance());
+
+    Append(total.solution_remaining.IsOk());
+    if (total.solution_remaining.IsOk()) {
+      Append(total.solution_remaining.altitude_difference);
+      Append(total.time_remaining_now.count());
+    }
+
+    Append(calculated.ordered_task_stats.task_finished);
+    Append(calculated.ordered_task_stats.distance_scored);
+    Append(calculated.contest_stats.GetResult().score);
+    Append(calculated.contest_stats.GetResult().distance);
+    Append(calculated.airspace_warnings.latest.IsValid());
+    Append(calculated.planned_route.size() > 0);
+  }
+
+  void Append(const MoreData &basic, const DerivedInfo &calculated) noexcept {
+    if (trace != nullptr)
+      fprintf(trace, "%a", basic.time.ToDuration().count());
+
+    Append(calculated);
+
+    if (trace != nullptr)
+      fputc('\n', trace);
+  }
+
+  void Print() noexcept {
+    md5.Finalize();
+
+    char buffer[MD5::DIGEST_LENGTH + 1];
+    md5.GetDigest(buffer);
+    printf("digest: %s\n", buffer);
+  }
+};
+
+static void
+LoadAirspaces(Path path, Airspaces &airspaces)
+{
+  FileLineReader reader(path, Charset::AUTO);
+
+  ConsoleOperationEnvironment operation;
+  if (!ParseAirspaceFile(airspaces, reader, operation))
+    throw std::runtime_error("Failed to parse airspace file");
+
+  airspaces.Optimise();
+}
+
+static void
+LoadWaypoints(Path path, Waypoints &waypoints)
+{
+  ConsoleOperationEnvironment operation;
+  if (!ReadWaypointFile(path, waypoints,
+                        WaypointFactory(WaypointOrigin::NONE),
+                        operation))
+    throw std::runtime_error("Failed to parse waypoint file");
+
+  waypoints.Optimise();
+}
+
+static void
+PrintIdleTasks(const IdleScheduler &scheduler) noexcept
+{
+  for (const auto &task : scheduler.GetTasks()) {
+    const auto &m = task.metrics;
+    printf("idle task %s: runs=%u steps=%u avg=%lld us max=%lld us"
+           " overruns=%u\n",
+           task.name, m.runs, m.steps,
+           (long long)duration_cast<microseconds>(m.GetAverageDuration()).count(),
+           (long long)duration_cast<microseconds>(m.max_duration).count(),
+           m.overruns);
+  }
+}
+
+/**
+ * @return the number of fixes which were processed
+ */
+static unsigned
+Run(DebugReplay &replay, GlideComputer &glide_computer,
+    FloatDuration idle_interval,
+    BenchmarkStages &stages, ResultDigest &digest)
+{
+  TimeStamp last_idle = TimeStamp::Undefined();
+  unsigned n_fixes = 0;
+
+  while (true) {
+    {
+      const TimingHistogram::Scope scope(stages.merge);
+      if (!replay.Next())
+        break;
+    }
+
+    const MoreData &basic = replay.Basic();
+    glide_computer.ReadBlackboard(basic);
+    glide_computer.Expire();
+
+    {
+      const TimingHistogram::Scope scope(stages.gps);
+      glide_computer.ProcessGPS();
+    }
+
+    /* unlike the CalculationThread, schedule idle calculations by
+       GPS time instead of wall clock time, to make the results
+       independent of the CPU speed */
+    if (basic.time_available &&
+        (!last_idle.IsDefined() || basic.time < last_idle ||
+         basic.time - last_idle >= idle_interval)) {
+      last_idle = basic.time;
+
+      const TimingHistogram::Scope scope(stages.idle);
+      glide_computer.ProcessIdle();
+    }
+
+    digest.Append(glide_computer.Basic(), glide_computer.Calculated());
+    ++n_fixes;
+  }
+
+  {
+    const TimingHistogram::Scope scope(stages.exhaustive);
+    glide_computer.ProcessExhaustive();
+  }
+
+  digest.Append(glide_computer.Basic(), glide_computer.Calculated());
+  return n_fixes;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[--airspace=PATH] [--waypoints=PATH] [--task=PATH]\n"
+            "    [--idle=MS] [--trace] DRIVER FILE\n\n"
+            "Replays the file through the whole calculation pipeline as\n"
+            "fast as possible and prints per-stage timing histograms and\n"
+            "a digest of the results.  With --trace, the results of each\n"
+            "fix are printed for bit-exact comparison.");
+
+  const char *airspace_path = nullptr, *waypoints_path = nullptr;
+  const char *task_path = nullptr;
+  FloatDuration idle_interval = milliseconds{500};
+  bool trace = false;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr)
+      airspace_path = value;
+    else if ((value = StringAfterPrefix(arg, "--waypoints=")) != nullptr)
+      waypoints_path = value;
+    else if ((value = StringAfterPrefix(arg, "--task=")) != nullptr)
+      task_path = value;
+    else if ((value = StringAfterPrefix(arg, "--idle=")) != nullptr)
+      idle_interval = milliseconds{strtoul(value, nullptr, 10)};
+    else if (StringIsEqual(arg, "--trace"))
+      trace = true;
+    else
+      args.UsageError();
+  }
+
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  Waypoints way_points;
+  if (waypoints_path != nullptr)
+    LoadWaypoints(Path(waypoints_path), way_points);
+
+  Airspaces airspace_database;
+  if (airspace_path != nullptr)
+    LoadAirspaces(Path(airspace_path), airspace_database);
+
+  ComputerSettings settings_computer;
+  settings_computer.SetDefaults();
+  settings_computer.polar.glide_polar_task = GlidePolar(1);
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  TaskManager task_manager(task_behaviour, way_points);
+  task_manager.SetGlidePolar(settings_computer.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager,
+                                              settings_computer.task);
+
+  if (task_path != nullptr) {
+    auto task = LoadTask(Path(task_path), task_behaviour, &way_points);
+    if (task)
+      protected_task_manager.TaskCommit(*task);
+  }
+
+  GlideComputer glide_computer(settings_computer, way_points,
+                               airspace_database, protected_task_manager,
+                               task_events);
+  glide_computer.Initialise();
+
+  /* one step per idle task and cycle, to keep the digest independent
+     of the CPU speed */
+  glide_computer.SetIdleTimeSlicing(false);
+
+  BenchmarkStages stages;
+  ResultDigest digest(trace ? stdout : nullptr);
+
+  const auto start = steady_clock::now();
+  const unsigned n_fixes = Run(*replay, glide_computer, idle_interval,
+                               stages, digest);
+  const auto elapsed = steady_clock::now() - start;
+
+  printf("fixes: %u, elapsed: %lld ms\n", n_fixes,
+         (long long)duration_cast<milliseconds>(elapsed).count());
+  stages.Print();
+  PrintIdleTasks(glide_computer.GetIdleScheduler());
+  digest.Print();
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
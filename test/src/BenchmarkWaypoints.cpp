@@ -0,0 +1,244 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares the speed of spatial waypoint queries: the QuadTree with
+ * a type-erased std::function visitor (the old Waypoints API), the
+ * QuadTree with an inlined visitor and the PackedPointIndex which is
+ * now used by Waypoints.  All of them must return the same results.
+ *
+ * Without a file, 50000 random waypoints are generated.
+ */
+
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/QuadTree.hxx"
+#include "util/PackedPointIndex.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using std::chrono::steady_clock;
+
+struct WaypointAccessor {
+  int GetX(const WaypointPtr &wp) const noexcept {
+    return wp->flat_location.x;
+  }
+
+  int GetY(const WaypointPtr &wp) const noexcept {
+    return wp->flat_location.y;
+  }
+};
+
+using Tree = QuadTree<WaypointPtr, WaypointAccessor>;
+using Index = PackedPointIndex<WaypointPtr, WaypointAccessor>;
+
+static void
+LoadWaypoints(Path path, Waypoints &waypoints)
+{
+  ConsoleOperationEnvironment operation;
+  if (!ReadWaypointFile(path, waypoints,
+                        WaypointFactory(WaypointOrigin::NONE),
+                        operation))
+    throw std::runtime_error("ReadWaypointFile() failed");
+}
+
+/**
+ * Generates waypoints scattered over central Europe, denser around
+ * a few "regions", similar to a country-wide turnpoint file.
+ */
+static void
+GenerateWaypoints(Waypoints &waypoints, unsigned n)
+{
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> region(-6, 6);
+  std::normal_distribution<double> spread(0, 0.8);
+
+  GeoPoint center(Angle::Degrees(7.0), Angle::Degrees(50.0));
+  for (unsigned i = 0; i < n; ++i) {
+    if (i % 1000 == 0)
+      center = GeoPoint(Angle::Degrees(10 + region(random)),
+                        Angle::Degrees(48 + region(random) / 2));
+
+    Waypoint wp(GeoPoint(center.longitude + Angle::Degrees(spread(random)),
+                         center.latitude + Angle::Degrees(spread(random) / 2)));
+    wp.type = i % 8 == 0 ? Waypoint::Type::AIRFIELD : Waypoint::Type::NORMAL;
+    waypoints.Append(std::move(wp));
+  }
+}
+
+template<typename F>
+static double
+Measure(unsigned n, F &&f)
+{
+  const auto start = steady_clock::now();
+  for (unsigned i = 0; i < n; ++i)
+    f(i);
+  const std::chrono::duration<double, std::nano> elapsed =
+    steady_clock::now() - start;
+  return elapsed.count() / n;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[--queries=N] [--range=UNITS] [PATH]");
+
+  unsigned n_queries = 100000;
+  unsigned range = 200;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--queries=")) != nullptr)
+      n_queries = strtoul(value, nullptr, 10);
+    else if ((value = StringAfterPrefix(arg, "--range=")) != nullptr)
+      range = strtoul(value, nullptr, 10);
+    else
+      args.UsageError();
+  }
+
+  Waypoints waypoints;
+  if (args.IsEmpty())
+    GenerateWaypoints(waypoints, 50000);
+  else
+    LoadWaypoints(args.ExpectNextPath(), waypoints);
+  args.ExpectEnd();
+
+  waypoints.Optimise();
+
+  if (waypoints.IsEmpty() || n_queries == 0) {
+    fprintf(stderr, "No waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<WaypointPtr> all(waypoints.begin(), waypoints.end());
+
+  Tree tree;
+  for (const auto &i : all)
+    tree.Add(i);
+  tree.Optimise();
+
+  const auto build_start = steady_clock::now();
+  Index index;
+  index.Build(all.begin(), all.end());
+  const std::chrono::duration<double, std::milli> build_elapsed =
+    steady_clock::now() - build_start;
+
+  /* query near random waypoints */
+  std::mt19937 random(1);
+  std::uniform_int_distribution<std::size_t> pick(0, all.size() - 1);
+  std::uniform_int_distribution<int> offset(-int(range), int(range));
+  std::vector<Tree::Point> queries;
+  queries.reserve(n_queries);
+  for (unsigned i = 0; i < n_queries; ++i) {
+    const FlatGeoPoint &p = all[pick(random)]->flat_location;
+    queries.emplace_back(p.x + offset(random), p.y + offset(random));
+  }
+
+  std::vector<unsigned> counts1(n_queries), counts2(n_queries),
+    counts3(n_queries);
+
+  const double visit_function_ns = Measure(n_queries, [&](unsigned i){
+    unsigned n = 0;
+    std::function<void(const WaypointPtr &)> visitor =
+      [&n](const WaypointPtr &){ ++n; };
+    tree.VisitWithinRange(queries[i], range, visitor);
+    counts1[i] = n;
+  });
+
+  const double visit_tree_ns = Measure(n_queries, [&](unsigned i){
+    unsigned n = 0;
+    auto visitor = [&n](const WaypointPtr &){ ++n; };
+    tree.VisitWithinRange(queries[i], range, visitor);
+    counts2[i] = n;
+  });
+
+  const double visit_index_ns = Measure(n_queries, [&](unsigned i){
+    unsigned n = 0;
+    auto visitor = [&n](const WaypointPtr &){ ++n; };
+    index.VisitWithinRange({queries[i].x, queries[i].y}, range, visitor);
+    counts3[i] = n;
+  });
+
+  const auto is_landable = [](const WaypointPtr &wp){
+    return wp->IsLandable();
+  };
+
+  /* compare the square distances of the nearest results */
+  constexpr unsigned NOT_FOUND = ~0u;
+  std::vector<unsigned> nearest1(n_queries), nearest2(n_queries);
+
+  const double nearest_tree_ns = Measure(n_queries, [&](unsigned i){
+    const auto found = tree.FindNearestIf(queries[i], range, is_landable);
+    nearest1[i] = found.first != tree.end() ? found.second : NOT_FOUND;
+  });
+
+  const double nearest_index_ns = Measure(n_queries, [&](unsigned i){
+    const auto found = index.FindNearestIf({queries[i].x, queries[i].y},
+                                           range, is_landable);
+    nearest2[i] = found.first != nullptr ? found.second : NOT_FOUND;
+  });
+
+  unsigned long total = 0;
+  for (const unsigned n : counts1)
+    total += n;
+
+  printf("waypoints: %zu, queries: %u, range: %u, mean results: %.1f\n",
+         all.size(), n_queries, range, double(total) / n_queries);
+  printf("index build: %.2f ms\n", build_elapsed.count());
+  printf("VisitWithinRange QuadTree+std::function: %8.1f ns/query\n",
+         visit_function_ns);
+  printf("VisitWithinRange QuadTree+template:      %8.1f ns/query\n",
+         visit_tree_ns);
+  printf("VisitWithinRange PackedPointIndex:       %8.1f ns/query\n",
+         visit_index_ns);
+  printf("FindNearestIf QuadTree:                  %8.1f ns/query\n",
+         nearest_tree_ns);
+  printf("FindNearestIf PackedPointIndex:          %8.1f ns/query\n",
+         nearest_index_ns);
+
+  if (counts1 != counts2 || counts1 != counts3 || nearest1 != nearest2) {
+    fprintf(stderr, "Results differ\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
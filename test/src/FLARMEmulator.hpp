@@ -27,6 +27,7 @@ Copyright_License {
 #include "DeviceEmulator.hpp"
 #include "Device/Util/LineSplitter.hpp"
 #include "Device/Driver/FLARM/BinaryProtocol.hpp"
+#include "Device/Driver/FLARM/CRC16.hpp"
 #include "Device/Util/NMEAWriter.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
@@ -34,18 +35,56 @@ Copyright_License {
 #include "util/StaticFifoBuffer.hxx"
 #include "util/StaticString.hxx"
 
+#include <algorithm>
 #include <string>
 #include <map>
+#include <vector>
 #include <stdio.h>
 #include <string.h>
 
 class FLARMEmulator : public Emulator, PortLineSplitter {
+  static constexpr size_t IGC_BLOCK_SIZE = 512;
+
   std::map<std::string, std::string> settings;
 
   bool binary;
   StaticFifoBuffer<std::byte, 256u> binary_buffer;
 
+  /**
+   * The flight selected with MT_SELECTRECORD, or -1.
+   */
+  int selected = -1;
+
+  /**
+   * The number of IGC bytes of the selected flight which have been
+   * sent already.
+   */
+  size_t igc_position;
+  bool igc_finished;
+
+  /**
+   * The baud rate before MT_SETBAUDRATE; 0 if it was not changed.
+   */
+  unsigned default_baud_rate = 0;
+
 public:
+  struct Flight {
+    /**
+     * The MT_GETRECORDINFO response, e.g.
+     * "2011-08-12|12:23:48|02:03:25|PILOT|ID|Class".
+     */
+    std::string info;
+
+    std::string igc;
+  };
+
+  std::vector<Flight> flights;
+
+  /**
+   * Copy received NMEA data to stdout?
+   */
+  bool echo = true;
+
   FLARMEmulator():binary(false) {
     handler = this;
   }
@@ -97,75 +136,213 @@ private:
     binary_buffer.Clear();
   }
 
-  size_t Unescape(const uint8_t *const data, const uint8_t *const end,
-                  void *_dest, size_t length) {
-    uint8_t *dest = (uint8_t *)_dest;
-
-    const uint8_t *p;
-    for (p = data; length > 0; ++p) {
-      if (p >= end)
-        return std::min(p - data, end - data - 1);
-
-      if (*p == FLARM::START_FRAME)
-        return std::min(p - data, end - data - 1);
-
-      if (*p == FLARM::ESCAPE) {
-        ++p;
-        if (p >= end)
-          return std::min(p - data, end - data - 1);
-
-        if (*p == FLARM::ESCAPE_START)
-          *dest++ = FLARM::START_FRAME;
-        else if (*p == FLARM::ESCAPE_ESCAPE)
-          *dest++ = FLARM::ESCAPE;
+  /**
+   * Unescape bytes from [p, end) until #length bytes have been
+   * written to #dest.
+   *
+   * @return the new source position or nullptr if the input is
+   * incomplete or malformed
+   */
+  static const uint8_t *Unescape(const uint8_t *p, const uint8_t *end,
+                                 uint8_t *dest, size_t length) noexcept {
+    while (length > 0) {
+      if (p == end || *p == FLARM::START_FRAME)
+        return nullptr;
+
+      uint8_t ch = *p++;
+      if (ch == FLARM::ESCAPE) {
+        if (p == end)
+          return nullptr;
+
+        ch = *p++;
+        if (ch == FLARM::ESCAPE_START)
+          ch = FLARM::START_FRAME;
+        else if (ch == FLARM::ESCAPE_ESCAPE)
+          ch = FLARM::ESCAPE;
         else
-          return std::min(p - data, end - data - 1);
-      } else
-        *dest++ = *p;
+          return nullptr;
+      }
+
+      *dest++ = ch;
+      --length;
     }
 
-    return p - data;
+    return p;
   }
 
-  void SendACK(uint16_t sequence_number) {
-    uint16_t payload = ToLE16(sequence_number);
+  void SendFrame(uint16_t sequence_number, FLARM::MessageType type,
+                 const void *data, size_t length) {
+    std::vector<uint8_t> payload(2 + length);
+    const uint16_t le_sequence_number = ToLE16(sequence_number);
+    memcpy(payload.data(), &le_sequence_number, 2);
+    if (length > 0)
+      memcpy(payload.data() + 2, data, length);
+
     FLARM::FrameHeader header =
-      FLARM::PrepareFrameHeader(sequence_number, FLARM::MT_ACK,
-                                &payload, sizeof(payload));
+      FLARM::PrepareFrameHeader(sequence_number, type,
+                                payload.data(), payload.size());
     port->Write(FLARM::START_FRAME);
     FLARM::SendEscaped(*port, &header, sizeof(header), *env,
                        std::chrono::seconds(2));
-    FLARM::SendEscaped(*port, &payload, sizeof(payload), *env,
+    FLARM::SendEscaped(*port, payload.data(), payload.size(), *env,
                        std::chrono::seconds(2));
   }
 
+  void SendACK(uint16_t sequence_number,
+               const void *data=nullptr, size_t length=0) {
+    SendFrame(sequence_number, FLARM::MT_ACK, data, length);
+  }
+
+  void SendNACK(uint16_t sequence_number) {
+    SendFrame(sequence_number, FLARM::MT_NACK, nullptr, 0);
+  }
+
+  static constexpr unsigned CodeToBaudRate(uint8_t code) noexcept {
+    switch (code) {
+    case 0: return 4800;
+    case 1: return 9600;
+    case 2: return 19200;
+    case 4: return 38400;
+    case 5: return 57600;
+    case 6: return 115200;
+    case 7: return 230400;
+    default: return 0;
+    }
+  }
+
+  void SelectRecord(uint16_t sequence_number, const uint8_t *payload,
+                    size_t length) {
+    if (length < 1 || payload[0] >= flights.size()) {
+      SendNACK(sequence_number);
+      return;
+    }
+
+    selected = payload[0];
+    igc_position = 0;
+    igc_finished = false;
+    SendACK(sequence_number);
+  }
+
+  void GetRecordInfo(uint16_t sequence_number) {
+    if (selected < 0) {
+      SendNACK(sequence_number);
+      return;
+    }
+
+    /* including the null terminator */
+    const std::string &info = flights[selected].info;
+    SendACK(sequence_number, info.c_str(), info.length() + 1);
+  }
+
+  void GetIGCData(uint16_t sequence_number) {
+    if (selected < 0 || igc_finished) {
+      SendNACK(sequence_number);
+      return;
+    }
+
+    const std::string &igc = flights[selected].igc;
+    const size_t n = std::min(IGC_BLOCK_SIZE, igc.length() - igc_position);
+
+    uint8_t payload[1 + IGC_BLOCK_SIZE + 1];
+    memcpy(payload + 1, igc.data() + igc_position, n);
+    igc_position += n;
+    payload[0] = igc.empty() ? 100 : igc_position * 100 / igc.length();
+
+    size_t length = 1 + n;
+    if (igc_position == igc.length()) {
+      payload[length++] = 0x1A;
+      igc_finished = true;
+    }
+
+    SendACK(sequence_number, payload, length);
+  }
+
+  void SetBaudRate(uint16_t sequence_number, const uint8_t *payload,
+                   size_t length) {
+    const unsigned baud_rate = length >= 1 ? CodeToBaudRate(payload[0]) : 0;
+    if (baud_rate == 0) {
+      SendNACK(sequence_number);
+      return;
+    }
+
+    /* acknowledge at the old baud rate, then switch */
+    SendACK(sequence_number);
+
+    if (default_baud_rate == 0)
+      default_baud_rate = port->GetBaudrate();
+    port->SetBaudrate(baud_rate);
+  }
+
+  /**
+   * Handle one frame at the beginning of the buffer.
+   *
+   * @return the number of bytes consumed; 0 if more data is needed
+   */
   size_t HandleBinary(const void *_data, size_t length) {
     const uint8_t *const data = (const uint8_t *)_data, *end = data + length;
-    const uint8_t *p = data;
 
-    p = std::find(p, end, FLARM::START_FRAME);
-    if (p == NULL)
-      return length;
+    const uint8_t *start = std::find(data, end, FLARM::START_FRAME);
+    if (start != data)
+      /* discard garbage before the frame */
+      return start - data;
 
-    ++p;
+    const uint8_t *next_start = std::find(start + 1, end, FLARM::START_FRAME);
 
     FLARM::FrameHeader header;
-    size_t nbytes = Unescape(p, end, &header, sizeof(header));
-    p += nbytes;
-    if (nbytes < sizeof(header))
+    const uint8_t *p = Unescape(start + 1, end, (uint8_t *)&header,
+                                sizeof(header));
+    if (p == nullptr)
+      /* incomplete, or broken by the next frame */
+      return next_start != end ? size_t(next_start - data) : 0;
+
+    const size_t frame_length = header.length;
+    uint8_t payload[64];
+    const size_t payload_length = frame_length - sizeof(header);
+    if (frame_length < sizeof(header) || payload_length > sizeof(payload))
+      return p - data;
+
+    if (payload_length > 0) {
+      p = Unescape(p, end, payload, payload_length);
+      if (p == nullptr)
+        return next_start != end ? size_t(next_start - data) : 0;
+    }
+
+    if (header.crc != FLARM::CalculateCRC(header,
+                                          payload_length > 0 ? payload : nullptr,
+                                          payload_length))
       return p - data;
 
-    //XXX size_t payload_length = header.GetLength();
+    const uint16_t sequence_number = header.sequence_number;
 
     switch (header.type) {
     case FLARM::MT_PING:
+      SendACK(sequence_number);
+      break;
+
     case FLARM::MT_SELECTRECORD:
-      SendACK(header.sequence_number);
+      SelectRecord(sequence_number, payload, payload_length);
+      break;
+
+    case FLARM::MT_GETRECORDINFO:
+      GetRecordInfo(sequence_number);
+      break;
+
+    case FLARM::MT_GETIGCDATA:
+      GetIGCData(sequence_number);
+      break;
+
+    case FLARM::MT_SETBAUDRATE:
+      SetBaudRate(sequence_number, payload, payload_length);
       break;
 
     case FLARM::MT_EXIT:
-      SendACK(header.sequence_number);
+      SendACK(sequence_number);
       binary = false;
+
+      if (default_baud_rate != 0) {
+        port->SetBaudrate(default_baud_rate);
+        default_baud_rate = 0;
+      }
       break;
     }
 
@@ -212,7 +389,8 @@ protected:
       BinaryReceived(s);
       return true;
     } else {
-      fwrite(s.data(), 1, s.size(), stdout);
+      if (echo)
+        fwrite(s.data(), 1, s.size(), stdout);
       return PortLineSplitter::DataReceived(s);
     }
   }
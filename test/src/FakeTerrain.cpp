@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "Terrain/RasterTerrain.hpp"
 
+#include <algorithm>
+
 TerrainHeight
 RasterMap::GetHeight(const GeoPoint &location) const noexcept
 {
@@ -47,3 +49,11 @@ RasterMap::FirstIntersection(const GeoPoint &origin, const int h_origin,
 {
   return Intersection::Invalid();
 }
+
+void
+RasterMap::ScanLine(const GeoPoint &start, const GeoPoint &end,
+                    TerrainHeight *buffer, unsigned size,
+                    bool interpolate) const noexcept
+{
+  std::fill_n(buffer, size, TerrainHeight::Invalid());
+}
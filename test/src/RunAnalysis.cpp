@@ -110,7 +110,10 @@ LoadFiles(Airspaces &airspace_database)
   terrain = RasterTerrain::OpenTerrain(nullptr, operation).release();
 
   const AtmosphericPressure pressure = AtmosphericPressure::Standard();
-  ReadAirspace(airspace_database, terrain, pressure, operation);
+  ReadAirspace(airspace_database, pressure, operation);
+
+  if (terrain != nullptr)
+    airspace_database.SetGroundLevels(*terrain);
 }
 
 static void
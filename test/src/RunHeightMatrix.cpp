@@ -49,14 +49,14 @@ try {
 
   {
     ConsoleOperationEnvironment operation;
-    LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
   }
 
   map.UpdateProjection();
 
   SharedMutex mutex;
   do {
-    UpdateTerrainTiles(archive.get(), map.GetTileCache(), mutex,
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
                        map.GetProjection(),
                        map.GetMapCenter(), 50000);
   } while (map.IsDirty());
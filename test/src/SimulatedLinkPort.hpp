@@ -0,0 +1,306 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SIMULATED_LINK_PORT_HPP
+#define XCSOAR_SIMULATED_LINK_PORT_HPP
+
+#include "Device/Port/Port.hpp"
+#include "Device/Error.hpp"
+#include "io/DataHandler.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+/**
+ * A simulated serial link between a #Port used by a driver ("host")
+ * and an emulator ("device").  Transfer time (10 bits per byte at
+ * the configured baud rate) and latency are accounted in virtual
+ * time, which advances only when the host waits for data.  This
+ * allows benchmarking protocols without actually waiting.
+ *
+ * Data sent while both sides disagree about the baud rate is lost,
+ * and a range of device-to-host bytes can be dropped to emulate a
+ * link hiccup.
+ */
+class SimulatedLink {
+  struct Chunk {
+    double time;
+    unsigned baud_rate;
+    std::vector<std::byte> data;
+  };
+
+  class HostPort final : public Port {
+    SimulatedLink &link;
+
+  public:
+    HostPort(SimulatedLink &_link, DataHandler &_handler) noexcept
+      :Port(nullptr, _handler), link(_link) {}
+
+    PortState GetState() const noexcept override {
+      return PortState::READY;
+    }
+
+    std::size_t Write(const void *data, std::size_t length) override {
+      link.HostWrite(data, length);
+      return length;
+    }
+
+    bool Drain() override {
+      link.now = std::max(link.now, link.host_tx_free);
+      return true;
+    }
+
+    void Flush() override {
+      link.Discard();
+      link.DiscardReady();
+    }
+
+    unsigned GetBaudrate() const noexcept override {
+      return link.host_baud_rate;
+    }
+
+    void SetBaudrate(unsigned baud_rate) override {
+      link.host_baud_rate = baud_rate;
+    }
+
+    bool StopRxThread() override {
+      return true;
+    }
+
+    bool StartRxThread() override {
+      return true;
+    }
+
+    std::size_t Read(void *buffer, std::size_t size) override {
+      return link.HostRead(buffer, size);
+    }
+
+    void WaitRead(std::chrono::steady_clock::duration timeout) override {
+      link.HostWaitRead(std::chrono::duration<double>(timeout).count());
+    }
+  };
+
+  class DevicePort final : public Port {
+    SimulatedLink &link;
+
+  public:
+    DevicePort(SimulatedLink &_link, DataHandler &_handler) noexcept
+      :Port(nullptr, _handler), link(_link) {}
+
+    PortState GetState() const noexcept override {
+      return PortState::READY;
+    }
+
+    std::size_t Write(const void *data, std::size_t length) override {
+      link.DeviceWrite(data, length);
+      return length;
+    }
+
+    bool Drain() override {
+      return true;
+    }
+
+    void Flush() override {}
+
+    unsigned GetBaudrate() const noexcept override {
+      return link.device_baud_rate;
+    }
+
+    void SetBaudrate(unsigned baud_rate) override {
+      link.device_baud_rate = baud_rate;
+    }
+
+    bool StopRxThread() override {
+      return true;
+    }
+
+    bool StartRxThread() override {
+      return true;
+    }
+
+    std::size_t Read(void *, std::size_t) override {
+      return 0;
+    }
+
+    void WaitRead(std::chrono::steady_clock::duration) override {
+      throw DeviceTimeout{"Port read timeout"};
+    }
+  };
+
+  DataHandler &device_handler;
+
+  /**
+   * One-way latency [s].
+   */
+  const double latency;
+
+  unsigned host_baud_rate, device_baud_rate;
+
+  /**
+   * The host's virtual clock [s].
+   */
+  double now = 0;
+
+  /**
+   * The virtual time at which the device is handling the current
+   * request [s].
+   */
+  double device_now = 0;
+
+  /**
+   * The virtual time when the transmitters will be idle [s].
+   */
+  double host_tx_free = 0, device_tx_free = 0;
+
+  std::deque<Chunk> to_host;
+
+  /**
+   * The number of bytes already consumed from the first #to_host
+   * chunk.
+   */
+  std::size_t consumed = 0;
+
+  std::size_t drop_position = 0, drop_length = 0;
+
+  HostPort host_port;
+  DevicePort device_port;
+
+public:
+  std::size_t bytes_to_device = 0, bytes_to_host = 0;
+
+  SimulatedLink(DataHandler &host_handler, DataHandler &_device_handler,
+                unsigned baud_rate, double _latency) noexcept
+    :device_handler(_device_handler), latency(_latency),
+     host_baud_rate(baud_rate), device_baud_rate(baud_rate),
+     host_port(*this, host_handler),
+     device_port(*this, _device_handler) {}
+
+  Port &GetHostPort() noexcept {
+    return host_port;
+  }
+
+  Port &GetDevicePort() noexcept {
+    return device_port;
+  }
+
+  /**
+   * The elapsed virtual time [s].
+   */
+  double GetTime() const noexcept {
+    return now;
+  }
+
+  /**
+   * Lose #length device-to-host bytes starting at the given (total)
+   * byte position.
+   */
+  void InjectDrop(std::size_t position, std::size_t length) noexcept {
+    drop_position = position;
+    drop_length = length;
+  }
+
+private:
+  double TransferTime(std::size_t length, unsigned baud_rate) const noexcept {
+    return double(length * 10) / baud_rate;
+  }
+
+  void HostWrite(const void *data, std::size_t length) {
+    const double start = std::max(now, host_tx_free);
+    host_tx_free = start + TransferTime(length, host_baud_rate);
+    bytes_to_device += length;
+
+    if (host_baud_rate != device_baud_rate)
+      /* garbage on the wire */
+      return;
+
+    device_now = host_tx_free + latency;
+    device_handler.DataReceived({(const std::byte *)data, length});
+  }
+
+  void DeviceWrite(const void *_data, std::size_t length) {
+    const double start = std::max(device_now, device_tx_free);
+    device_tx_free = start + TransferTime(length, device_baud_rate);
+
+    const auto *data = (const std::byte *)_data;
+    Chunk chunk{device_tx_free + latency, device_baud_rate, {}};
+    chunk.data.reserve(length);
+    for (std::size_t i = 0; i < length; ++i, ++bytes_to_host)
+      if (bytes_to_host < drop_position ||
+          bytes_to_host >= drop_position + drop_length)
+        chunk.data.push_back(data[i]);
+
+    if (!chunk.data.empty())
+      to_host.push_back(std::move(chunk));
+  }
+
+  /**
+   * Discard data which was sent at a different baud rate than the
+   * host is using.
+   */
+  void Discard() noexcept {
+    while (!to_host.empty() &&
+           to_host.front().baud_rate != host_baud_rate) {
+      to_host.pop_front();
+      consumed = 0;
+    }
+  }
+
+  void DiscardReady() noexcept {
+    while (!to_host.empty() && to_host.front().time <= now) {
+      to_host.pop_front();
+      consumed = 0;
+    }
+  }
+
+  std::size_t HostRead(void *buffer, std::size_t size) noexcept {
+    Discard();
+    if (to_host.empty() || to_host.front().time > now)
+      return 0;
+
+    Chunk &chunk = to_host.front();
+    const std::size_t n = std::min(size, chunk.data.size() - consumed);
+    std::copy_n(chunk.data.begin() + consumed, n, (std::byte *)buffer);
+    consumed += n;
+    if (consumed == chunk.data.size()) {
+      to_host.pop_front();
+      consumed = 0;
+    }
+
+    return n;
+  }
+
+  void HostWaitRead(double timeout) {
+    Discard();
+    if (!to_host.empty() && to_host.front().time <= now + timeout) {
+      now = std::max(now, to_host.front().time);
+      return;
+    }
+
+    now += timeout;
+    throw DeviceTimeout{"Port read timeout"};
+  }
+};
+
+#endif
@@ -0,0 +1,166 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Engine/Airspace/AirspaceTerrainEnvelope.hpp"
+#include "Engine/Airspace/AirspaceAltitude.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/**
+ * A synthetic terrain which rises 1 m per 0.0001 degrees to the
+ * east, starting at 7 degrees east.
+ */
+[[gnu::pure]]
+static TerrainHeight
+SlopeHeight(const GeoPoint &location) noexcept
+{
+  return TerrainHeight(int16_t(lround((location.longitude.Degrees() - 7) * 10000)));
+}
+
+TerrainHeight
+RasterMap::GetHeight(const GeoPoint &location) const noexcept
+{
+  return SlopeHeight(location);
+}
+
+void
+RasterMap::ScanLine(const GeoPoint &start, const GeoPoint &end,
+                    TerrainHeight *buffer, unsigned size,
+                    bool interpolate) const noexcept
+{
+  for (unsigned i = 0; i < size; ++i)
+    buffer[i] = SlopeHeight(start.Interpolate(end, double(i) / (size - 1)));
+}
+
+void
+RasterTileCache::Reset() noexcept
+{
+}
+
+static AirspaceAltitude
+MakeAGL(double value) noexcept
+{
+  AirspaceAltitude a = AirspaceAltitude::Invalid();
+  a.reference = AltitudeReference::AGL;
+  a.altitude_above_terrain = value;
+  a.altitude = value;
+  return a;
+}
+
+static AltitudeState
+MakeState(double altitude, double altitude_agl) noexcept
+{
+  AltitudeState state{};
+  state.altitude = altitude;
+  state.altitude_agl = altitude_agl;
+  return state;
+}
+
+static void
+TestAltitude()
+{
+  AirspaceAltitude a = MakeAGL(300);
+  ok1(!a.HasTerrainEnvelope());
+
+  /* without envelope: terrain at the aircraft */
+  ok1(equals(a.GetAltitude(MakeState(1000, 800)), 500));
+  ok1(equals(a.GetMinimumAltitude(MakeState(1000, 800)), 500));
+
+  a.SetTerrainEnvelope({100, 900, 400});
+  ok1(a.HasTerrainEnvelope());
+  ok1(equals(a.altitude, 700));
+
+  /* the aircraft's terrain is inside the envelope */
+  ok1(equals(a.GetAltitude(MakeState(1000, 500)), 800));
+
+  /* unknown terrain (altitude_agl=0) is limited to the envelope */
+  ok1(equals(a.GetAltitude(MakeState(2000, 0)), 1200));
+  ok1(equals(a.GetAltitude(MakeState(60, 10)), 400));
+
+  ok1(equals(a.GetMinimumAltitude(MakeState(2000, 0)), 400));
+  ok1(equals(a.GetMaximumAltitude(MakeState(2000, 0)), 1200));
+
+  /* MSL altitudes ignore the envelope */
+  AirspaceAltitude msl = AirspaceAltitude::Invalid();
+  msl.reference = AltitudeReference::MSL;
+  msl.altitude = 1500;
+  msl.SetTerrainEnvelope({100, 900, 400});
+  ok1(!msl.HasTerrainEnvelope());
+  ok1(equals(msl.GetAltitude(MakeState(2000, 0)), 1500));
+  ok1(equals(msl.GetMinimumAltitude(MakeState(2000, 0)), 1500));
+}
+
+static void
+TestScanCircle(const RasterMap &map)
+{
+  const GeoPoint center(Angle::Degrees(7.1), Angle::Degrees(47));
+  const AirspaceCircle circle(center, 5000);
+
+  const auto e = ScanTerrainEnvelope(map, circle);
+  ok1(e.IsDefined());
+  ok1(equals(e.center, 1000));
+
+  /* 5 km are about 0.066 degrees longitude at 47 degrees north, so
+     the terrain ranges from 340 to 1660 m */
+  ok1(e.minimum > 330 && e.minimum < 420);
+  ok1(e.maximum > 1580 && e.maximum < 1670);
+}
+
+static void
+TestScanPolygon(const RasterMap &map)
+{
+  /* a triangle pointing west; its center is far from the lowest
+     point */
+  const std::vector<GeoPoint> points{
+    GeoPoint(Angle::Degrees(7.02), Angle::Degrees(47)),
+    GeoPoint(Angle::Degrees(7.2), Angle::Degrees(47.05)),
+    GeoPoint(Angle::Degrees(7.2), Angle::Degrees(46.95)),
+  };
+  const AirspacePolygon polygon(points);
+
+  const auto e = ScanTerrainEnvelope(map, polygon);
+  ok1(e.IsDefined());
+  ok1(equals(e.minimum, 200));
+  ok1(equals(e.maximum, 2000));
+  ok1(e.center > e.minimum && e.center < e.maximum);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(21);
+
+  TestAltitude();
+
+  const auto map = std::make_unique<RasterMap>();
+  TestScanCircle(*map);
+  TestScanPolygon(*map);
+
+  return exit_status();
+}
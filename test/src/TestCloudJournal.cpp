@@ -0,0 +1,197 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Cloud/Journal.hpp"
+#include "Cloud/Compactor.hpp"
+#include "Cloud/Data.hpp"
+#include "net/IPv4Address.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <iterator>
+
+#include <unistd.h>
+
+static const Path db_path(_T("output/test/TestCloudJournal.db"));
+static const Path journal_path(_T("output/test/TestCloudJournal.journal"));
+
+static const IPv4Address address(127, 0, 0, 1, 5597);
+
+static const GeoPoint location_a(Angle::Degrees(7.5), Angle::Degrees(51.0));
+static const GeoPoint location_b(Angle::Degrees(10.2), Angle::Degrees(48.3));
+static const GeoPoint location_c(Angle::Degrees(-3.1), Angle::Degrees(40.7));
+
+template<typename C>
+static unsigned
+Count(const C &container)
+{
+  return std::distance(container.begin(), container.end());
+}
+
+static bool
+IsAt(CloudClient *client, GeoPoint location, int altitude)
+{
+  return client != nullptr && client->altitude == altitude &&
+    client->location.Distance(location) < 1;
+}
+
+static void
+Load(CloudData &data)
+{
+  LoadCloudSnapshot(data, db_path);
+  ReplayCloudJournal(data, journal_path);
+}
+
+static void
+Compact(std::chrono::steady_clock::time_point expire_before)
+{
+  CloudCompactor compactor(db_path, journal_path, expire_before);
+  compactor.Wait();
+}
+
+/**
+ * Write the first journal, replay it and merge it into a new
+ * snapshot.
+ */
+static void
+TestReplay()
+{
+  CloudData server;
+
+  {
+    CloudJournal journal(journal_path, 1);
+    journal.Append(server.clients.Make(address, 1, location_a, 500));
+    journal.Append(server.clients.Make(address, 2, location_b, 1200));
+    journal.Append(server.thermals.Make(1, AGeoPoint(location_a, 600),
+                                        AGeoPoint(location_a, 1400), 2.5));
+    journal.Commit();
+  }
+
+  CloudData data;
+  ok1(ReplayCloudJournal(data, journal_path) == 3);
+  ok1(data.journal_generation == 1);
+  ok1(Count(data.clients) == 2);
+  ok1(Count(data.thermals) == 1);
+  ok1(IsAt(data.clients.Find(1), location_a, 500));
+  ok1(IsAt(data.clients.Find(2), location_b, 1200));
+
+  /* a journal which is already merged is skipped */
+  ok1(ReplayCloudJournal(data, journal_path) == 0);
+  ok1(Count(data.clients) == 2);
+
+  Compact(std::chrono::steady_clock::now() - std::chrono::hours(1));
+  ok1(!File::Exists(journal_path));
+  ok1(File::Exists(db_path));
+
+  CloudData loaded;
+  Load(loaded);
+  ok1(loaded.journal_generation == 1);
+  ok1(Count(loaded.clients) == 2);
+  ok1(Count(loaded.thermals) == 1);
+  ok1(IsAt(loaded.clients.Find(1), location_a, 500));
+  ok1(IsAt(loaded.clients.Find(2), location_b, 1200));
+}
+
+/**
+ * Write a second journal whose last record is torn, as if the server
+ * had crashed while writing it.
+ */
+static void
+TestTruncated()
+{
+  CloudData server;
+  Load(server);
+
+  {
+    CloudJournal journal(journal_path, 2);
+    journal.Append(server.clients.Make(address, 3, location_c, 300));
+    server.clients.Refresh(*server.clients.Find(1), address,
+                           location_b, 800);
+    journal.Append(*server.clients.Find(1));
+    journal.Commit();
+  }
+
+  const auto size = File::GetSize(journal_path);
+  ok1(size > 8);
+  ok1(truncate(journal_path.c_str(), size - 8) == 0);
+
+  CloudData data;
+  LoadCloudSnapshot(data, db_path);
+  ok1(ReplayCloudJournal(data, journal_path) == 1);
+  ok1(data.journal_generation == 2);
+  ok1(Count(data.clients) == 3);
+  ok1(IsAt(data.clients.Find(3), location_c, 300));
+
+  /* the torn update was discarded as a whole */
+  ok1(IsAt(data.clients.Find(1), location_a, 500));
+
+  Compact(std::chrono::steady_clock::now() - std::chrono::hours(1));
+  ok1(!File::Exists(journal_path));
+
+  CloudData loaded;
+  Load(loaded);
+  ok1(loaded.journal_generation == 2);
+  ok1(Count(loaded.clients) == 3);
+  ok1(Count(loaded.thermals) == 1);
+  ok1(IsAt(loaded.clients.Find(1), location_a, 500));
+  ok1(IsAt(loaded.clients.Find(3), location_c, 300));
+}
+
+/**
+ * Compacting expires clients which have not been seen recently.
+ */
+static void
+TestExpire()
+{
+  {
+    CloudJournal journal(journal_path, 3);
+    journal.Commit();
+  }
+
+  Compact(std::chrono::steady_clock::now() + std::chrono::hours(1));
+
+  CloudData loaded;
+  Load(loaded);
+  ok1(loaded.journal_generation == 3);
+  ok1(loaded.clients.empty());
+}
+
+int
+main(int argc, char **argv) noexcept
+try {
+  plan_tests(30);
+
+  File::Delete(db_path);
+  File::Delete(journal_path);
+
+  TestReplay();
+  TestTruncated();
+  TestExpire();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,139 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "CrossSection/CrossSectionProfile.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * A synthetic terrain which rises 1 m per 0.0001 degrees to the
+ * east, starting at 7 degrees east.
+ */
+[[gnu::pure]]
+static TerrainHeight
+SlopeHeight(const GeoPoint &location) noexcept
+{
+  return TerrainHeight(int16_t(lround((location.longitude.Degrees() - 7) * 10000)));
+}
+
+TerrainHeight
+RasterMap::GetHeight(const GeoPoint &location) const noexcept
+{
+  return SlopeHeight(location);
+}
+
+void
+RasterTileCache::Reset() noexcept
+{
+}
+
+static constexpr unsigned NUM_SAMPLES = CrossSectionProfile::NUM_SAMPLES;
+
+static const GeoPoint start(Angle::Degrees(7.1), Angle::Degrees(51.0));
+
+/* 1 km between two samples */
+static const GeoVector vec(1000 * (CrossSectionProfile::NUM_SLICES - 1),
+                           Angle::Degrees(90));
+
+/**
+ * Do the cached samples match the terrain below the cross-section
+ * which starts at the given point?
+ */
+static bool
+CheckSamples(const CrossSectionProfile &profile, const GeoPoint &origin,
+             Angle bearing)
+{
+  const TerrainHeight *samples = profile.GetSamples();
+
+  for (unsigned i = 0; i < NUM_SAMPLES; ++i) {
+    const double distance = profile.GetFirstSampleDistance() +
+      i * profile.GetSpacing();
+    const GeoPoint p = distance >= 0
+      ? GeoVector(distance, bearing).EndPoint(origin)
+      : GeoVector(-distance, bearing.Reciprocal()).EndPoint(origin);
+
+    /* allow for the flat-earth approximation of the track line */
+    if (abs(samples[i].GetValue() - SlopeHeight(p).GetValue()) > 2)
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestTerrainQueries()
+{
+  RasterMap map;
+  CrossSectionProfile profile;
+
+  profile.Update(start, vec);
+  profile.UpdateTerrain(map);
+  ok1(profile.GetTerrainQueries() == NUM_SAMPLES);
+  ok1(profile.GetFirstSampleDistance() == 0);
+  ok1(CheckSamples(profile, start, vec.bearing));
+
+  /* unchanged track: no new lookups */
+  profile.Update(start, vec);
+  profile.UpdateTerrain(map);
+  ok1(profile.GetTerrainQueries() == NUM_SAMPLES);
+
+  /* moved 3.5 km along the track: only the 3 samples which have
+     come into view are looked up */
+  const GeoPoint ahead = GeoVector(3500, vec.bearing).EndPoint(start);
+  profile.Update(ahead, vec);
+  profile.UpdateTerrain(map);
+  ok1(profile.GetTerrainQueries() == NUM_SAMPLES + 3);
+  ok1(profile.GetFirstSampleDistance() < 0);
+  ok1(profile.GetFirstSampleDistance() > -profile.GetSpacing());
+  ok1(CheckSamples(profile, ahead, vec.bearing));
+
+  /* shifted sideways by more than the sample spacing: a new track
+     line is started */
+  const GeoPoint beside = GeoVector(2000, Angle::Zero()).EndPoint(ahead);
+  profile.Update(beside, vec);
+  profile.UpdateTerrain(map);
+  ok1(profile.GetTerrainQueries() == 2 * NUM_SAMPLES + 3);
+  ok1(profile.GetFirstSampleDistance() == 0);
+  ok1(CheckSamples(profile, beside, vec.bearing));
+
+  /* turned: a new track line, too */
+  const GeoVector turned(vec.distance, Angle::Degrees(120));
+  profile.Update(beside, turned);
+  profile.UpdateTerrain(map);
+  ok1(profile.GetTerrainQueries() == 3 * NUM_SAMPLES + 3);
+  ok1(CheckSamples(profile, beside, turned.bearing));
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(13);
+
+  TestTerrainQueries();
+
+  return exit_status();
+}
@@ -0,0 +1,126 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "TestUtil.hpp"
+
+using namespace std::chrono;
+
+static void
+TestAlignDue()
+{
+  const Event::TimePoint t{milliseconds(1000)};
+
+  /* no slack: unmodified */
+  ok1(Event::AlignDue(t + milliseconds(3), {}) == t + milliseconds(3));
+
+  /* 100 ms slack aligns to a 64 ms grid */
+  const auto a = Event::AlignDue(t + milliseconds(3), milliseconds(100));
+  ok1(a.time_since_epoch() % milliseconds(64) == Event::Duration::zero());
+  ok1(a >= t + milliseconds(3));
+  ok1(a - (t + milliseconds(3)) <= milliseconds(100));
+
+  /* already on the grid */
+  ok1(Event::AlignDue(Event::TimePoint{milliseconds(1024)}, milliseconds(64)) ==
+      Event::TimePoint{milliseconds(1024)});
+
+  /* timers with different slack meet on the coarser grid */
+  const auto b = Event::AlignDue(t + milliseconds(50), milliseconds(200));
+  ok1(b.time_since_epoch() % milliseconds(128) == Event::Duration::zero());
+  ok1(b.time_since_epoch() % milliseconds(64) == Event::Duration::zero());
+}
+
+/**
+ * Several timers with slack, scheduled at slightly different
+ * offsets, expire in one wakeup.
+ */
+class SlackTimers {
+  EventLoop &event_loop;
+
+  FineTimerEvent a{event_loop, BIND_THIS_METHOD(OnA)};
+  FineTimerEvent b{event_loop, BIND_THIS_METHOD(OnB)};
+  FineTimerEvent c{event_loop, BIND_THIS_METHOD(OnC)};
+
+  Event::TimePoint fired[3];
+  unsigned n_fired = 0;
+
+public:
+  explicit SlackTimers(EventLoop &_event_loop) noexcept
+    :event_loop(_event_loop) {}
+
+  void Schedule() noexcept {
+    /* start right after a boundary of the 128 ms grid, or the due
+       times may fall into neighbouring grid cells */
+    const auto grid = milliseconds(128);
+    const auto now = event_loop.SteadyNow().time_since_epoch();
+    const auto start = grid - now % grid + milliseconds(1);
+
+    a.Schedule(start, milliseconds(200));
+    b.Schedule(start + milliseconds(10), milliseconds(200));
+    c.Schedule(start + milliseconds(25), milliseconds(200));
+  }
+
+  bool FiredTogether() const noexcept {
+    return n_fired == 3 && fired[0] == fired[1] && fired[1] == fired[2];
+  }
+
+private:
+  void Fired() noexcept {
+    fired[n_fired++] = event_loop.SteadyNow();
+    if (n_fired == 3)
+      event_loop.Break();
+  }
+
+  void OnA() noexcept { Fired(); }
+  void OnB() noexcept { Fired(); }
+  void OnC() noexcept { Fired(); }
+};
+
+static void
+TestCoalesce()
+{
+  EventLoop event_loop;
+  SlackTimers timers(event_loop);
+  timers.Schedule();
+  event_loop.Run();
+
+  ok1(timers.FiredTogether());
+
+  /* one timeout wakeup (plus maybe one spurious one) for three
+     timers */
+  const auto &stats = event_loop.GetStats();
+  ok1(stats.timer_wakeups >= 1 && stats.timer_wakeups <= 2);
+  ok1(stats.busy_max <= stats.busy_total);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(10);
+
+  TestAlignDue();
+  TestCoalesce();
+
+  return exit_status();
+}
@@ -0,0 +1,159 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARMEmulator.hpp"
+#include "SimulatedLinkPort.hpp"
+#include "Device/Driver/FLARM/Device.hpp"
+#include "Device/RecordedFlight.hpp"
+#include "Operation/Operation.hpp"
+#include "io/NullDataHandler.hpp"
+#include "io/FileReader.hxx"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+
+static const Path igc_path(_T("output/test/TestFlarmDownload.igc"));
+
+static std::string
+MakeIGC(unsigned seed, unsigned n_fixes)
+{
+  std::string igc = "AFLA01234\r\nHFDTE120811\r\n";
+
+  char line[64];
+  for (unsigned i = 0; i < n_fixes; ++i) {
+    /* include the FLARM start and escape bytes ('s' and 'x') */
+    snprintf(line, sizeof(line), "B%06u%07uNx%08usA%05u%05u\r\n",
+             i % 240000, (seed * 7919 + i) % 10000000,
+             (seed * 104729 + i * 3) % 100000000, i % 3000, i % 3100);
+    igc += line;
+  }
+
+  return igc;
+}
+
+static std::string
+ReadFile(Path path)
+{
+  FileReader reader(path);
+
+  std::string result;
+  char buffer[4096];
+  size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    result.append(buffer, nbytes);
+
+  return result;
+}
+
+struct Setup {
+  NullDataHandler handler;
+  FLARMEmulator emulator;
+  SimulatedLink link;
+  NullOperationEnvironment env;
+  FlarmDevice device;
+
+  Setup(unsigned bulk_baud_rate, unsigned n_fixes=2000)
+    :link(handler, *emulator.handler, 19200, 0.02),
+     device(link.GetHostPort(), bulk_baud_rate) {
+    emulator.port = &link.GetDevicePort();
+    emulator.env = &env;
+    emulator.echo = false;
+
+    emulator.flights.push_back({"2011-08-12|12:23:48|02:03:25|PILOT|ID|Club",
+                                MakeIGC(1, n_fixes)});
+    emulator.flights.push_back({"18CG6NG1.IGC|2011-08-13|10:00:00|01:00:00|PILOT|ID|Club",
+                                MakeIGC(2, n_fixes / 2)});
+  }
+
+  bool Download(unsigned i) {
+    RecordedFlightInfo flight;
+    flight.internal.flarm = i;
+    return device.DownloadFlight(flight, igc_path, env) &&
+      ReadFile(igc_path) == emulator.flights[i].igc;
+  }
+};
+
+static void
+TestFlightList()
+{
+  Setup setup(0);
+
+  RecordedFlightList list;
+  ok1(setup.device.ReadFlightList(list, setup.env));
+  ok1(list.size() == 2);
+  ok1(list[0].date.day == 12);
+  ok1(list[1].start_time.hour == 10);
+  ok1(list[1].end_time.hour == 11);
+}
+
+static double
+TestDownload(unsigned bulk_baud_rate, unsigned window)
+{
+  Setup setup(bulk_baud_rate);
+  setup.device.SetDownloadWindow(window);
+
+  ok1(setup.Download(0));
+  ok1(setup.Download(1));
+
+  setup.device.EnableNMEA(setup.env);
+  ok1(setup.link.GetHostPort().GetBaudrate() == 19200);
+  ok1(setup.link.GetDevicePort().GetBaudrate() == 19200);
+
+  return setup.link.GetTime();
+}
+
+static void
+TestResume()
+{
+  Setup setup(0);
+
+  /* lose a few bytes in the middle of the first flight */
+  setup.link.InjectDrop(30000, 100);
+  ok1(setup.Download(0));
+
+  /* lose the tail of an IGC data frame at the bulk baud rate */
+  Setup bulk(115200);
+  bulk.link.InjectDrop(50000, 1000);
+  ok1(bulk.Download(0));
+  ok1(bulk.Download(1));
+}
+
+int
+main()
+{
+  plan_tests(5 + 4 * 4 + 3 + 1);
+
+  TestFlightList();
+
+  const double sequential = TestDownload(0, 1);
+  const double pipelined = TestDownload(0, 4);
+  TestDownload(115200, 1);
+  const double fast = TestDownload(115200, 4);
+
+  TestResume();
+
+  ok1(fast < pipelined && pipelined < sequential);
+
+  return exit_status();
+}
@@ -0,0 +1,211 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Computer/IdleScheduler.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <thread>
+
+using namespace std::chrono;
+
+using Priority = IdleScheduler::Priority;
+
+static void
+TestOrder()
+{
+  IdleScheduler scheduler;
+  std::string order;
+
+  scheduler.Add("b", Priority::BACKGROUND, milliseconds{10}, [&](bool){
+    order.push_back('b');
+    return false;
+  });
+
+  scheduler.Add("n", Priority::NORMAL, milliseconds{10}, [&](bool){
+    order.push_back('n');
+    return false;
+  });
+
+  scheduler.Add("c1", Priority::CRITICAL, milliseconds{10}, [&](bool){
+    order.push_back('1');
+    return false;
+  });
+
+  scheduler.Add("c2", Priority::CRITICAL, milliseconds{10}, [&](bool){
+    order.push_back('2');
+    return false;
+  });
+
+  scheduler.Run();
+  ok1(order == "12nb");
+
+  const auto tasks = scheduler.GetTasks();
+  ok1(tasks.size() == 4);
+  ok1(tasks[0].metrics.runs == 1);
+  ok1(tasks[0].metrics.steps == 1);
+  ok1(!scheduler.IsSuspended());
+}
+
+static void
+TestDeferral()
+{
+  IdleScheduler scheduler;
+  scheduler.SetSlice(milliseconds{5});
+
+  unsigned critical = 0, normal = 0;
+
+  /* uses up the whole slice */
+  scheduler.Add("slow", Priority::CRITICAL, milliseconds{100}, [&](bool){
+    ++critical;
+    std::this_thread::sleep_for(milliseconds{10});
+    return false;
+  });
+
+  scheduler.Add("normal", Priority::NORMAL, milliseconds{10}, [&](bool){
+    ++normal;
+    return false;
+  });
+
+  /* critical tasks run always, the others are deferred ... */
+  for (unsigned i = 0; i < IdleScheduler::MAX_DEFERRALS; ++i)
+    scheduler.Run();
+
+  ok1(critical == IdleScheduler::MAX_DEFERRALS);
+  ok1(normal == 0);
+  ok1(scheduler.GetTasks()[1].metrics.deferrals ==
+      IdleScheduler::MAX_DEFERRALS);
+
+  /* ... but not forever */
+  scheduler.Run();
+  ok1(normal == 1);
+
+  const auto &m = scheduler.GetTasks()[1].metrics;
+  ok1(m.runs == 1);
+  ok1(m.last_latency >= milliseconds{10});
+  ok1(m.max_latency == m.last_latency);
+
+  /* the slow task has exceeded the slice, but not its budget */
+  ok1(scheduler.GetTasks()[0].metrics.overruns == 0);
+}
+
+static void
+TestResume()
+{
+  IdleScheduler scheduler;
+  scheduler.SetSlice(milliseconds{1000});
+
+  unsigned remaining = 10, steps = 0;
+  scheduler.Add("solver", Priority::BACKGROUND, milliseconds{5},
+                [&](bool exhaustive){
+    if (exhaustive) {
+      remaining = 0;
+      return false;
+    }
+
+    std::this_thread::sleep_for(milliseconds{2});
+    ++steps;
+    return --remaining > 0;
+  });
+
+  /* the budget allows at most three steps */
+  scheduler.Run();
+  ok1(steps >= 1 && steps <= 3);
+  ok1(remaining > 0);
+  ok1(scheduler.IsSuspended());
+  ok1(scheduler.GetTasks()[0].metrics.steps == steps);
+
+  /* resumed in the next cycle */
+  const unsigned previous = steps;
+  scheduler.Run();
+  ok1(steps > previous);
+
+  /* without time slicing, exactly one step per cycle */
+  scheduler.SetTimeSlicing(false);
+  const unsigned before = steps;
+  scheduler.Run();
+  ok1(steps == before + 1);
+
+  /* exhaustive finishes the work */
+  scheduler.Run(true);
+  ok1(remaining == 0);
+  ok1(!scheduler.IsSuspended());
+
+  scheduler.ResetMetrics();
+  ok1(scheduler.GetTasks()[0].metrics.runs == 0);
+}
+
+static void
+TestYield()
+{
+  IdleScheduler scheduler;
+  scheduler.SetSlice(milliseconds{1000});
+
+  bool pending = false;
+  scheduler.SetYield([&]{ return pending; });
+
+  unsigned critical = 0, steps = 0;
+  scheduler.Add("critical", Priority::CRITICAL, milliseconds{10}, [&](bool){
+    ++critical;
+    return false;
+  });
+
+  scheduler.Add("solver", Priority::BACKGROUND, milliseconds{1000},
+                [&](bool){
+    /* new input arrives during the third step */
+    if (++steps == 3)
+      pending = true;
+    return true;
+  });
+
+  /* the solver stops after the step which saw new input */
+  scheduler.Run();
+  ok1(critical == 1);
+  ok1(steps == 3);
+  ok1(scheduler.IsSuspended());
+
+  /* while input is pending, only critical tasks run */
+  scheduler.Run();
+  ok1(critical == 2);
+  ok1(steps == 3);
+  ok1(scheduler.GetTasks()[1].metrics.deferrals == 1);
+
+  /* continues after the input has been processed */
+  pending = false;
+  scheduler.SetTimeSlicing(false);
+  scheduler.Run();
+  ok1(steps == 4);
+}
+
+int
+main()
+{
+  plan_tests(29);
+
+  TestOrder();
+  TestDeferral();
+  TestResume();
+  TestYield();
+
+  return exit_status();
+}
@@ -0,0 +1,172 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Job/Graph.hpp"
+#include "Job/Job.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono;
+
+/**
+ * Records the progress reported by #JobGraph.
+ */
+class RecordingOperationEnvironment final : public NullOperationEnvironment {
+public:
+  unsigned range = 0, position = 0;
+  bool monotonic = true;
+
+  void SetProgressRange(unsigned _range) noexcept override {
+    range = _range;
+  }
+
+  void SetProgressPosition(unsigned _position) noexcept override {
+    if (_position < position)
+      monotonic = false;
+    position = _position;
+  }
+};
+
+/**
+ * Counts how many instances run at the same time.
+ */
+static std::atomic_uint concurrent{0}, max_concurrent{0};
+
+class SleepJob final : public Job {
+public:
+  std::atomic_bool finished{false};
+
+  const SleepJob *const depends;
+  bool depends_finished = true;
+
+  explicit SleepJob(const SleepJob *_depends=nullptr) noexcept
+    :depends(_depends) {}
+
+  void Run(OperationEnvironment &env) override {
+    if (depends != nullptr)
+      depends_finished = depends->finished;
+
+    const unsigned n = ++concurrent;
+    unsigned max = max_concurrent;
+    while (n > max && !max_concurrent.compare_exchange_weak(max, n)) {}
+
+    env.SetProgressRange(10);
+    for (unsigned i = 0; i < 10; ++i) {
+      env.SetProgressPosition(i);
+      env.Sleep(milliseconds(5));
+    }
+
+    --concurrent;
+    finished = true;
+  }
+};
+
+class FailingJob final : public Job {
+public:
+  void Run(OperationEnvironment &) override {
+    throw std::runtime_error("Failure");
+  }
+};
+
+static void
+TestDependencies()
+{
+  SleepJob a, b(&a), c(&b), d, e;
+
+  JobGraph graph;
+  const auto ha = graph.Add(a, 1);
+  const auto hb = graph.Add(b, 1, {ha});
+  graph.Add(c, 2, {hb});
+  graph.Add(d, 1);
+  graph.Add(e, 1);
+
+  RecordingOperationEnvironment env;
+  graph.Run(env, 3);
+
+  ok1(a.finished && b.finished && c.finished && d.finished && e.finished);
+  ok1(b.depends_finished);
+  ok1(c.depends_finished);
+
+  /* independent jobs have overlapped */
+  ok1(max_concurrent >= 2 && max_concurrent <= 3);
+
+  ok1(env.monotonic);
+  ok1(env.range > 0 && env.position == env.range);
+}
+
+static void
+TestSingleThread()
+{
+  concurrent = max_concurrent = 0;
+
+  SleepJob a, b;
+
+  JobGraph graph;
+  graph.Add(a, 1);
+  graph.Add(b, 1);
+
+  RecordingOperationEnvironment env;
+  graph.Run(env, 1);
+
+  ok1(a.finished && b.finished);
+  ok1(max_concurrent == 1);
+  ok1(env.position == env.range);
+}
+
+static void
+TestError()
+{
+  FailingJob failing;
+  SleepJob after;
+
+  JobGraph graph;
+  const auto h = graph.Add(failing, 1);
+  graph.Add(after, 1, {h});
+
+  RecordingOperationEnvironment env;
+  bool caught = false;
+  try {
+    graph.Run(env, 2);
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+
+  ok1(caught);
+  ok1(!after.finished);
+}
+
+int
+main()
+{
+  plan_tests(11);
+
+  TestDependencies();
+  TestSingleThread();
+  TestError();
+
+  return exit_status();
+}
@@ -82,12 +82,54 @@ LSTest1(double w)
   return true;
 }
 
+/**
+ * Feed a 12 hour flight sampled every second and check that the
+ * stored series stays bounded, keeps the extremes of old data and
+ * the full resolution of recent data.
+ */
+static void
+TestDownsample()
+{
+  LeastSquares ls;
+  ls.Reset();
+
+  constexpr unsigned n = 12 * 3600;
+  constexpr unsigned spike = 1234;
+  for (unsigned i = 0; i < n; ++i)
+    ls.Update(i, i == spike ? 5000. : 1000. + (i % 100));
+
+  ok1(ls.GetCount() == n);
+
+  const auto slots = ls.GetSlots();
+  ok1(slots.size <= 1000);
+
+  /* the running sums still include all samples */
+  ok1(equals(ls.GetMeanX(), (n - 1) / 2.));
+  ok1(ls.GetMaxY() == 5000);
+
+  bool monotonic = true, found_spike = false;
+  for (unsigned i = 0; i < slots.size; ++i) {
+    if (i > 0 && slots[i].x <= slots[i - 1].x)
+      monotonic = false;
+    if (slots[i].x == spike && slots[i].y == 5000)
+      found_spike = true;
+  }
+
+  ok1(monotonic);
+  ok1(found_spike);
+
+  /* the most recent samples are all there */
+  ok1(slots.back().x == n - 1);
+  ok1(slots[slots.size - 2].x == n - 2);
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(2);
+  plan_tests(10);
 
   ok1(LSTest1(1));
   ok1(LSTest1(2));
+  TestDownsample();
 
   return exit_status();
 }
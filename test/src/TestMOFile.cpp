@@ -0,0 +1,175 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Language/MOFile.hpp"
+#include "TestUtil.hpp"
+#include "util/StringAPI.hxx"
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+static const char *const pairs[][2] = {
+  {"Cancel", "Abbrechen"},
+  {"Close", "Schliessen"},
+  {"OK", "OK"},
+  {"Settings", "Einstellungen"},
+  {"Waypoint", "Wegpunkt"},
+};
+
+static constexpr unsigned N = sizeof(pairs) / sizeof(pairs[0]);
+
+/* the GNU gettext hash function, written down independently of
+   MOFile.cpp */
+static uint32_t
+HashPJW(const char *p)
+{
+  uint64_t h = 0;
+  for (; *p != 0; ++p) {
+    h = (h << 4) + (uint8_t)*p;
+    uint64_t g = h & 0xfffffffff0000000ULL;
+    if (g != 0)
+      h = (h ^ (g >> 24)) ^ g;
+  }
+
+  return h;
+}
+
+/**
+ * Build a .mo file like msgfmt does.
+ */
+static std::vector<uint8_t>
+MakeMO(unsigned hash_size, bool swap)
+{
+  std::vector<uint32_t> header{
+    0x950412de, 0, N,
+    28, 28 + N * 8,
+    hash_size, 28 + 2 * N * 8,
+  };
+
+  std::vector<uint32_t> hash(hash_size, 0);
+  for (unsigned i = 0; i < N && hash_size > 2; ++i) {
+    const uint32_t h = HashPJW(pairs[i][0]);
+    unsigned idx = h % hash_size;
+    const unsigned inc = 1 + h % (hash_size - 2);
+    while (hash[idx] != 0)
+      idx = (idx + inc) % hash_size;
+    hash[idx] = i + 1;
+  }
+
+  std::string strings;
+  std::vector<uint32_t> tables[2];
+  const uint32_t strings_offset = 28 + 2 * N * 8 + hash_size * 4;
+  for (unsigned t = 0; t < 2; ++t) {
+    for (unsigned i = 0; i < N; ++i) {
+      tables[t].push_back(strlen(pairs[i][t]));
+      tables[t].push_back(strings_offset + strings.size());
+      strings.append(pairs[i][t]);
+      strings.push_back(0);
+    }
+  }
+
+  std::vector<uint32_t> words(header);
+  words.insert(words.end(), tables[0].begin(), tables[0].end());
+  words.insert(words.end(), tables[1].begin(), tables[1].end());
+  words.insert(words.end(), hash.begin(), hash.end());
+
+  if (swap)
+    for (auto &w : words)
+      w = __builtin_bswap32(w);
+
+  std::vector<uint8_t> result(words.size() * 4);
+  memcpy(result.data(), words.data(), result.size());
+  result.insert(result.end(), strings.begin(), strings.end());
+  return result;
+}
+
+static bool
+Translates(const MOFile &mo, const char *original, const char *expected)
+{
+  const char *translation = mo.lookup(original);
+  return translation != nullptr && StringIsEqual(translation, expected);
+}
+
+static void
+TestLookup(unsigned hash_size, bool swap)
+{
+  const auto data = MakeMO(hash_size, swap);
+  const MOFile mo(data.data(), data.size());
+  ok1(!mo.error());
+
+  for (unsigned i = 0; i < N; ++i)
+    ok1(Translates(mo, pairs[i][0], pairs[i][1]));
+
+  ok1(mo.lookup("Cancel2") == nullptr);
+  ok1(mo.lookup("") == nullptr);
+  ok1(mo.lookup("A") == nullptr);
+  ok1(mo.lookup("Zulu") == nullptr);
+}
+
+static void
+TestInvalid()
+{
+  auto data = MakeMO(7, false);
+
+  {
+    /* truncated header */
+    const MOFile mo(data.data(), 20);
+    ok1(mo.error());
+  }
+
+  {
+    /* string tables outside of the file */
+    const MOFile mo(data.data(), 40);
+    ok1(mo.error());
+  }
+
+  {
+    /* string data outside of the file: found, but not returned */
+    const MOFile mo(data.data(), data.size() - 20);
+    ok1(!mo.error());
+    ok1(mo.lookup("Waypoint") == nullptr);
+  }
+
+  data[0] ^= 0xff;
+  const MOFile mo(data.data(), data.size());
+  ok1(mo.error());
+}
+
+int main()
+{
+  plan_tests(4 * 10 + 5);
+
+  /* with hash tables of different sizes */
+  TestLookup(7, false);
+  TestLookup(11, true);
+
+  /* without hash table: binary search */
+  TestLookup(0, false);
+  TestLookup(0, true);
+
+  TestInvalid();
+
+  return exit_status();
+}
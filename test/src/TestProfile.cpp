@@ -21,6 +21,8 @@
 */
 
 #include "Profile/Profile.hpp"
+#include "Profile/Current.hpp"
+#include "Profile/Map.hpp"
 #include "io/FileLineReader.hpp"
 #include "system/Path.hpp"
 #include "TestUtil.hpp"
@@ -79,6 +81,51 @@ TestMap()
     ok1(Profile::Get("key5", value));
     ok1(equals(value, 1.337));
   }
+
+  {
+    /* numbers are parsed once, when the value is stored */
+    int i;
+    unsigned u;
+    double d;
+    Profile::Set("key6", "0x10");
+    ok1(Profile::Get("key6", i));
+    ok1(i == 16);
+    Profile::Set("key6", "12.5");
+    ok1(Profile::Get("key6", i));
+    ok1(i == 12);
+    ok1(Profile::Get("key6", d));
+    ok1(equals(d, 12.5));
+    Profile::Set("key6", "abc");
+    ok1(!Profile::Get("key6", i));
+    ok1(!Profile::Get("key6", u));
+    ok1(!Profile::Get("key6", d));
+    ok1(StringIsEqual(Profile::Get("key6"), "abc"));
+  }
+
+  {
+    /* storing an equal value doesn't modify the profile */
+    Profile::Set("key7", 42u);
+    Profile::SetModified(false);
+    Profile::Set("key7", 42);
+    ok1(!Profile::IsModified());
+    Profile::Set("key7", 43);
+    ok1(Profile::IsModified());
+    ok1(StringIsEqual(Profile::Get("key7"), "43"));
+
+    /* "12.5" is not equal to 12 */
+    Profile::Set("key6", "12.5");
+    Profile::SetModified(false);
+    Profile::Set("key6", 12);
+    ok1(Profile::IsModified());
+    ok1(StringIsEqual(Profile::Get("key6"), "12"));
+  }
+
+  {
+    ok1(Profile::Exists("key1"));
+    Profile::map.Remove("key1");
+    ok1(!Profile::Exists("key1"));
+    ok1(Profile::Exists("key2"));
+  }
 }
 
 static void
@@ -140,7 +187,7 @@ TestReader()
 
 int main(int argc, char **argv)
 try {
-  plan_tests(31);
+  plan_tests(49);
 
   TestMap();
   TestWriter();
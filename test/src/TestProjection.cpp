@@ -46,12 +46,48 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+static void
+test_bulk()
+{
+  Projection prj;
+  prj.SetScreenOrigin(320, 240);
+  prj.SetScale(640. / (100000 * 2));
+  prj.SetScreenAngle(Angle::Degrees(37));
+  prj.SetGeoLocation(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)));
+
+  /* an odd number of points covers the scalar tail */
+  constexpr unsigned N = 1001;
+  GeoPoint geo[N];
+  for (unsigned i = 0; i < N; ++i)
+    geo[i] = GeoPoint(Angle::Degrees(7.7 + (int(i % 37) - 18) * 0.031),
+                      Angle::Degrees(51.05 + (int(i % 23) - 11) * 0.027));
+
+  PixelPoint bulk[N];
+  prj.GeoToScreen(geo, bulk, N);
+
+  bool equal = true;
+  for (unsigned i = 0; i < N; ++i)
+    if (bulk[i] != prj.GeoToScreen(geo[i]))
+      equal = false;
+
+  ok1(equal);
+
+  /* crossing the date line exercises the normalisation */
+  prj.SetGeoLocation(GeoPoint(Angle::Degrees(179.9), Angle::Degrees(-40)));
+  geo[0] = GeoPoint(Angle::Degrees(-179.9), Angle::Degrees(-40.1));
+  geo[1] = GeoPoint(Angle::Degrees(179.8), Angle::Degrees(-39.9));
+  prj.GeoToScreen(geo, bulk, 2);
+  ok1(bulk[0] == prj.GeoToScreen(geo[0]));
+  ok1(bulk[1] == prj.GeoToScreen(geo[1]));
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(4);
+  plan_tests(7);
 
   test_simple();
+  test_bulk();
 
   return exit_status();
 }
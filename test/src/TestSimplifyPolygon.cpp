@@ -0,0 +1,100 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Geo/SimplifyPolygon.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Geo/FAISphere.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+static GeoPoint
+MakeGeoPoint(double longitude, double latitude)
+{
+  return GeoPoint(Angle::Degrees(longitude), Angle::Degrees(latitude));
+}
+
+static void
+TestCollinear()
+{
+  /* a square with redundant vertices on each edge */
+  std::vector<GeoPoint> points;
+  for (unsigned i = 0; i < 10; ++i)
+    points.push_back(MakeGeoPoint(7 + i * 0.01, 50));
+  for (unsigned i = 0; i < 10; ++i)
+    points.push_back(MakeGeoPoint(7.1, 50 + i * 0.01));
+  for (unsigned i = 0; i < 10; ++i)
+    points.push_back(MakeGeoPoint(7.1 - i * 0.01, 50.1));
+  for (unsigned i = 0; i < 10; ++i)
+    points.push_back(MakeGeoPoint(7, 50.1 - i * 0.01));
+
+  const unsigned n = SimplifyPolygon(points.data(), points.size(),
+                                     FAISphere::EarthDistanceToAngle(1));
+  /* the last vertex is always kept */
+  ok1(n == 5);
+  ok1(equals(points[0], MakeGeoPoint(7, 50)));
+  ok1(equals(points[1], MakeGeoPoint(7.1, 50)));
+  ok1(equals(points[2], MakeGeoPoint(7.1, 50.1)));
+  ok1(equals(points[3], MakeGeoPoint(7, 50.1)));
+  ok1(equals(points[4], MakeGeoPoint(7, 50.01)));
+}
+
+static void
+TestCircle()
+{
+  /* a circle with a radius of approximately 10 km */
+  const GeoPoint center = MakeGeoPoint(7, 50);
+  std::vector<GeoPoint> circle;
+  for (unsigned i = 0; i < 360; ++i)
+    circle.push_back(GeoVector(10000, Angle::Degrees(i)).EndPoint(center));
+
+  /* a fine tolerance keeps most vertices */
+  std::vector<GeoPoint> points = circle;
+  unsigned n = SimplifyPolygon(points.data(), points.size(),
+                               FAISphere::EarthDistanceToAngle(0.5));
+  ok1(n > 180 && n <= 360);
+  ok1(equals(points[0], circle[0]));
+
+  /* a coarse tolerance keeps only a few */
+  points = circle;
+  n = SimplifyPolygon(points.data(), points.size(),
+                      FAISphere::EarthDistanceToAngle(200));
+  ok1(n >= 8 && n < 40);
+  ok1(equals(points[n - 1], circle.back()));
+
+  /* far too coarse: never less than a triangle */
+  points = circle;
+  n = SimplifyPolygon(points.data(), points.size(),
+                      FAISphere::EarthDistanceToAngle(100000));
+  ok1(n == 360);
+}
+
+int main()
+{
+  plan_tests(11);
+
+  TestCollinear();
+  TestCircle();
+
+  return exit_status();
+}
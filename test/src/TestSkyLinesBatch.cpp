@@ -0,0 +1,316 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Sends FIX_BATCH packets from a SkyLinesTracking::Client to a
+ * SkyLinesTracking::Server over the loopback interface and verifies
+ * the fixes decoded by the server.
+ */
+
+#include "Tracking/SkyLines/Client.hpp"
+#include "Tracking/SkyLines/Server.hpp"
+#include "Tracking/SkyLines/Handler.hpp"
+#include "Tracking/SkyLines/Batch.hpp"
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "net/IPv4Address.hxx"
+#include "Geo/GeoPoint.hpp"
+#include "util/PrintException.hxx"
+#include "util/ByteOrder.hxx"
+#include "util/CRC.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace SkyLinesTracking;
+
+static constexpr uint64_t KEY = 0x1234567890abcdef;
+
+struct ReceivedFix {
+  uint64_t key;
+  std::chrono::milliseconds time;
+  ::GeoPoint location;
+  int altitude;
+};
+
+class TestServer final : public Server {
+  FineTimerEvent timeout;
+
+  unsigned expected = 0;
+
+public:
+  std::vector<ReceivedFix> fixes;
+
+  TestServer(EventLoop &event_loop, SocketAddress address)
+    :Server(event_loop, address),
+     timeout(event_loop, BIND_THIS_METHOD(OnTimeout)) {}
+
+  /**
+   * Run the #EventLoop until the given number of fixes has been
+   * received, until somebody else breaks the loop or until a timeout
+   * expires.
+   */
+  void Run(unsigned n_fixes) {
+    expected = n_fixes;
+    if (n_fixes > 0 && fixes.size() >= n_fixes)
+      return;
+
+    timeout.Schedule(std::chrono::seconds(5));
+    GetEventLoop().Run();
+    timeout.Cancel();
+  }
+
+private:
+  void OnTimeout() noexcept {
+    GetEventLoop().Break();
+  }
+
+protected:
+  void OnFix(const Client &client,
+             std::chrono::milliseconds time_of_day,
+             const ::GeoPoint &location, int altitude) override {
+    fixes.push_back({client.key, time_of_day, location, altitude});
+    if (expected > 0 && fixes.size() >= expected)
+      GetEventLoop().Break();
+  }
+
+  void OnError(std::exception_ptr e) override {
+    PrintException(e);
+    GetEventLoop().Break();
+  }
+};
+
+struct Track {
+  uint32_t time;
+  ::GeoPoint location;
+  int altitude;
+};
+
+/**
+ * Generate a plausible track: a slow climb in circles, sampled
+ * every 2.3 seconds.
+ */
+static std::vector<Track>
+MakeTrack(unsigned n)
+{
+  std::vector<Track> track;
+  for (unsigned i = 0; i < n; ++i) {
+    const double angle = i * 0.4;
+    track.push_back({
+        43200000 + i * 2300,
+        ::GeoPoint(Angle::Degrees(7.5 + 0.0015 * std::cos(angle) + i * 0.0001),
+                   Angle::Degrees(51.2 + 0.001 * std::sin(angle))),
+        int(800 + i * 3),
+      });
+  }
+
+  return track;
+}
+
+static bool
+Matches(const ReceivedFix &fix, const Track &expected, bool has_altitude)
+{
+  return fix.key == KEY &&
+    /* the deltas have 1/10 seconds resolution */
+    std::abs(fix.time.count() - (long long)expected.time) <= 50 &&
+    std::fabs((fix.location.latitude - expected.location.latitude).Degrees()) < 2e-6 &&
+    std::fabs((fix.location.longitude - expected.location.longitude).Degrees()) < 2e-6 &&
+    fix.altitude == (has_altitude ? expected.altitude : -1);
+}
+
+static void
+TestEncoder()
+{
+  FixBatch batch;
+  ok1(batch.IsEmpty());
+
+  const auto track = MakeTrack(FixBatchPacket::MAX_FIXES + 1);
+  for (unsigned i = 0; i < FixBatchPacket::MAX_FIXES; ++i)
+    batch.Append(track[i].time, track[i].location, true, track[i].altitude);
+
+  ok1(batch.IsFull());
+  ok1(!batch.Append(track.back().time, track.back().location,
+                    true, track.back().altitude));
+
+  const auto datagram = batch.Finish(KEY);
+  ok1(datagram.size == sizeof(FixBatchPacket) +
+      (FixBatchPacket::MAX_FIXES - 1) * sizeof(FixDelta));
+
+  /* 64 single FixPacket datagrams would be 3072 bytes */
+  ok1(datagram.size < 600);
+
+  batch.Clear();
+  const ::GeoPoint a(Angle::Degrees(7), Angle::Degrees(51));
+  ok1(batch.Append(1000, a, true, 500));
+
+  /* going back in time, jumping too far, or losing the altitude
+     requires a new batch */
+  ok1(!batch.Append(900, a, true, 500));
+  ok1(!batch.Append(2000, ::GeoPoint(Angle::Degrees(7.1), Angle::Degrees(51)),
+                    true, 500));
+  ok1(!batch.Append(2000, a, false, 0));
+  ok1(!batch.Append(7000000, a, true, 500));
+  ok1(batch.Append(2000, a, true, 600));
+  ok1(batch.size() == 2);
+}
+
+/**
+ * A #TestServer and a #Client connected to it over the loopback
+ * interface.  Each instance has its own #EventLoop, because an
+ * #EventLoop cannot be restarted after it has been broken.
+ */
+struct Loopback {
+  EventLoop event_loop;
+  TestServer server{event_loop, IPv4Address(IPv4Address::Loopback(), 0)};
+  Client client;
+
+  explicit Loopback(Handler *handler=nullptr)
+    :client(event_loop, handler) {
+    client.SetKey(KEY);
+  }
+
+  bool Open() {
+    return client.Open(server.GetLocalAddress());
+  }
+};
+
+/**
+ * Counts #ACK packets and breaks the #EventLoop.
+ */
+struct AckHandler final : Handler {
+  EventLoop *event_loop = nullptr;
+  unsigned n_acks = 0;
+
+  void OnAck(unsigned id) override {
+    ++n_acks;
+    event_loop->Break();
+  }
+
+  void OnSkyLinesError(std::exception_ptr e) override {
+    PrintException(e);
+    event_loop->Break();
+  }
+};
+
+static void
+TestNegotiate()
+{
+  AckHandler handler;
+  Loopback loopback(&handler);
+  handler.event_loop = &loopback.event_loop;
+  ok1(loopback.Open());
+
+  ok1(!loopback.client.IsFixBatchSupported());
+  loopback.client.SendPing(1);
+  loopback.server.Run(0);
+  ok1(handler.n_acks == 1);
+  ok1(loopback.client.IsFixBatchSupported());
+
+  loopback.client.Close();
+}
+
+static void
+TestSendBatch()
+{
+  Loopback loopback;
+  ok1(loopback.Open());
+
+  /* a full batch with altitude */
+  const auto track = MakeTrack(FixBatchPacket::MAX_FIXES);
+  FixBatch batch;
+  for (const auto &i : track)
+    batch.Append(i.time, i.location, true, i.altitude);
+
+  ok1(loopback.client.SendBuffer(batch.Finish(KEY)));
+
+  auto &fixes = loopback.server.fixes;
+  loopback.server.Run(track.size());
+  ok1(fixes.size() == track.size());
+
+  bool all_match = fixes.size() == track.size();
+  for (unsigned i = 0; all_match && i < track.size(); ++i)
+    all_match = Matches(fixes[i], track[i], true);
+  ok1(all_match);
+
+  loopback.client.Close();
+}
+
+static void
+TestBadDatagrams()
+{
+  Loopback loopback;
+  ok1(loopback.Open());
+
+  const auto track = MakeTrack(3);
+  FixBatch batch;
+  for (const auto &i : track)
+    batch.Append(i.time, i.location, false, 0);
+
+  const auto datagram = batch.Finish(KEY);
+
+  /* a corrupt datagram is ignored */
+  std::vector<std::byte> corrupt((const std::byte *)datagram.data,
+                                 (const std::byte *)datagram.data + datagram.size);
+  corrupt.back() ^= std::byte{0x1};
+  loopback.client.SendBuffer({corrupt.data(), corrupt.size()});
+
+  /* a truncated datagram with a valid CRC must not be decoded
+     either */
+  corrupt.resize(datagram.size - sizeof(FixDelta));
+  auto &header = *(Header *)corrupt.data();
+  header.crc = 0;
+  header.crc = ToBE16(UpdateCRC16CCITT(corrupt.data(), corrupt.size(), 0));
+  loopback.client.SendBuffer({corrupt.data(), corrupt.size()});
+
+  /* a short batch without altitude is received */
+  loopback.client.SendBuffer(datagram);
+
+  auto &fixes = loopback.server.fixes;
+  loopback.server.Run(track.size());
+  ok1(fixes.size() == track.size());
+
+  bool all_match = fixes.size() == track.size();
+  for (unsigned i = 0; all_match && i < track.size(); ++i)
+    all_match = Matches(fixes[i], track[i], false);
+  ok1(all_match);
+
+  loopback.client.Close();
+}
+
+int
+main(int argc, char **argv)
+try {
+  plan_tests(23);
+
+  TestEncoder();
+  TestNegotiate();
+  TestSendBatch();
+  TestBadDatagrams();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "io/ThreadedOutputStream.hpp"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace std::chrono;
+
+class StringOutputStream final : public OutputStream {
+public:
+  std::string value;
+  unsigned n_writes = 0;
+
+  void Write(const void *data, std::size_t size) override {
+    value.append((const char *)data, size);
+    ++n_writes;
+  }
+};
+
+class FailingOutputStream final : public OutputStream {
+public:
+  void Write(const void *, std::size_t) override {
+    throw std::runtime_error("failed");
+  }
+};
+
+static void
+TestGroupCommit()
+{
+  StringOutputStream sos;
+
+  {
+    ThreadedOutputStream tos(sos, hours{1});
+    for (unsigned i = 0; i < 100; ++i)
+      tos.Write("hello\n", 6);
+
+    tos.Flush();
+    ok1(sos.value.size() == 600);
+
+    /* all lines were collected and submitted at once */
+    ok1(sos.n_writes == 1);
+
+    tos.Write("world\n", 6);
+  }
+
+  /* the destructor writes the rest */
+  ok1(sos.value.size() == 606);
+  ok1(sos.value.compare(600, 6, "world\n") == 0);
+}
+
+static void
+TestOverflow()
+{
+  StringOutputStream sos;
+  std::string expected;
+
+  {
+    /* a tiny buffer which must wrap around and overflow many
+       times */
+    ThreadedOutputStream tos(sos, hours{1}, 16);
+    for (unsigned i = 0; i < 1000; ++i) {
+      const std::string line = std::to_string(i) + '\n';
+      tos.Write(line.data(), line.size());
+      expected += line;
+    }
+  }
+
+  ok1(sos.value == expected);
+}
+
+static void
+TestError()
+{
+  FailingOutputStream fos;
+
+  ThreadedOutputStream tos(fos, hours{1});
+  tos.Write("hello\n", 6);
+
+  bool caught = false;
+  try {
+    tos.Flush();
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+
+  ok1(caught);
+
+  caught = false;
+  try {
+    tos.Write("world\n", 6);
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+
+  ok1(caught);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(7);
+
+  TestGroupCommit();
+  TestOverflow();
+  TestError();
+
+  return exit_status();
+}
@@ -0,0 +1,273 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/List.hpp"
+#include "FLARM/TrafficStore.hpp"
+#include "GliderLink/List.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned i)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", 0x3e0000 + i);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static FlarmTraffic
+MakeTraffic(unsigned i, double distance,
+            FlarmTraffic::AlarmType alarm_level=FlarmTraffic::AlarmType::NONE)
+{
+  FlarmTraffic traffic;
+  traffic.Clear();
+  traffic.id = MakeId(i);
+  traffic.relative_north = distance;
+  traffic.relative_east = 0;
+  traffic.alarm_level = alarm_level;
+  return traffic;
+}
+
+static FlarmTraffic *
+Add(TrafficList &list, const FlarmTraffic &traffic, TimeStamp clock)
+{
+  FlarmTraffic *slot = list.AllocateTraffic(traffic);
+  if (slot != nullptr) {
+    slot->valid.Update(clock);
+    slot->Update(traffic);
+  }
+
+  return slot;
+}
+
+static bool
+FindAll(const TrafficList &list)
+{
+  for (const auto &traffic : list.list)
+    if (list.FindTraffic(traffic.id) != &traffic)
+      return false;
+
+  return true;
+}
+
+static void
+TestIndex()
+{
+  TrafficList list;
+  list.Clear();
+
+  const TimeStamp t0{std::chrono::seconds(100)};
+  const TimeStamp t1{std::chrono::seconds(101)};
+
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i)
+    Add(list, MakeTraffic(i, 1000 + i), i % 2 == 0 ? t0 : t1);
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(FindAll(list));
+  ok1(list.FindTraffic(MakeId(500)) == nullptr);
+
+  /* expire the even ones; quick_remove() moves the others around */
+  list.Expire(TimeStamp{std::chrono::seconds(102) +
+                        std::chrono::milliseconds(500)});
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+  ok1(FindAll(list));
+  ok1(list.FindTraffic(MakeId(0)) == nullptr);
+  ok1(list.FindTraffic(MakeId(1)) != nullptr);
+
+  /* copies of the list have a working index, too */
+  const TrafficList copy = list;
+  ok1(FindAll(copy));
+}
+
+static void
+TestEviction()
+{
+  TrafficList list;
+  list.Clear();
+
+  const TimeStamp clock{std::chrono::seconds(100)};
+
+  bool all_added = true;
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i)
+    if (Add(list, MakeTraffic(i, 1000 + i), clock) == nullptr)
+      all_added = false;
+
+  ok1(all_added);
+
+  /* a far target is rejected */
+  ok1(Add(list, MakeTraffic(1000, 5000), clock) == nullptr);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+
+  /* a close target replaces the farthest one */
+  ok1(Add(list, MakeTraffic(1001, 10), clock) != nullptr);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT - 1)) == nullptr);
+  ok1(list.FindTraffic(MakeId(1001)) != nullptr);
+
+  /* an alarm wins over distance */
+  ok1(Add(list, MakeTraffic(1002, 8000,
+                            FlarmTraffic::AlarmType::URGENT),
+          clock) != nullptr);
+  ok1(list.FindTraffic(MakeId(1002)) != nullptr);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT - 2)) == nullptr);
+  ok1(FindAll(list));
+}
+
+static bool
+IsSorted(const TrafficList &list)
+{
+  for (unsigned i = 1; i < list.list.size(); ++i)
+    if (list.list[i].IsMoreImportantThan(list.list[i - 1]))
+      return false;
+
+  return true;
+}
+
+static void
+TestStore()
+{
+  TrafficStore store;
+  TrafficList list;
+  list.Clear();
+
+  const TimeStamp t0{std::chrono::seconds(100)};
+  const TimeStamp t1{std::chrono::seconds(101)};
+
+  /* many more targets than the blackboard list can hold, the
+     farthest first */
+  constexpr unsigned n = 3 * TrafficList::MAX_COUNT;
+  bool all_new = true;
+  for (unsigned i = n; i-- > 0;)
+    if (!store.Update(MakeTraffic(i, 1000 + i), i % 2 == 0 ? t0 : t1))
+      all_new = false;
+
+  ok1(all_new);
+  ok1(store.size() == n);
+  ok1(!store.Update(MakeTraffic(0, 900), t0));
+  ok1(store.size() == n);
+
+  /* only the closest targets are published, the closest first */
+  store.Publish(list);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(IsSorted(list));
+  ok1(list.list.front().id == MakeId(0));
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT - 1)) != nullptr);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+  ok1(FindAll(list));
+
+  /* an alarm wins over distance */
+  store.Update(MakeTraffic(n - 1, 1000 + n - 1,
+                           FlarmTraffic::AlarmType::URGENT), t1);
+  store.Publish(list);
+  ok1(list.list.front().id == MakeId(n - 1));
+  ok1(IsSorted(list));
+
+  /* the even ones were not received after t0 */
+  store.Expire(TimeStamp{std::chrono::seconds(102) +
+                         std::chrono::milliseconds(500)});
+  ok1(store.size() == n / 2);
+  ok1(store.FindTraffic(MakeId(0)) == nullptr);
+  ok1(store.FindTraffic(MakeId(1)) != nullptr);
+
+  store.Publish(list);
+  ok1(list.list.front().id == MakeId(n - 1));
+  ok1(list.list[1].id == MakeId(1));
+
+  /* when the store is full, the least important target is replaced */
+  store.Clear();
+  for (unsigned i = 0; i < TrafficStore::MAX_COUNT; ++i)
+    store.Update(MakeTraffic(i, 1000 + i), t0);
+
+  ok1(store.size() == TrafficStore::MAX_COUNT);
+  ok1(!store.Update(MakeTraffic(1000, 5000), t0));
+  ok1(store.FindTraffic(MakeId(1000)) == nullptr);
+  ok1(store.Update(MakeTraffic(1001, 10), t0));
+  ok1(store.size() == TrafficStore::MAX_COUNT);
+  ok1(store.FindTraffic(MakeId(1001)) != nullptr);
+  ok1(store.FindTraffic(MakeId(TrafficStore::MAX_COUNT - 1)) == nullptr);
+  ok1(store.FindTraffic(MakeId(0)) != nullptr);
+}
+
+static GliderLinkTraffic *
+Add(GliderLinkTrafficList &list, unsigned id, const GeoPoint &location,
+    const GeoPoint &own_location, TimeStamp clock)
+{
+  GliderLinkTraffic *traffic =
+    list.AllocateTraffic(GliderLinkId(id), location, own_location);
+  if (traffic != nullptr) {
+    traffic->location = location;
+    traffic->valid.Update(clock);
+  }
+
+  return traffic;
+}
+
+static void
+TestGliderLinkEviction()
+{
+  GliderLinkTrafficList list;
+  list.Clear();
+
+  const TimeStamp clock{std::chrono::seconds(100)};
+  const GeoPoint own(Angle::Degrees(7), Angle::Degrees(51));
+
+  const auto At = [&own](double offset){
+    return GeoPoint(own.longitude,
+                    own.latitude + Angle::Degrees(offset));
+  };
+
+  bool all_added = true;
+  for (unsigned i = 0; i < GliderLinkTrafficList::MAX_COUNT; ++i)
+    if (Add(list, i, At(0.01 * (i + 1)), own, clock) == nullptr)
+      all_added = false;
+
+  ok1(all_added);
+
+  /* a far target is rejected */
+  ok1(Add(list, 1000, At(1), own, clock) == nullptr);
+
+  /* without our own location, nothing is replaced */
+  ok1(Add(list, 1001, At(0.001), GeoPoint::Invalid(), clock) == nullptr);
+
+  /* a close target replaces the farthest one */
+  ok1(Add(list, 1002, At(0.001), own, clock) != nullptr);
+  ok1(list.list.size() == GliderLinkTrafficList::MAX_COUNT);
+  ok1(list.FindTraffic(GliderLinkId(1002)) != nullptr);
+  ok1(list.FindTraffic(GliderLinkId(GliderLinkTrafficList::MAX_COUNT - 1))
+      == nullptr);
+  ok1(list.FindTraffic(GliderLinkId(0)) != nullptr);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(52);
+
+  TestIndex();
+  TestEviction();
+  TestStore();
+  TestGliderLinkEviction();
+
+  return exit_status();
+}
@@ -0,0 +1,84 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+static constexpr unsigned sample_rate = 44100;
+static constexpr size_t n_samples = sample_rate / 10;
+
+static bool
+IsSilent(const int16_t *buffer, size_t n)
+{
+  return std::all_of(buffer, buffer + n, [](int16_t i){ return i == 0; });
+}
+
+int
+main()
+{
+  plan_tests(9);
+
+  static int16_t buffer[n_samples];
+
+  VarioSynthesiser synthesiser(sample_rate);
+  synthesiser.SetVolume(100);
+
+  /* silence by default */
+  synthesiser.Synthesise(buffer, n_samples);
+  ok1(IsSilent(buffer, n_samples));
+  ok1(synthesiser.GetLatencyStats().count == 0);
+
+  /* sinking: continuous tone, picked up by the next Synthesise()
+     call */
+  const auto received = VarioSynthesiser::Clock::now();
+  synthesiser.SetVario(-2, received);
+  ok1(synthesiser.GetLatencyStats().count == 0);
+  synthesiser.Synthesise(buffer, n_samples);
+  ok1(!IsSilent(buffer, n_samples));
+
+  auto stats = synthesiser.GetLatencyStats();
+  ok1(stats.count == 1);
+  ok1(stats.max >= stats.average);
+
+  /* repeating the same value with a new time stamp is counted */
+  synthesiser.SetVario(-2);
+  synthesiser.Synthesise(buffer, n_samples);
+  ok1(synthesiser.GetLatencyStats().count == 2);
+
+  /* the dead band produces silence after the current wave has
+     finished */
+  synthesiser.SetDeadBand(true);
+  synthesiser.SetVario(0);
+  synthesiser.Synthesise(buffer, n_samples);
+  synthesiser.Synthesise(buffer, n_samples);
+  ok1(IsSilent(buffer, n_samples));
+
+  /* silence is not a latency sample */
+  synthesiser.SetSilence();
+  synthesiser.Synthesise(buffer, n_samples);
+  ok1(synthesiser.GetLatencyStats().count == 3);
+
+  return exit_status();
+}
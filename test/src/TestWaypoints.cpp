@@ -304,7 +304,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(54);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -323,7 +323,9 @@ main(int argc, char** argv)
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
+  TestRangeVisitor(waypoints, center, 1000000, 152);
   ok(TestErase(waypoints, 3), "waypoint erase", 0);
+  TestRangeVisitor(waypoints, center, 1000000, 151);
   ok(TestReplace(waypoints, 4), "waypoint replace", 0);
 
   // test clear
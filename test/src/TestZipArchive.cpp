@@ -0,0 +1,137 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "io/ZipArchive.hpp"
+#include "io/ZipReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <tchar.h>
+
+static const Path path(_T("test/data/benalla9.xcm"));
+
+/**
+ * Read a member the old way, with zzip.
+ */
+static std::vector<std::byte>
+ReadZzip(ZipArchive &archive, const char *name)
+{
+  ZipReader reader(archive.get(), name);
+
+  std::vector<std::byte> result;
+  std::byte buffer[4096];
+  std::size_t nbytes;
+  while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+    result.insert(result.end(), buffer, buffer + nbytes);
+
+  return result;
+}
+
+static bool
+Equals(const AllocatedArray<std::byte> &a, const std::vector<std::byte> &b)
+{
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+static void
+TestIndex()
+{
+  ZipArchive archive(path);
+
+  ok1(archive.Exists("terrain.jp2"));
+  ok1(archive.Exists("waypoints.xcw"));
+  ok1(!archive.Exists("terrain.j2w"));
+  ok1(!archive.Exists("terrain"));
+
+  ok1(archive.FindEntry("foo") == nullptr);
+
+  const auto *terrain = archive.FindEntry("terrain.jp2");
+  ok1(terrain != nullptr);
+  ok1(terrain->IsStored());
+  ok1(terrain->size == 283023);
+
+  /* stored members are accessed without copying */
+  const auto raw = archive.GetRawData(*terrain);
+  ok1(raw.size() == terrain->size);
+
+  const auto expected = ReadZzip(archive, "terrain.jp2");
+  ok1(expected.size() == raw.size() &&
+      std::equal(raw.begin(), raw.end(), expected.begin()));
+  ok1(Equals(archive.Inflate(*terrain), expected));
+
+  const auto *waypoints = archive.FindEntry("waypoints.xcw");
+  ok1(waypoints != nullptr);
+  ok1(waypoints->method == ZipArchive::Entry::DEFLATED);
+  ok1(Equals(archive.Inflate(*waypoints), ReadZzip(archive, "waypoints.xcw")));
+}
+
+static void
+TestParallelInflate()
+{
+  ZipArchive archive(path);
+
+  std::vector<std::string> names;
+  std::string name;
+  while (!(name = archive.NextName()).empty())
+    names.emplace_back(std::move(name));
+
+  ok1(names.size() == 28);
+
+  std::vector<AllocatedArray<std::byte>> results(names.size());
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 4; ++t)
+    threads.emplace_back([&, t](){
+      for (std::size_t i = t; i < names.size(); i += 4)
+        results[i] = archive.Inflate(*archive.FindEntry(names[i]));
+    });
+
+  for (auto &thread : threads)
+    thread.join();
+
+  bool all_equal = true;
+  for (std::size_t i = 0; i < names.size(); ++i)
+    if (!Equals(results[i], ReadZzip(archive, names[i].c_str())))
+      all_equal = false;
+
+  ok1(all_equal);
+}
+
+int
+main()
+try {
+  plan_tests(16);
+
+  TestIndex();
+  TestParallelInflate();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
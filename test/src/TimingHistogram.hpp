@@ -0,0 +1,132 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TIMING_HISTOGRAM_HPP
+#define XCSOAR_TIMING_HISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+
+#include <stdio.h>
+
+/**
+ * Collects the durations of one benchmark stage in logarithmic
+ * buckets (powers of two microseconds) and prints a summary.
+ */
+class TimingHistogram {
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  /**
+   * Bucket #i counts all samples shorter than 2^i microseconds (and
+   * not shorter than 2^(i-1)); the last one collects everything
+   * else.
+   */
+  static constexpr unsigned N_BUCKETS = 24;
+
+  std::array<unsigned, N_BUCKETS> buckets{};
+
+  Duration total{}, max{};
+  unsigned count = 0;
+
+public:
+  /**
+   * Measures the duration of its own lifetime and adds it to the
+   * #TimingHistogram.
+   */
+  class Scope {
+    TimingHistogram &histogram;
+    const Clock::time_point start = Clock::now();
+
+  public:
+    explicit Scope(TimingHistogram &_histogram) noexcept
+      :histogram(_histogram) {}
+
+    ~Scope() noexcept {
+      histogram.Add(Clock::now() - start);
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  unsigned GetCount() const noexcept {
+    return count;
+  }
+
+  Duration GetTotal() const noexcept {
+    return total;
+  }
+
+  void Add(Duration d) noexcept {
+    ++count;
+    total += d;
+    if (d > max)
+      max = d;
+
+    const auto us =
+      std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    unsigned i = 0;
+    while (i < N_BUCKETS - 1 && (1LL << i) <= us)
+      ++i;
+
+    ++buckets[i];
+  }
+
+  void Print(const char *name) const noexcept {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    if (count == 0) {
+      printf("%s: no samples\n", name);
+      return;
+    }
+
+    const auto total_us = duration_cast<microseconds>(total).count();
+    printf("%s: %u samples, total %lld us, mean %lld us, max %lld us\n",
+           name, count, (long long)total_us,
+           (long long)(total_us / count),
+           (long long)duration_cast<microseconds>(max).count());
+
+    unsigned peak = 0;
+    for (const unsigned n : buckets)
+      if (n > peak)
+        peak = n;
+
+    for (unsigned i = 0; i < N_BUCKETS; ++i) {
+      if (buckets[i] == 0)
+        continue;
+
+      const unsigned width = (buckets[i] * 40 + peak - 1) / peak;
+      if (i == N_BUCKETS - 1)
+        printf("  >=%8lld us %8u ", 1LL << (i - 1), buckets[i]);
+      else
+        printf("  < %8lld us %8u ", 1LL << i, buckets[i]);
+      for (unsigned j = 0; j < width; ++j)
+        putchar('#');
+      putchar('\n');
+    }
+  }
+};
+
+#endif
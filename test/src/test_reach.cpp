@@ -28,6 +28,7 @@
 #include "Engine/Route/ReachResult.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Terrain/Loader.hpp"
+#include "io/ZipArchive.hpp"
 #include "system/ConvertPathName.hpp"
 #include "Compatibility/path.h"
 #include "GlideSolvers/GlideSettings.hpp"
@@ -37,8 +38,6 @@
 #include "system/FileUtil.hpp"
 #include "util/PrintException.hxx"
 
-#include <zzip/zzip.h>
-
 #include <string.h>
 
 static void
@@ -112,28 +111,23 @@ try {
     map_path = argv[1];
   }
 
-  ZZIP_DIR *dir = zzip_dir_open(map_path, nullptr);
-  if (dir == nullptr) {
-    fprintf(stderr, "Failed to open %s\n", map_path);
-    return EXIT_FAILURE;
-  }
+  ZipArchive archive{PathName(map_path)};
 
   RasterMap map;
 
   {
     NullOperationEnvironment operation;
-    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
   }
 
   map.UpdateProjection();
 
   SharedMutex mutex;
   do {
-    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
                        map.GetProjection(),
                        map.GetMapCenter(), 50000);
   } while (map.IsDirty());
-  zzip_dir_close(dir);
 
   plan_tests(8);
   test_reach(map, 0, 0.1, 0);
@@ -31,6 +31,7 @@
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Terrain/Loader.hpp"
+#include "io/ZipArchive.hpp"
 #include "system/ConvertPathName.hpp"
 #include "system/FileUtil.hpp"
 #include "Compatibility/path.h"
@@ -38,8 +39,6 @@
 #include "util/PrintException.hxx"
 #include "test_debug.hpp"
 
-#include <zzip/zzip.h>
-
 #include <fstream>
 
 #include <string.h>
@@ -187,28 +186,23 @@ main(int argc, char** argv)
 try {
   static const char map_path[] = "tmp/map.xcm";
 
-  ZZIP_DIR *dir = zzip_dir_open(map_path, nullptr);
-  if (dir == nullptr) {
-    fprintf(stderr, "Failed to open %s\n", map_path);
-    return EXIT_FAILURE;
-  }
+  ZipArchive archive{PathName(map_path)};
 
   RasterMap map;
 
   {
     NullOperationEnvironment operation;
-    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
   }
 
   map.UpdateProjection();
 
   SharedMutex mutex;
   do {
-    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
                        map.GetProjection(),
                        map.GetMapCenter(), 100000);
   } while (map.IsDirty());
-  zzip_dir_close(dir);
 
   plan_tests(4 + NUM_SOL);
   ok(test_route(28, map), "route 28", 0);
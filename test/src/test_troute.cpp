@@ -27,6 +27,7 @@
 #include "Route/TerrainRoute.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Terrain/Loader.hpp"
+#include "io/ZipArchive.hpp"
 #include "system/ConvertPathName.hpp"
 #include "Compatibility/path.h"
 #include "GlideSolvers/GlideSettings.hpp"
@@ -37,8 +38,6 @@
 #include "system/FileUtil.hpp"
 #include "util/PrintException.hxx"
 
-#include <zzip/zzip.h>
-
 #include <string.h>
 
 static void
@@ -118,28 +117,23 @@ try {
     map_path = argv[0];
   }
 
-  ZZIP_DIR *dir = zzip_dir_open(map_path, nullptr);
-  if (dir == nullptr) {
-    fprintf(stderr, "Failed to open %s\n", map_path);
-    return EXIT_FAILURE;
-  }
+  ZipArchive archive{PathName(map_path)};
 
   RasterMap map;
 
   {
     NullOperationEnvironment operation;
-    LoadTerrainOverview(dir, map.GetTileCache(), operation);
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
   }
 
   map.UpdateProjection();
 
   SharedMutex mutex;
   do {
-    UpdateTerrainTiles(dir, map.GetTileCache(), mutex,
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
                        map.GetProjection(),
                        map.GetMapCenter(), 100000);
   } while (map.IsDirty());
-  zzip_dir_close(dir);
 
   plan_tests(16*3);
   test_troute(map, 0, 0.1, 10000);